@@ -0,0 +1,84 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <core/type.h>
+#include <core/macros.h>
+
+/// for stderr, fprintf
+#include <stdio.h>
+/// for clock_gettime
+#include <time.h>
+
+/*
+ * ==========================================================================
+ * Micro-Benchmark Harness
+ * ==========================================================================
+ * A tiny companion to `std/test.h`. Benchmarks are built with -O2 -DNDEBUG
+ * against the library sources (`make bench`).
+ *
+ * @example
+ * BENCH(push_u64, 1000000)
+ * {
+ *     for (usize i = 0; i < iters; ++i) ...
+ * }
+ *
+ * int main()
+ * {
+ *     RUN_BENCH(push_u64);
+ * }
+ */
+
+/**
+ * @brief Monotonic time in nanoseconds.
+ */
+static inline u64 bench_now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+/**
+ * @brief Keep the optimizer from deleting a computation.
+ */
+#define bench_use(x) __asm__ volatile("" : : "g"(x) : "memory")
+
+/**
+ * @brief Define a benchmark. The body receives `usize iters`.
+ */
+#define BENCH(name, n)                                   \
+	static const usize bench_iters_##name = (n);     \
+	static void bench_##name(usize iters)
+
+/**
+ * @brief Run a benchmark and print ns per iteration.
+ */
+#define RUN_BENCH(name)                                                    \
+	do {                                                               \
+		usize _iters = bench_iters_##name;                         \
+		u64 _start = bench_now_ns();                               \
+		bench_##name(_iters);                                      \
+		u64 _elapsed = bench_now_ns() - _start;                    \
+		fprintf(stderr, "bench %-40s %10.2f ns/op  (%zu ops)\n", \
+			#name, (double)_elapsed / (double)_iters, _iters); \
+	} while (0)
+
+/**
+ * @brief Print a section header to group related results.
+ */
+#define BENCH_GROUP(title) fprintf(stderr, "\n--- %s ---\n", title)
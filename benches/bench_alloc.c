@@ -0,0 +1,194 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "bench.h"
+#include <std/allocers/system.h>
+#include <std/allocers/bump.h>
+#include <std/allocers/pool.h>
+#include <std/allocers/tlsf.h>
+#include <std/vec.h>
+
+/*
+ * ==========================================================================
+ * Allocator Benchmarks: system vs bump vs pool vs tlsf
+ * ==========================================================================
+ * Workload: same-sized "IR nodes" that are created and destroyed in waves.
+ */
+
+typedef struct {
+	u32 op;
+	u32 flags;
+	void *lhs;
+	void *rhs;
+	u64 id;
+} IrNode;
+
+#define WAVE 4096
+static IrNode *g_nodes[WAVE];
+
+static void churn(allocer_t alc, usize iters)
+{
+	layout_t l = layout_of(IrNode);
+	for (usize done = 0; done < iters; done += WAVE) {
+		for (usize i = 0; i < WAVE; ++i) {
+			g_nodes[i] = (IrNode *)allocer_alloc(alc, l);
+			g_nodes[i]->id = i;
+			bench_use(g_nodes[i]);
+		}
+		for (usize i = 0; i < WAVE; ++i)
+			allocer_free(alc, g_nodes[i], l);
+	}
+}
+
+BENCH(churn_system, 4 * 1000 * 1000)
+{
+	churn(allocer_system(), iters);
+}
+
+BENCH(churn_pool, 4 * 1000 * 1000)
+{
+	pool_t pool;
+	pool_init(&pool, allocer_system());
+	churn(pool_allocer(&pool), iters);
+	pool_deinit(&pool);
+}
+
+BENCH(churn_tlsf, 4 * 1000 * 1000)
+{
+	tlsf_t tlsf;
+	tlsf_init(&tlsf, allocer_system(), 0);
+	churn(tlsf_allocer(&tlsf), iters);
+	tlsf_deinit(&tlsf);
+}
+
+BENCH(churn_bump_reset_per_wave, 4 * 1000 * 1000)
+{
+	/// bump cannot free single objects: reset after each wave instead
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	allocer_t alc = bump_allocer(&bump);
+	layout_t l = layout_of(IrNode);
+	for (usize done = 0; done < iters; done += WAVE) {
+		for (usize i = 0; i < WAVE; ++i) {
+			g_nodes[i] = (IrNode *)allocer_alloc(alc, l);
+			g_nodes[i]->id = i;
+			bench_use(g_nodes[i]);
+		}
+		bump_reset(&bump);
+	}
+	bump_deinit(&bump);
+}
+
+BENCH(interleaved_system, 4 * 1000 * 1000)
+{
+	/// free one, allocate one: steady-state reuse
+	allocer_t alc = allocer_system();
+	layout_t l = layout_of(IrNode);
+	for (usize i = 0; i < WAVE; ++i)
+		g_nodes[i] = (IrNode *)allocer_alloc(alc, l);
+	for (usize i = 0; i < iters; ++i) {
+		usize k = (i * 2654435761u) % WAVE;
+		allocer_free(alc, g_nodes[k], l);
+		g_nodes[k] = (IrNode *)allocer_alloc(alc, l);
+		bench_use(g_nodes[k]);
+	}
+	for (usize i = 0; i < WAVE; ++i)
+		allocer_free(alc, g_nodes[i], l);
+}
+
+BENCH(interleaved_pool, 4 * 1000 * 1000)
+{
+	pool_t pool;
+	pool_init(&pool, allocer_system());
+	allocer_t alc = pool_allocer(&pool);
+	layout_t l = layout_of(IrNode);
+	for (usize i = 0; i < WAVE; ++i)
+		g_nodes[i] = (IrNode *)allocer_alloc(alc, l);
+	for (usize i = 0; i < iters; ++i) {
+		usize k = (i * 2654435761u) % WAVE;
+		allocer_free(alc, g_nodes[k], l);
+		g_nodes[k] = (IrNode *)allocer_alloc(alc, l);
+		bench_use(g_nodes[k]);
+	}
+	pool_deinit(&pool);
+}
+
+BENCH(interleaved_tlsf, 4 * 1000 * 1000)
+{
+	tlsf_t tlsf;
+	tlsf_init(&tlsf, allocer_system(), 0);
+	allocer_t alc = tlsf_allocer(&tlsf);
+	layout_t l = layout_of(IrNode);
+	for (usize i = 0; i < WAVE; ++i)
+		g_nodes[i] = (IrNode *)allocer_alloc(alc, l);
+	for (usize i = 0; i < iters; ++i) {
+		usize k = (i * 2654435761u) % WAVE;
+		allocer_free(alc, g_nodes[k], l);
+		g_nodes[k] = (IrNode *)allocer_alloc(alc, l);
+		bench_use(g_nodes[k]);
+	}
+	tlsf_deinit(&tlsf);
+}
+
+/// grow many vectors side by side: realloc cannot always stay in place
+static void grow_vecs(allocer_t alc, usize iters)
+{
+	enum { LANES = 64 };
+	vec(u32) lanes[LANES];
+	for (usize i = 0; i < LANES; ++i) {
+		if (!vec_init(lanes[i], alc, 0))
+			return;
+	}
+	for (usize i = 0; i < iters; ++i)
+		vec_push(lanes[(i * 2654435761u) % LANES], (u32)i);
+	for (usize i = 0; i < LANES; ++i) {
+		bench_use(vec_data(lanes[i]));
+		vec_deinit(lanes[i]);
+	}
+}
+
+BENCH(vec_growth_system, 4 * 1000 * 1000)
+{
+	grow_vecs(allocer_system(), iters);
+}
+
+BENCH(vec_growth_tlsf, 4 * 1000 * 1000)
+{
+	tlsf_t tlsf;
+	tlsf_init(&tlsf, allocer_system(), 0);
+	grow_vecs(tlsf_allocer(&tlsf), iters);
+	tlsf_deinit(&tlsf);
+}
+
+int main()
+{
+	BENCH_GROUP("alloc/free waves of 4096 nodes");
+	RUN_BENCH(churn_system);
+	RUN_BENCH(churn_pool);
+	RUN_BENCH(churn_tlsf);
+	RUN_BENCH(churn_bump_reset_per_wave);
+
+	BENCH_GROUP("interleaved free + alloc");
+	RUN_BENCH(interleaved_system);
+	RUN_BENCH(interleaved_pool);
+	RUN_BENCH(interleaved_tlsf);
+
+	BENCH_GROUP("64 vectors growing side by side");
+	RUN_BENCH(vec_growth_system);
+	RUN_BENCH(vec_growth_tlsf);
+
+	return 0;
+}
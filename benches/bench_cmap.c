@@ -0,0 +1,123 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "bench.h"
+#include <std/allocers/system.h>
+#include <std/cmap.h>
+#include <pthread.h>
+#include <unistd.h> /// for sysconf
+
+/*
+ * ==========================================================================
+ * Concurrent Map Benchmarks: one global lock vs lock striping
+ * ==========================================================================
+ * Every thread runs the same number of operations on one shared table of
+ * 2^16 u64 keys: 95% lookups and 5% puts (a read-mostly symbol table), or
+ * 50/50. The figure is aggregate throughput, so perfect scaling doubles it
+ * with the thread count, up to the number of cores.
+ *
+ * "1 shard" is a single reader-writer lock around a plain map: the baseline
+ * every thread serializes on whenever one of them writes.
+ */
+
+#define KEYS (1u << 16)
+#define OPS_PER_THREAD (1u << 20)
+#define MAX_THREADS 32
+
+defCmap(u64, u64, U64Cmap);
+
+static U64Cmap g_map;
+
+typedef struct {
+	u64 seed;
+	u32 put_pct;
+} Worker;
+
+static u64 splitmix(u64 *state)
+{
+	u64 z = (*state += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+static void *worker_main(void *arg)
+{
+	Worker *w = (Worker *)arg;
+	u64 sum = 0;
+	for (usize i = 0; i < OPS_PER_THREAD; ++i) {
+		u64 r = splitmix(&w->seed);
+		u64 key = r % KEYS;
+		if ((r >> 32) % 100 < w->put_pct) {
+			(void)cmap_put(g_map, key, r);
+		} else {
+			u64 v = 0;
+			(void)cmap_get(g_map, key, &v);
+			sum += v;
+		}
+	}
+	bench_use(sum);
+	return nullptr;
+}
+
+static void run_scaling(usize shards, u32 put_pct)
+{
+	if (!cmap_init_shards(g_map, allocer_system(), MAP_OPS_U64, shards))
+		return;
+	for (u64 i = 0; i < KEYS; ++i)
+		(void)cmap_put(g_map, i, i);
+
+	for (usize threads = 1; threads <= MAX_THREADS; threads *= 2) {
+		static Worker workers[MAX_THREADS];
+		pthread_t ids[MAX_THREADS];
+
+		u64 start = bench_now_ns();
+		for (usize t = 0; t < threads; ++t) {
+			workers[t] = (Worker){ .seed = t + 1,
+					       .put_pct = put_pct };
+			if (pthread_create(&ids[t], nullptr, worker_main,
+					   &workers[t]) != 0)
+				return;
+		}
+		for (usize t = 0; t < threads; ++t)
+			pthread_join(ids[t], nullptr);
+		u64 elapsed = bench_now_ns() - start;
+
+		double ops = (double)threads * OPS_PER_THREAD;
+		fprintf(stderr,
+			"bench cmap %2zu shard%s %2u%% put %2zu threads "
+			"%8.2f Mops/s\n",
+			shards, shards == 1 ? " " : "s", put_pct, threads,
+			ops * 1e3 / (double)elapsed);
+	}
+
+	cmap_deinit(g_map);
+}
+
+int main()
+{
+	fprintf(stderr, "(%ld cores online)\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+	BENCH_GROUP("read-mostly: 95% get, 5% put");
+	run_scaling(1, 5);
+	run_scaling(CMAP_DEFAULT_SHARDS, 5);
+
+	BENCH_GROUP("write-heavy: 50% get, 50% put");
+	run_scaling(1, 50);
+	run_scaling(CMAP_DEFAULT_SHARDS, 50);
+
+	return 0;
+}
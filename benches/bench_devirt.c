@@ -0,0 +1,224 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "bench.h"
+#include <std/allocers/system.h>
+#include <std/allocers/bump.h>
+#include <std/allocers/devirt.h>
+#include <std/strings/string.h>
+#include <std/vec.h>
+#include <std/map.h>
+
+/*
+ * ==========================================================================
+ * Devirtualization Benchmarks: bump through the vtable vs inlined
+ * ==========================================================================
+ * The "vtable" arena forwards to the same bump functions through its own
+ * vtable, so `allocer_is_bump` fails and every call is indirect: exactly the
+ * cost the `allocer_*_fast` wrappers remove.
+ */
+
+static anyptr fwd_alloc(anyptr self, layout_t layout)
+{
+	return bump_alloc_layout((bump_t *)self, layout);
+}
+
+static void fwd_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	unused(self);
+	unused(ptr);
+	unused(layout);
+}
+
+static anyptr fwd_realloc(anyptr self, anyptr ptr, layout_t old,
+			  layout_t new_l)
+{
+	return bump_realloc((bump_t *)self, ptr, old.size, new_l.size,
+			    new_l.align);
+}
+
+static const allocer_vtable_t FWD_VTABLE = {
+	.alloc = fwd_alloc,
+	.free = fwd_free,
+	.realloc = fwd_realloc,
+};
+
+static allocer_t virtual_bump(bump_t *bump)
+{
+	return (allocer_t){ .self = bump, .vtable = &FWD_VTABLE };
+}
+
+typedef struct {
+	u32 op;
+	u32 flags;
+	void *lhs;
+	void *rhs;
+} IrNode;
+
+#define BATCH 4096
+
+/* --- raw node allocation --- */
+
+BENCH(nodes_vtable, 16 * 1000 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	allocer_t alc = virtual_bump(&bump);
+	for (usize i = 0; i < iters; ++i) {
+		IrNode *n = (IrNode *)allocer_alloc(alc, layout_of(IrNode));
+		n->op = (u32)i;
+		bench_use(n);
+		if (i % (BATCH * 16) == 0)
+			bump_reset(&bump);
+	}
+	bump_deinit(&bump);
+}
+
+BENCH(nodes_devirt, 16 * 1000 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	allocer_t alc = bump_allocer(&bump);
+	for (usize i = 0; i < iters; ++i) {
+		IrNode *n = (IrNode *)allocer_alloc_fast(alc, layout_of(IrNode));
+		n->op = (u32)i;
+		bench_use(n);
+		if (i % (BATCH * 16) == 0)
+			bump_reset(&bump);
+	}
+	bump_deinit(&bump);
+}
+
+/* --- many short vectors (per-node operand lists) --- */
+
+static void short_vecs(bump_t *bump, allocer_t alc, usize iters)
+{
+	for (usize done = 0; done < iters; done += BATCH) {
+		for (usize i = 0; i < BATCH; ++i) {
+			vec(u32) v;
+			if (!vec_init(v, alc, 0))
+				return;
+			for (u32 k = 0; k < 20; ++k) /// grows 8 -> 16 -> 32
+				(void)vec_push(v, k);
+			bench_use(vec_data(v));
+		}
+		bump_reset(bump);
+	}
+}
+
+BENCH(short_vecs_vtable, 2 * 1000 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	short_vecs(&bump, virtual_bump(&bump), iters);
+	bump_deinit(&bump);
+}
+
+BENCH(short_vecs_devirt, 2 * 1000 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	short_vecs(&bump, bump_allocer(&bump), iters);
+	bump_deinit(&bump);
+}
+
+/* --- small strings --- */
+
+static void short_strings(bump_t *bump, allocer_t alc, usize iters)
+{
+	for (usize done = 0; done < iters; done += BATCH) {
+		for (usize i = 0; i < BATCH; ++i) {
+			string_t s;
+			if (!string_init(&s, alc, 0))
+				return;
+			(void)string_append_cstr(&s, "tmp.");
+			(void)string_append_cstr(&s, "value_");
+			(void)string_push(&s, (char)('a' + i % 26));
+			bench_use(s.data);
+		}
+		bump_reset(bump);
+	}
+}
+
+BENCH(short_strings_vtable, 2 * 1000 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	short_strings(&bump, virtual_bump(&bump), iters);
+	bump_deinit(&bump);
+}
+
+BENCH(short_strings_devirt, 2 * 1000 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	short_strings(&bump, bump_allocer(&bump), iters);
+	bump_deinit(&bump);
+}
+
+/* --- small maps (per-scope symbol tables) --- */
+
+static void small_maps(bump_t *bump, allocer_t alc, usize iters)
+{
+	for (usize done = 0; done < iters; done += BATCH / 8) {
+		for (usize i = 0; i < BATCH / 8; ++i) {
+			map(u64, u64) m;
+			if (!map_init(m, alc, MAP_OPS_U64))
+				return;
+			for (u64 k = 0; k < 12; ++k)
+				(void)map_put(m, k, k);
+			bench_use(m.keys);
+		}
+		bump_reset(bump);
+	}
+}
+
+BENCH(small_maps_vtable, 500 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	small_maps(&bump, virtual_bump(&bump), iters);
+	bump_deinit(&bump);
+}
+
+BENCH(small_maps_devirt, 500 * 1000)
+{
+	bump_t bump;
+	bump_init(&bump, allocer_system(), 8);
+	small_maps(&bump, bump_allocer(&bump), iters);
+	bump_deinit(&bump);
+}
+
+int main()
+{
+	BENCH_GROUP("24-byte nodes from a bump arena");
+	RUN_BENCH(nodes_vtable);
+	RUN_BENCH(nodes_devirt);
+
+	BENCH_GROUP("vec(u32) x 20 pushes (per vector)");
+	RUN_BENCH(short_vecs_vtable);
+	RUN_BENCH(short_vecs_devirt);
+
+	BENCH_GROUP("string_t x 3 appends (per string)");
+	RUN_BENCH(short_strings_vtable);
+	RUN_BENCH(short_strings_devirt);
+
+	BENCH_GROUP("map(u64, u64) x 12 puts (per map)");
+	RUN_BENCH(small_maps_vtable);
+	RUN_BENCH(small_maps_devirt);
+
+	return 0;
+}
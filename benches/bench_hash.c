@@ -0,0 +1,282 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "bench.h"
+#include <core/hash.h>
+#include <std/allocers/system.h>
+#include <std/map.h>
+#include <std/strings/string.h>
+#include <std/fs.h>
+#include <stdio.h> /// for snprintf
+
+/*
+ * ==========================================================================
+ * Hash Benchmarks: word-at-a-time vs byte-loop FNV-1a
+ * ==========================================================================
+ * Throughput over one buffer at sizes from an identifier to a source file,
+ * the integer mixers on their own, and `map` with u64 and C-string keys
+ * (the two places the hash sits on the hot path).
+ *
+ * The streaming group hashes a (dir, name, mtime) key: once through
+ * `hasher_t`, once by concatenating into a temporary `string_t` first.
+ *
+ * The fingerprint group compares `file_fingerprint` on a 64 MiB file with
+ * reading it into a `string_t` and hashing that (the page cache is warm
+ * for both).
+ */
+
+#define BUF_SIZE (1u << 16)
+#define BYTES_PER_RUN (1u << 26)
+
+static u8 g_buf[BUF_SIZE];
+
+static void run_throughput(const char *name, usize len,
+			   u64 (*fn)(const void *, usize))
+{
+	usize iters = BYTES_PER_RUN / len;
+	u64 sum = 0;
+	u64 start = bench_now_ns();
+	for (usize i = 0; i < iters; ++i) {
+		/// slide the window so every call sees different bytes
+		sum += fn(g_buf + (i & 63), len);
+	}
+	u64 elapsed = bench_now_ns() - start;
+	bench_use(sum);
+
+	fprintf(stderr, "bench %-8s %6zu B %10.2f ns/op %8.2f GB/s\n", name,
+		len, (double)elapsed / (double)iters,
+		(double)len * (double)iters / (double)elapsed);
+}
+
+/* --- integer mixers --- */
+
+BENCH(mix_fnv1a_u64, 50000000)
+{
+	u64 sum = 0;
+	for (u64 i = 0; i < iters; ++i)
+		sum += hash_fnv1a(&i, sizeof(i));
+	bench_use(sum);
+}
+
+BENCH(mix_hash_u64, 50000000)
+{
+	u64 sum = 0;
+	for (u64 i = 0; i < iters; ++i)
+		sum += hash_u64(i);
+	bench_use(sum);
+}
+
+BENCH(mix_hash_u32, 50000000)
+{
+	u64 sum = 0;
+	for (u32 i = 0; i < iters; ++i)
+		sum += hash_u32(i);
+	bench_use(sum);
+}
+
+/* --- map end to end --- */
+
+#define MAP_KEYS (1u << 16)
+
+BENCH(map_u64_put_get, MAP_KEYS)
+{
+	map(u64, u64) m;
+	if (!map_init(m, allocer_system(), MAP_OPS_U64))
+		return;
+	for (u64 i = 0; i < iters; ++i)
+		(void)map_put(m, i * 0x9e3779b97f4a7c15ull, i);
+	u64 sum = 0;
+	for (usize r = 0; r < 16; ++r)
+		for (u64 i = 0; i < iters; ++i)
+			sum += *map_get(m, i * 0x9e3779b97f4a7c15ull);
+	bench_use(sum);
+	map_deinit(m);
+}
+
+static char g_names[MAP_KEYS][32];
+
+BENCH(map_cstr_put_get, MAP_KEYS)
+{
+	map(const char *, u32) m;
+	if (!map_init(m, allocer_system(), MAP_OPS_CSTR))
+		return;
+	for (u32 i = 0; i < iters; ++i)
+		(void)map_put(m, (const char *)g_names[i], i);
+	u64 sum = 0;
+	for (usize r = 0; r < 16; ++r)
+		for (u32 i = 0; i < iters; ++i)
+			sum += *map_get(m, (const char *)g_names[i]);
+	bench_use(sum);
+	map_deinit(m);
+}
+
+/* --- streaming --- */
+
+BENCH(stream_4k_in_64b_pieces, 200000)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < iters; ++i) {
+		hasher_t h;
+		hasher_init(&h);
+		for (usize off = 0; off < 4096; off += 64)
+			hasher_update(&h, g_buf + (i & 63) + off, 64);
+		sum += hasher_finish(&h);
+	}
+	bench_use(sum);
+}
+
+BENCH(one_shot_4k, 200000)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < iters; ++i)
+		sum += hash_bytes(g_buf + (i & 63), 4096);
+	bench_use(sum);
+}
+
+static const str_t g_dir = { .ptr = "src/std/strings/", .len = 16 };
+
+BENCH(composite_hasher, 5000000)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < iters; ++i) {
+		const char *name = g_names[i & (MAP_KEYS - 1)];
+		hasher_t h;
+		hasher_init(&h);
+		hasher_update(&h, g_dir.ptr, g_dir.len);
+		hasher_update(&h, name, strlen(name));
+		hasher_write_u64(&h, i);
+		sum += hasher_finish(&h);
+	}
+	bench_use(sum);
+}
+
+BENCH(composite_temp_string, 5000000)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < iters; ++i) {
+		const char *name = g_names[i & (MAP_KEYS - 1)];
+		string_t s;
+		if (!string_init(&s, allocer_system(), 0))
+			return;
+		u64 mtime = i;
+		str_t raw = { .ptr = (const char *)&mtime, .len = 8 };
+		bool ok = string_append(&s, g_dir) &&
+			  string_append_cstr(&s, name) &&
+			  string_append(&s, raw);
+		if (ok)
+			sum += hash_bytes(s.data, s.len);
+		string_deinit(&s);
+	}
+	bench_use(sum);
+}
+
+/* --- fingerprints --- */
+
+static u64 hash128_lo(const void *data, usize len)
+{
+	return hash128_bytes(data, len).lo;
+}
+
+#define FP_FILE "bench_hash_fingerprint.bin"
+#define FP_SIZE (64u << 20)
+
+BENCH(file_fingerprint_64m, 20)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < iters; ++i) {
+		hash128_t fp = { 0 };
+		if (!file_fingerprint(FP_FILE, &fp))
+			return;
+		sum += fp.lo ^ fp.hi;
+	}
+	bench_use(sum);
+}
+
+BENCH(file_read_then_hash_64m, 20)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < iters; ++i) {
+		string_t s;
+		if (!string_init(&s, allocer_system(), 0))
+			return;
+		if (file_read_to_string(FP_FILE, &s)) {
+			hash128_t fp = hash128_bytes(s.data, s.len);
+			sum += fp.lo ^ fp.hi;
+		}
+		string_deinit(&s);
+	}
+	bench_use(sum);
+}
+
+static bool write_fingerprint_file(void)
+{
+	static char block[1u << 20];
+	for (usize i = 0; i < sizeof(block); ++i)
+		block[i] = (char)(i * 131 + (i >> 11));
+	str_t chunk = { .ptr = block, .len = sizeof(block) };
+	if (!file_write(FP_FILE, (str_t){ .ptr = block, .len = 0 }))
+		return false;
+	for (usize i = 0; i < FP_SIZE / sizeof(block); ++i)
+		if (!file_append(FP_FILE, chunk))
+			return false;
+	return true;
+}
+
+int main()
+{
+	for (usize i = 0; i < BUF_SIZE; ++i)
+		g_buf[i] = (u8)(i * 131 + (i >> 7));
+	for (u32 i = 0; i < MAP_KEYS; ++i)
+		snprintf(g_names[i], sizeof(g_names[i]), "symbol_name_%u", i);
+
+	static const usize sizes[] = { 8, 16, 32, 64, 256, 4096, 60000 };
+
+	BENCH_GROUP("throughput: FNV-1a");
+	for (usize i = 0; i < array_size(sizes); ++i)
+		run_throughput("fnv1a", sizes[i], hash_fnv1a);
+
+	BENCH_GROUP("throughput: hash_bytes");
+	for (usize i = 0; i < array_size(sizes); ++i)
+		run_throughput("hash", sizes[i], hash_bytes);
+
+	BENCH_GROUP("throughput: hash128_bytes");
+	for (usize i = 3; i < array_size(sizes); ++i)
+		run_throughput("hash128", sizes[i], hash128_lo);
+
+	BENCH_GROUP("integer mixers");
+	RUN_BENCH(mix_fnv1a_u64);
+	RUN_BENCH(mix_hash_u64);
+	RUN_BENCH(mix_hash_u32);
+
+	BENCH_GROUP("streaming");
+	RUN_BENCH(one_shot_4k);
+	RUN_BENCH(stream_4k_in_64b_pieces);
+	RUN_BENCH(composite_hasher);
+	RUN_BENCH(composite_temp_string);
+
+	BENCH_GROUP("fingerprint a 64 MiB file");
+	if (write_fingerprint_file()) {
+		RUN_BENCH(file_fingerprint_64m);
+		RUN_BENCH(file_read_then_hash_64m);
+	}
+	(void)file_remove(FP_FILE);
+
+	BENCH_GROUP("map: 1 put + 16 gets per key");
+	RUN_BENCH(map_u64_put_get);
+	RUN_BENCH(map_cstr_put_get);
+
+	return 0;
+}
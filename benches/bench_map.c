@@ -0,0 +1,635 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "bench.h"
+#include <std/allocers/system.h>
+#include <std/map.h>
+#include <std/rhmap.h>
+#include <std/indexmap.h>
+#include <std/set.h>
+#include <std/map/phf.h>
+#include <core/hash.h>
+#include <std/map/inline.h>
+#include <stdlib.h>
+
+/*
+ * ==========================================================================
+ * Map Benchmarks: group probing vs the previous linear prober
+ * ==========================================================================
+ * Both tables have 2^16 slots, hold the same random u64 keys and go through
+ * the same `MAP_OPS_U64` function pointers, so the difference is the probe
+ * loop alone. The legacy table is the old one-byte-per-step linear prober
+ * (0=Empty, 1=Full, 2=Tomb), kept here at a fixed capacity. The "inline"
+ * table is the same group prober generated by `defMapInline`, with the hash
+ * and compare inlined instead of called through `map_ops_t`.
+ *
+ * `map` grows past 7/8 load, so 87% is the densest point both can share.
+ */
+
+#define CAP (1u << 16)
+#define LOOKUPS (4 * 1000 * 1000)
+
+static u64 splitmix(u64 *state)
+{
+	u64 z = (*state += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+/* --- legacy linear prober --- */
+
+typedef struct {
+	u64 keys[CAP];
+	u64 vals[CAP];
+	u8 states[CAP];
+	map_ops_t ops;
+} linear_map_t;
+
+static bool linear_find(linear_map_t *m, const void *key, usize *out_idx)
+{
+	usize idx = (usize)(m->ops.hash(key) & (CAP - 1));
+	usize first_tomb = (usize)-1;
+
+	for (;;) {
+		u8 state = m->states[idx];
+		if (state == 0) {
+			*out_idx = first_tomb != (usize)-1 ? first_tomb : idx;
+			return false;
+		}
+		if (state == 2) {
+			if (first_tomb == (usize)-1)
+				first_tomb = idx;
+		} else if (m->ops.equals(key, &m->keys[idx])) {
+			*out_idx = idx;
+			return true;
+		}
+		idx = (idx + 1) & (CAP - 1);
+	}
+}
+
+static void linear_put(linear_map_t *m, u64 key, u64 val)
+{
+	usize idx;
+	if (!linear_find(m, &key, &idx)) {
+		m->keys[idx] = key;
+		m->states[idx] = 1;
+	}
+	m->vals[idx] = val;
+}
+
+static u64 *linear_get(linear_map_t *m, u64 key)
+{
+	usize idx;
+	return linear_find(m, &key, &idx) ? &m->vals[idx] : nullptr;
+}
+
+/* --- fixtures --- */
+
+defMap(u64, u64, U64Map);
+defMapInline(u64, u64, U64Table, map_hash_u64, map_eq_scalar);
+
+static linear_map_t legacy;
+static U64Table inline_table;
+static u64 present[CAP];
+static u64 absent[CAP];
+
+/// fill both tables to `pct` percent of CAP
+static usize fill(U64Map *m, usize pct)
+{
+	usize n = CAP * pct / 100;
+	u64 seed = 42;
+	for (usize i = 0; i < n; ++i) {
+		present[i] = splitmix(&seed);
+		absent[i] = splitmix(&seed);
+	}
+
+	memset(legacy.states, 0, sizeof(legacy.states));
+	legacy.ops = MAP_OPS_U64;
+	U64Table_init(&inline_table, allocer_system());
+	if (!map_init(*m, allocer_system(), MAP_OPS_U64))
+		return 0;
+	for (usize i = 0; i < n; ++i) {
+		linear_put(&legacy, present[i], i);
+		if (!map_put(*m, present[i], i))
+			return 0;
+		if (!U64Table_put(&inline_table, present[i], i))
+			return 0;
+	}
+	massert(map_cap(*m) == CAP, "load outside the 2^16 capacity band");
+	return n;
+}
+
+/// stride through the keys out of order
+#define LOOKUP_LOOP(n, get_expr)                                \
+	({                                                      \
+		usize _found = 0;                               \
+		for (usize _i = 0, k = 0; _i < LOOKUPS; ++_i) { \
+			_found += (get_expr) != nullptr;        \
+			k = (k + 7919) % (n);                   \
+		}                                               \
+		_found;                                         \
+	})
+
+static usize lookup_linear(U64Map *m, const u64 *keys, usize n)
+{
+	unused(m);
+	return LOOKUP_LOOP(n, linear_get(&legacy, keys[k]));
+}
+
+static usize lookup_group(U64Map *m, const u64 *keys, usize n)
+{
+	return LOOKUP_LOOP(n, map_get(*m, keys[k]));
+}
+
+static usize lookup_inline(U64Map *m, const u64 *keys, usize n)
+{
+	unused(m);
+	return LOOKUP_LOOP(n, U64Table_get(&inline_table, keys[k]));
+}
+
+static void run_load(usize pct)
+{
+	U64Map m;
+	usize n = fill(&m, pct);
+	if (n == 0)
+		return;
+
+	const struct {
+		const char *name;
+		const u64 *keys;
+		usize (*lookup)(U64Map *m, const u64 *keys, usize n);
+	} cases[] = {
+		{ "hit  linear", present, lookup_linear },
+		{ "hit  group ", present, lookup_group },
+		{ "hit  inline", present, lookup_inline },
+		{ "miss linear", absent, lookup_linear },
+		{ "miss group ", absent, lookup_group },
+		{ "miss inline", absent, lookup_inline },
+	};
+
+	for (usize c = 0; c < array_size(cases); ++c) {
+		u64 start = bench_now_ns();
+		usize found = cases[c].lookup(&m, cases[c].keys, n);
+		u64 elapsed = bench_now_ns() - start;
+		bench_use(found);
+		fprintf(stderr,
+			"bench load %2zu%% %s %20.2f ns/op  (%zu ops)\n", pct,
+			cases[c].name, (double)elapsed / LOOKUPS,
+			(usize)LOOKUPS);
+	}
+
+	map_deinit(m);
+	U64Table_deinit(&inline_table);
+}
+
+/* --- build cost --- */
+
+BENCH(insert_group, 8 * CAP)
+{
+	u64 seed = 7;
+	for (usize done = 0; done < iters; done += CAP * 7 / 8) {
+		U64Map m;
+		if (!map_init(m, allocer_system(), MAP_OPS_U64))
+			return;
+		for (usize i = 0; i < CAP * 7 / 8; ++i)
+			(void)map_put(m, splitmix(&seed), i);
+		bench_use(m.keys);
+		map_deinit(m);
+	}
+}
+
+BENCH(insert_linear, 8 * CAP)
+{
+	u64 seed = 7;
+	legacy.ops = MAP_OPS_U64;
+	for (usize done = 0; done < iters; done += CAP * 7 / 8) {
+		memset(legacy.states, 0, sizeof(legacy.states));
+		for (usize i = 0; i < CAP * 7 / 8; ++i)
+			linear_put(&legacy, splitmix(&seed), i);
+		bench_use(legacy.keys);
+	}
+}
+
+/* --- counting: get + put vs a single entry probe --- */
+
+#define DISTINCT (1u << 20)
+
+BENCH(count_get_put, 2 * 1000 * 1000)
+{
+	U64Map m;
+	if (!map_init(m, allocer_system(), MAP_OPS_U64))
+		return;
+	u64 seed = 3;
+	for (usize i = 0; i < iters; ++i) {
+		u64 key = splitmix(&seed) % DISTINCT;
+		u64 *c = map_get(m, key);
+		if (c)
+			(*c)++;
+		else
+			(void)map_put(m, key, 1);
+	}
+	bench_use(map_len(m));
+	map_deinit(m);
+}
+
+BENCH(count_entry, 2 * 1000 * 1000)
+{
+	U64Map m;
+	if (!map_init(m, allocer_system(), MAP_OPS_U64))
+		return;
+	u64 seed = 3;
+	for (usize i = 0; i < iters; ++i) {
+		u64 key = splitmix(&seed) % DISTINCT;
+		u64 *c = map_entry(m, key, nullptr);
+		if (c)
+			(*c)++;
+	}
+	bench_use(map_len(m));
+	map_deinit(m);
+}
+
+/* --- string keys: cached hashes vs rehashing on growth --- */
+
+#define IDENTS (1u << 20)
+
+static char (*ident_buf)[24];
+static const char **idents;
+
+static bool make_idents(void)
+{
+	if (idents)
+		return true;
+	ident_buf = malloc(sizeof(*ident_buf) * IDENTS);
+	idents = malloc(sizeof(*idents) * IDENTS);
+	if (!ident_buf || !idents)
+		return false;
+	for (usize i = 0; i < IDENTS; ++i) {
+		snprintf(ident_buf[i], sizeof(ident_buf[i]), "local_var_%zu",
+			 i * 2654435761u % 100000000);
+		idents[i] = ident_buf[i];
+	}
+	return true;
+}
+
+static void build_idents(map_ops_t ops, usize iters)
+{
+	if (!make_idents())
+		return;
+	for (usize done = 0; done < iters; done += IDENTS) {
+		map(const char *, u32) m;
+		if (!map_init(m, allocer_system(), ops))
+			return;
+		for (usize i = 0; i < IDENTS; ++i)
+			(void)map_put(m, idents[i], (u32)i);
+		for (usize i = 0; i < IDENTS; ++i)
+			bench_use(map_get(m, idents[i]));
+		map_deinit(m);
+	}
+}
+
+BENCH(idents_rehash, 4 * IDENTS)
+{
+	map_ops_t ops = MAP_OPS_CSTR;
+	ops.cache_hashes = false;
+	build_idents(ops, iters);
+}
+
+BENCH(idents_cached, 4 * IDENTS)
+{
+	build_idents(MAP_OPS_CSTR, iters);
+}
+
+/* --- insert/remove churn: tombstones vs backward shift --- */
+
+#define WINDOW (CAP * 3 / 4)
+
+BENCH(churn_map, 8 * 1000 * 1000)
+{
+	U64Map m;
+	if (!map_init(m, allocer_system(), MAP_OPS_U64))
+		return;
+	for (u64 i = 0; i < WINDOW; ++i)
+		(void)map_put(m, i, i);
+	for (u64 i = WINDOW; i < WINDOW + iters; ++i) {
+		(void)map_remove(m, i - WINDOW);
+		(void)map_put(m, i, i);
+		bench_use(map_get(m, i - WINDOW / 2));
+	}
+	map_deinit(m);
+}
+
+BENCH(churn_rhmap, 8 * 1000 * 1000)
+{
+	rhmap(u64, u64) m;
+	if (!rhmap_init(m, allocer_system(), MAP_OPS_U64))
+		return;
+	for (u64 i = 0; i < WINDOW; ++i)
+		(void)rhmap_put(m, i, i);
+	for (u64 i = WINDOW; i < WINDOW + iters; ++i) {
+		(void)rhmap_remove(m, i - WINDOW);
+		(void)rhmap_put(m, i, i);
+		bench_use(rhmap_get(m, i - WINDOW / 2));
+	}
+	rhmap_deinit(m);
+}
+
+/* --- pointer dedup: map(K, bool) vs set(K) --- */
+
+#define DEDUP_PTRS (1u << 20)
+
+/// 2^20 draws from 2^19 distinct addresses
+static uptr dedup_ptr(u64 *seed)
+{
+	return (uptr)(splitmix(seed) % (DEDUP_PTRS / 2)) * 16;
+}
+
+BENCH(dedup_map, 4 * DEDUP_PTRS)
+{
+	for (usize done = 0; done < iters; done += DEDUP_PTRS) {
+		map(uptr, bool) m;
+		if (!map_init(m, allocer_system(), MAP_OPS_PTR))
+			return;
+		u64 seed = 9;
+		for (usize i = 0; i < DEDUP_PTRS; ++i)
+			(void)map_put(m, dedup_ptr(&seed), true);
+		bench_use(map_len(m));
+		map_deinit(m);
+	}
+}
+
+BENCH(dedup_set, 4 * DEDUP_PTRS)
+{
+	for (usize done = 0; done < iters; done += DEDUP_PTRS) {
+		set(uptr) s;
+		if (!set_init(s, allocer_system(), MAP_OPS_PTR))
+			return;
+		u64 seed = 9;
+		for (usize i = 0; i < DEDUP_PTRS; ++i)
+			(void)set_insert(s, dedup_ptr(&seed), nullptr);
+		bench_use(set_len(s));
+		set_deinit(s);
+	}
+}
+
+/* --- iteration: scanning the table vs the dense entries --- */
+
+#define ITER_KEYS (1u << 20)
+#define ITER_PASSES 20
+
+defIndexmap(u64, u64, U64Index);
+
+static u64 sum_map(U64Map *m)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < map_cap(*m); ++i) {
+		if (m->states[i] < 0x80) /// FULL
+			sum += m->vals[i];
+	}
+	return sum;
+}
+
+static u64 sum_indexmap(U64Index *m)
+{
+	u64 sum = 0;
+	indexmap_foreach(it, *m)
+	{
+		sum += it->val;
+	}
+	return sum;
+}
+
+static void report_iter(const char *name, usize live, u64 elapsed)
+{
+	fprintf(stderr, "bench iterate %-22s %10.2f ns/entry  (%zu live)\n",
+		name, (double)elapsed / ((double)live * ITER_PASSES), live);
+}
+
+/// visit every value, with all keys live and after removing 15/16 of them
+static void run_iterate(void)
+{
+	U64Map m;
+	U64Index im;
+	if (!map_init(m, allocer_system(), MAP_OPS_U64))
+		return;
+	if (!indexmap_init(im, allocer_system(), MAP_OPS_U64))
+		return;
+	u64 seed = 5;
+	for (usize i = 0; i < ITER_KEYS; ++i) {
+		u64 key = splitmix(&seed);
+		(void)map_put(m, key, i);
+		(void)indexmap_put(im, key, i);
+	}
+
+	for (int sparse = 0; sparse < 2; ++sparse) {
+		if (sparse) {
+			seed = 5;
+			for (usize i = 0; i < ITER_KEYS; ++i) {
+				u64 key = splitmix(&seed);
+				if (i % 16 == 0)
+					continue;
+				(void)map_remove(m, key);
+				(void)indexmap_swap_remove(im, key);
+			}
+		}
+
+		u64 start = bench_now_ns();
+		for (int p = 0; p < ITER_PASSES; ++p)
+			bench_use(sum_map(&m));
+		u64 t_map = bench_now_ns() - start;
+
+		start = bench_now_ns();
+		for (int p = 0; p < ITER_PASSES; ++p)
+			bench_use(sum_indexmap(&im));
+		u64 t_index = bench_now_ns() - start;
+
+		report_iter(sparse ? "map scan (sparse)" : "map scan",
+			    map_len(m), t_map);
+		report_iter(sparse ? "indexmap (sparse)" : "indexmap",
+			    indexmap_len(im), t_index);
+	}
+
+	map_deinit(m);
+	indexmap_deinit(im);
+}
+
+/* --- keyword lookup: map(str_t, int) vs a perfect hash --- */
+
+static const char *const KEYWORDS[] = {
+	"auto", "break", "case", "char", "const", "continue", "default", "do",
+	"double", "else", "enum", "extern", "float", "for", "goto", "if",
+	"inline", "int", "long", "register", "restrict", "return", "short",
+	"signed", "sizeof", "static", "struct", "switch", "typedef", "union",
+	"unsigned", "void", "volatile", "while",
+};
+
+#define TOKENS 4096
+
+static u64 _hash_str(const void *key)
+{
+	const str_t *s = (const str_t *)key;
+	return hash_bytes(s->ptr, s->len);
+}
+
+static bool _eq_str(const void *a, const void *b)
+{
+	return str_eq(*(const str_t *)a, *(const str_t *)b);
+}
+
+static const map_ops_t MAP_OPS_STR = { .hash = _hash_str,
+				       .equals = _eq_str };
+
+static char token_buf[TOKENS][16];
+static str_t tokens[TOKENS];
+
+/// a third keywords, the rest identifiers (as a lexer sees them)
+static void make_tokens(void)
+{
+	u64 seed = 13;
+	for (usize i = 0; i < TOKENS; ++i) {
+		u64 r = splitmix(&seed);
+		if (r % 3 == 0) {
+			tokens[i] = str_from_cstr(
+				KEYWORDS[(r >> 8) % array_size(KEYWORDS)]);
+		} else {
+			int len = snprintf(token_buf[i], sizeof(token_buf[i]),
+					   "id%u", (unsigned)(r >> 40));
+			tokens[i] = str_from_parts(token_buf[i], (usize)len);
+		}
+	}
+}
+
+BENCH(keyword_map, 16 * 1000 * 1000)
+{
+	map(str_t, int) m;
+	if (!map_init(m, allocer_system(), MAP_OPS_STR))
+		return;
+	for (usize i = 0; i < array_size(KEYWORDS); ++i)
+		(void)map_put(m, str_from_cstr(KEYWORDS[i]), (int)i);
+	make_tokens();
+
+	usize hits = 0;
+	for (usize i = 0; i < iters; ++i)
+		hits += map_get(m, tokens[i % TOKENS]) != nullptr;
+	bench_use(hits);
+	map_deinit(m);
+}
+
+BENCH(keyword_phf, 16 * 1000 * 1000)
+{
+	str_t keys[array_size(KEYWORDS)];
+	for (usize i = 0; i < array_size(KEYWORDS); ++i)
+		keys[i] = str_from_cstr(KEYWORDS[i]);
+	phf_t t;
+	if (!phf_build(&t, allocer_system(), keys, nullptr,
+		       array_size(KEYWORDS)))
+		return;
+	make_tokens();
+
+	usize hits = 0;
+	for (usize i = 0; i < iters; ++i)
+		hits += phf_get(&t, tokens[i % TOKENS]) != nullptr;
+	bench_use(hits);
+	phf_deinit(&t, allocer_system());
+}
+
+/* --- put latency: one-shot vs incremental growth --- */
+
+#define LATENCY_PUTS (4u << 20)
+
+static u64 *put_ns;
+
+static int cmp_u64(const void *a, const void *b)
+{
+	u64 x = *(const u64 *)a, y = *(const u64 *)b;
+	return (x > y) - (x < y);
+}
+
+/// time every put into a growing map, then report the distribution
+static void put_latency(const char *name, bool incremental)
+{
+	if (!put_ns && !(put_ns = malloc(sizeof(*put_ns) * LATENCY_PUTS)))
+		return;
+
+	U64Map m;
+	allocer_t sys = allocer_system();
+	bool ok = incremental ? map_init_incremental(m, sys, MAP_OPS_U64) :
+				map_init(m, sys, MAP_OPS_U64);
+	if (!ok)
+		return;
+
+	u64 seed = 11, total = 0;
+	for (usize i = 0; i < LATENCY_PUTS; ++i) {
+		u64 key = splitmix(&seed);
+		u64 start = bench_now_ns();
+		(void)map_put(m, key, i);
+		put_ns[i] = bench_now_ns() - start;
+		total += put_ns[i];
+	}
+	bench_use(map_get(m, seed));
+	map_deinit(m);
+
+	qsort(put_ns, LATENCY_PUTS, sizeof(*put_ns), cmp_u64);
+	fprintf(stderr,
+		"bench latency %-11s mean %7.1f  p99 %6llu  p99.9 %6llu  "
+		"max %10llu ns\n",
+		name, (double)total / LATENCY_PUTS,
+		(unsigned long long)put_ns[LATENCY_PUTS / 100 * 99],
+		(unsigned long long)put_ns[LATENCY_PUTS / 1000 * 999],
+		(unsigned long long)put_ns[LATENCY_PUTS - 1]);
+}
+
+int main()
+{
+	static const usize loads[] = { 50, 60, 70, 80, 87 };
+
+	BENCH_GROUP("map(u64, u64) lookups, 2^16 slots");
+	for (usize i = 0; i < array_size(loads); ++i)
+		run_load(loads[i]);
+
+	BENCH_GROUP("fill to 87% (per insert, includes growth for map)");
+	RUN_BENCH(insert_linear);
+	RUN_BENCH(insert_group);
+
+	BENCH_GROUP("counting keys drawn from 2^20, mostly first sightings");
+	RUN_BENCH(count_get_put);
+	RUN_BENCH(count_entry);
+
+	BENCH_GROUP("2^20 identifiers: put + get (per key, includes growth)");
+	RUN_BENCH(idents_rehash);
+	RUN_BENCH(idents_cached);
+
+	BENCH_GROUP("sliding window of 3/4 * 2^16 keys (remove + put + get)");
+	RUN_BENCH(churn_map);
+	RUN_BENCH(churn_rhmap);
+
+	BENCH_GROUP("dedup 2^20 pointers (2^19 distinct, per insert)");
+	RUN_BENCH(dedup_map);
+	RUN_BENCH(dedup_set);
+
+	BENCH_GROUP("sum all values of 2^20 keys, then of 1/16 of them");
+	run_iterate();
+
+	BENCH_GROUP("keyword lookup, 1/3 of tokens are keywords (per token)");
+	RUN_BENCH(keyword_map);
+	RUN_BENCH(keyword_phf);
+
+	BENCH_GROUP("4M random puts from empty: per-put latency (timer incl.)");
+	put_latency("one-shot", false);
+	put_latency("incremental", true);
+
+	return 0;
+}
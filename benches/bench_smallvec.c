@@ -0,0 +1,144 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "bench.h"
+#include <std/allocers/system.h>
+#include <std/allocers/tracking.h>
+#include <std/smallvec.h>
+#include <std/vec.h>
+
+/*
+ * ==========================================================================
+ * Small Vector Benchmarks: vec(T) vs smallvec(T, 4)
+ * ==========================================================================
+ * Builds operand lists for a batch of IR-like instructions, sums them and
+ * frees them. Lengths follow a typical instruction mix: mostly 0-3
+ * operands, a tail of calls with up to 12. Allocation counts come from a
+ * `tracking_t` around the system allocator; timings use the system
+ * allocator directly.
+ */
+
+#define INSTS (1u << 16)
+#define ROUNDS 32
+
+defVec(u32, OpVec);
+defSmallvec(u32, 4, OpSmallVec);
+
+static OpVec g_vecs[INSTS];
+static OpSmallVec g_small[INSTS];
+static u8 g_lens[INSTS];
+
+static u64 splitmix(u64 *state)
+{
+	u64 z = (*state += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+static void gen_lengths(void)
+{
+	u64 state = 1;
+	for (usize i = 0; i < INSTS; ++i) {
+		u64 r = splitmix(&state) % 100;
+		/// 10% none, 30% one, 40% two, 12% three, 8% calls with 4-12
+		g_lens[i] = r < 10 ? 0 :
+			    r < 40 ? 1 :
+			    r < 80 ? 2 :
+			    r < 92 ? 3 :
+				     (u8)(4 + splitmix(&state) % 9);
+	}
+}
+
+static u64 run_vec(allocer_t alc)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < INSTS; ++i) {
+		if (!vec_init(g_vecs[i], alc, 0))
+			return 0;
+		for (u32 j = 0; j < g_lens[i]; ++j)
+			(void)vec_push(g_vecs[i], (u32)i + j);
+	}
+	for (usize i = 0; i < INSTS; ++i) {
+		vec_foreach(it, g_vecs[i])
+		{
+			sum += *it;
+		}
+		vec_deinit(g_vecs[i]);
+	}
+	return sum;
+}
+
+static u64 run_small(allocer_t alc)
+{
+	u64 sum = 0;
+	for (usize i = 0; i < INSTS; ++i) {
+		smallvec_init(g_small[i], alc);
+		for (u32 j = 0; j < g_lens[i]; ++j)
+			(void)vec_push(g_small[i], (u32)i + j);
+	}
+	for (usize i = 0; i < INSTS; ++i) {
+		vec_foreach(it, g_small[i])
+		{
+			sum += *it;
+		}
+		smallvec_deinit(g_small[i]);
+	}
+	return sum;
+}
+
+BENCH(operands_vec, ROUNDS)
+{
+	u64 sum = 0;
+	for (usize r = 0; r < iters; ++r)
+		sum += run_vec(allocer_system());
+	bench_use(sum);
+}
+
+BENCH(operands_smallvec, ROUNDS)
+{
+	u64 sum = 0;
+	for (usize r = 0; r < iters; ++r)
+		sum += run_small(allocer_system());
+	bench_use(sum);
+}
+
+static void report_allocs(const char *name, u64 (*run)(allocer_t))
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+	bench_use(run(tracking_allocer(&tr)));
+	tracking_stats_t st = tracking_stats(&tr);
+	fprintf(stderr,
+		"bench %-10s %zu lists: %7zu allocs %7zu reallocs "
+		"%9zu bytes requested\n",
+		name, (usize)INSTS, st.allocs, st.reallocs, st.total_bytes);
+}
+
+int main()
+{
+	gen_lengths();
+
+	BENCH_GROUP("allocator traffic for 65536 operand lists");
+	report_allocs("vec", run_vec);
+	report_allocs("smallvec", run_small);
+
+	BENCH_GROUP("build + scan + free, per round of 65536 lists");
+	RUN_BENCH(operands_vec);
+	RUN_BENCH(operands_smallvec);
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "bench.h"
+#include <std/allocers/system.h>
+#include <std/vec.h>
+
+/*
+ * ==========================================================================
+ * Vec Bulk Operation Benchmarks
+ * ==========================================================================
+ * Each bulk call is measured against the element-by-element loop it
+ * replaces: appending a slice with `vec_push`, filtering by removing one
+ * element at a time, and inserting a run at the front one element at a
+ * time.
+ */
+
+#define SLICE 256
+#define FILTER_LEN 4096
+
+defVec(u32, U32Vec);
+
+static u32 g_slice[SLICE];
+
+BENCH(append_push_loop, 200000)
+{
+	vec(u32) v;
+	if (!vec_init(v, allocer_system(), 0))
+		return;
+	for (usize i = 0; i < iters; ++i) {
+		vec_clear(v);
+		for (usize j = 0; j < SLICE; ++j)
+			(void)vec_push(v, g_slice[j]);
+	}
+	bench_use(v.data[v.len - 1]);
+	vec_deinit(v);
+}
+
+BENCH(append_extend, 200000)
+{
+	vec(u32) v;
+	if (!vec_init(v, allocer_system(), 0))
+		return;
+	for (usize i = 0; i < iters; ++i) {
+		vec_clear(v);
+		(void)vec_extend_from_array(v, g_slice, SLICE);
+	}
+	bench_use(v.data[v.len - 1]);
+	vec_deinit(v);
+}
+
+static bool keep_odd(const u32 *x)
+{
+	return *x & 1;
+}
+
+/// both filter benches include this refill
+static void fill(U32Vec *v)
+{
+	vec_clear(*v);
+	for (u32 i = 0; i < FILTER_LEN; ++i)
+		(void)vec_push(*v, i * 2654435761u);
+}
+
+BENCH(filter_remove_one_by_one, 200)
+{
+	U32Vec v;
+	if (!vec_init(v, allocer_system(), FILTER_LEN))
+		return;
+	for (usize i = 0; i < iters; ++i) {
+		fill(&v);
+		for (usize j = 0; j < v.len;) {
+			if (keep_odd(&v.data[j]))
+				++j;
+			else
+				vec_remove_range(v, j, j + 1);
+		}
+	}
+	bench_use(v.len);
+	vec_deinit(v);
+}
+
+BENCH(filter_retain, 200)
+{
+	U32Vec v;
+	if (!vec_init(v, allocer_system(), FILTER_LEN))
+		return;
+	for (usize i = 0; i < iters; ++i) {
+		fill(&v);
+		bench_use(vec_retain(v, keep_odd));
+	}
+	bench_use(v.len);
+	vec_deinit(v);
+}
+
+BENCH(prepend_one_by_one, 2000)
+{
+	vec(u32) v;
+	if (!vec_init(v, allocer_system(), 0))
+		return;
+	for (usize i = 0; i < iters; ++i) {
+		vec_clear(v);
+		(void)vec_extend_from_array(v, g_slice, SLICE);
+		for (usize j = 0; j < SLICE; ++j)
+			(void)vec_insert_n(v, j, &g_slice[j], 1);
+	}
+	bench_use(v.len);
+	vec_deinit(v);
+}
+
+BENCH(prepend_insert_n, 2000)
+{
+	vec(u32) v;
+	if (!vec_init(v, allocer_system(), 0))
+		return;
+	for (usize i = 0; i < iters; ++i) {
+		vec_clear(v);
+		(void)vec_extend_from_array(v, g_slice, SLICE);
+		(void)vec_insert_n(v, 0, g_slice, SLICE);
+	}
+	bench_use(v.len);
+	vec_deinit(v);
+}
+
+int main()
+{
+	for (u32 i = 0; i < SLICE; ++i)
+		g_slice[i] = i * 7;
+
+	BENCH_GROUP("append a 256-element slice");
+	RUN_BENCH(append_push_loop);
+	RUN_BENCH(append_extend);
+
+	BENCH_GROUP("drop half of 4096 elements, keeping order");
+	RUN_BENCH(filter_remove_one_by_one);
+	RUN_BENCH(filter_retain);
+
+	BENCH_GROUP("insert 256 elements at the front of 256");
+	RUN_BENCH(prepend_one_by_one);
+	RUN_BENCH(prepend_insert_n);
+
+	return 0;
+}
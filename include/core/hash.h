@@ -17,11 +17,552 @@
 #pragma once
 
 #include <core/type.h>
+#include <string.h> /// for memcpy
 
 /*
  * ==========================================================================
- * FNV-1a Hash Implementation (64-bit)
+ * Word-at-a-Time Hash (rapidhash / wyhash family, 64-bit)
  * ==========================================================================
+ * Input is consumed 8 or 16 bytes at a time and folded with a 64x64->128
+ * multiply ("mum": the two halves of the product XORed together). Inputs
+ * longer than 48 bytes run three independent lanes, so the multiplies
+ * overlap instead of waiting on each other.
+ *
+ * Digests are for in-memory tables only: they depend on the host byte order
+ * and may change between versions. Never persist them.
+ */
+
+/// rapidhash default secret
+#define _HASH_S0 0x2d358dccaa6c78a5ull
+#define _HASH_S1 0x8bb84b93962eacc9ull
+#define _HASH_S2 0x4b33a62ed433d4a3ull
+
+/// full 128-bit product of `*a` and `*b`: low half in `*a`, high in `*b`
+static inline void _hash_mum(u64 *a, u64 *b)
+{
+#if defined(__SIZEOF_INT128__)
+	__uint128_t r = (__uint128_t)*a * *b;
+	*a = (u64)r;
+	*b = (u64)(r >> 64);
+#else
+	u64 ha = *a >> 32, hb = *b >> 32;
+	u64 la = (u32)*a, lb = (u32)*b;
+	u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	u64 t = rl + (rm0 << 32);
+	u64 c = t < rl;
+	u64 lo = t + (rm1 << 32);
+	c += lo < t;
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline u64 _hash_mix(u64 a, u64 b)
+{
+	_hash_mum(&a, &b);
+	return a ^ b;
+}
+
+static inline u64 _hash_r64(const u8 *p)
+{
+	u64 v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline u64 _hash_r32(const u8 *p)
+{
+	u32 v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+/// one 48-byte block: three independent lanes of 16 bytes each
+static inline void _hash_block(u64 lanes[3], const u8 *p)
+{
+	lanes[0] = _hash_mix(_hash_r64(p) ^ _HASH_S0,
+			     _hash_r64(p + 8) ^ lanes[0]);
+	lanes[1] = _hash_mix(_hash_r64(p + 16) ^ _HASH_S1,
+			     _hash_r64(p + 24) ^ lanes[1]);
+	lanes[2] = _hash_mix(_hash_r64(p + 32) ^ _HASH_S2,
+			     _hash_r64(p + 40) ^ lanes[2]);
+}
+
+static inline u64 _hash_final(u64 a, u64 b, u64 seed, usize len)
+{
+	a ^= _HASH_S1;
+	b ^= seed;
+	_hash_mum(&a, &b);
+	return _hash_mix(a ^ _HASH_S0 ^ len, b ^ _HASH_S1);
+}
+
+/**
+ * the last `i` (<= 48) bytes at `p`. The final 16-byte read overlaps what
+ * came before, so `p + i - 16` must be readable even when `i < 16`.
+ */
+static inline u64 _hash_tail(const u8 *p, usize i, u64 seed, usize len)
+{
+	if (i > 16) {
+		seed = _hash_mix(_hash_r64(p) ^ _HASH_S2,
+				 _hash_r64(p + 8) ^ seed ^ _HASH_S1);
+		if (i > 32)
+			seed = _hash_mix(_hash_r64(p + 16) ^ _HASH_S2,
+					 _hash_r64(p + 24) ^ seed);
+	}
+	return _hash_final(_hash_r64(p + i - 16), _hash_r64(p + i - 8), seed,
+			   len);
+}
+
+/// inputs of up to 48 bytes; `seed` is already premixed
+static inline u64 _hash_small(const u8 *p, usize len, u64 seed)
+{
+	u64 a, b;
+
+	seed ^= len;
+	if (len > 16)
+		return _hash_tail(p, len, seed, len);
+
+	if (len >= 4) {
+		/// two possibly overlapping 4-byte reads from each end
+		const u8 *last = p + len - 4;
+		usize delta = (len & 24) >> (len >> 3);
+		a = (_hash_r32(p) << 32) | _hash_r32(last);
+		b = (_hash_r32(p + delta) << 32) | _hash_r32(last - delta);
+	} else if (len > 0) {
+		a = ((u64)p[0] << 56) | ((u64)p[len >> 1] << 32) | p[len - 1];
+		b = 0;
+	} else {
+		a = b = 0;
+	}
+	return _hash_final(a, b, seed, len);
+}
+
+static inline u64 _hash_seed(u64 seed)
+{
+	return seed ^ _hash_mix(seed ^ _HASH_S0, _HASH_S1);
+}
+
+/**
+ * @brief Hash a byte buffer with an explicit seed.
+ *
+ * Different seeds give independent hash functions over the same input.
+ */
+static inline u64 hash_bytes_seeded(const void *data, usize len, u64 seed)
+{
+	const u8 *p = (const u8 *)data;
+
+	seed = _hash_seed(seed);
+	if (len <= 48)
+		return _hash_small(p, len, seed);
+
+	/// every full block goes through the lanes, even the last one; the
+	/// length only enters at the end, which is what lets `hasher_t`
+	/// stream without knowing it up front
+	u64 lanes[3] = { seed, seed, seed };
+	usize i = len;
+	do {
+		_hash_block(lanes, p);
+		p += 48;
+		i -= 48;
+	} while (i >= 48);
+
+	return _hash_tail(p, i, lanes[0] ^ lanes[1] ^ lanes[2], len);
+}
+
+/**
+ * @brief Hash a byte buffer.
+ */
+static inline u64 hash_bytes(const void *data, usize len)
+{
+	return hash_bytes_seeded(data, len, 0);
+}
+
+/**
+ * @brief Helper for hashing integers/pointers (by value representation).
+ */
+#define hash_val(x) hash_bytes(&(x), sizeof(x))
+
+/*
+ * ==========================================================================
+ * Integer Mixers
+ * ==========================================================================
+ * `hash_bytes` specialized for one word: no loads, no length dispatch, the
+ * seed setup folds to a constant. Two multiplies, fully inlined.
+ *
+ * On little-endian hosts `hash_u64(x) == hash_bytes(&x, 8)` and
+ * `hash_u32(x) == hash_bytes(&x, 4)`.
+ */
+
+/**
+ * @brief Hash a 64-bit integer.
+ */
+static inline u64 hash_u64(u64 x)
+{
+	u64 seed = _hash_mix(_HASH_S0, _HASH_S1) ^ 8;
+	u64 a = ((x << 32) | (x >> 32)) ^ _HASH_S1;
+	u64 b = x ^ seed;
+	_hash_mum(&a, &b);
+	return _hash_mix(a ^ _HASH_S0 ^ 8, b ^ _HASH_S1);
+}
+
+/**
+ * @brief Hash a 32-bit integer.
+ */
+static inline u64 hash_u32(u32 x)
+{
+	u64 seed = _hash_mix(_HASH_S0, _HASH_S1) ^ 4;
+	u64 w = ((u64)x << 32) | x;
+	u64 a = w ^ _HASH_S1;
+	u64 b = w ^ seed;
+	_hash_mum(&a, &b);
+	return _hash_mix(a ^ _HASH_S0 ^ 4, b ^ _HASH_S1);
+}
+
+/**
+ * @brief Hash a pointer by address.
+ */
+static inline u64 hash_ptr(const void *ptr)
+{
+	return hash_u64((u64)(usize)ptr);
+}
+
+/*
+ * ==========================================================================
+ * Streaming Hasher
+ * ==========================================================================
+ * Feeds `hash_bytes_seeded` piece by piece: the digest of a sequence of
+ * updates equals the one-shot digest of their concatenation, so composite
+ * keys hash without being copied into a temporary buffer first.
+ *
+ * @example
+ * hasher_t h;
+ * hasher_init(&h);
+ * hasher_update(&h, dir.ptr, dir.len);
+ * hasher_update(&h, name.ptr, name.len);
+ * hasher_write_u64(&h, mtime);
+ * u64 digest = hasher_finish(&h);
+ *
+ * Memory Layout of `buf`:
+ * [-- last 16 bytes of the previous block --][---- pending (<= 48) ----]
+ *
+ * A full pending block is held back until more input arrives: whether it
+ * goes through the lanes or the short path depends on the total length.
+ */
+
+/**
+ * buffer `len` bytes into `buf`, running `block` over every 48-byte block
+ * that is known not to be the last one. Shared by `hasher_t` and
+ * `hasher128_t`, which differ only in the block function.
+ */
+static inline void _hash_feed(u8 buf[64], usize *pending, const u8 *p,
+			      usize len, void (*block)(u64 *, const u8 *),
+			      u64 *lanes)
+{
+	while (len > 0) {
+		if (*pending == 48) {
+			/// more input follows, so the held block is not the end
+			block(lanes, buf + 16);
+			memcpy(buf, buf + 48, 16);
+			*pending = 0;
+		}
+		if (*pending == 0 && len > 48) {
+			/// straight from the input, still holding back the tail
+			do {
+				block(lanes, p);
+				p += 48;
+				len -= 48;
+			} while (len > 48);
+			memcpy(buf, p - 16, 16);
+		}
+		usize n = 48 - *pending;
+		n = n < len ? n : len;
+		memcpy(buf + 16 + *pending, p, n);
+		*pending += n;
+		p += n;
+		len -= n;
+	}
+}
+
+typedef struct Hasher {
+	u64 seed; /// premixed seed
+	u64 lanes[3];
+	u64 len; /// bytes consumed so far
+	usize pending;
+	u8 buf[16 + 48];
+} hasher_t;
+
+/**
+ * @brief Start a hash with an explicit seed (see `hash_bytes_seeded`).
+ */
+static inline void hasher_init_seeded(hasher_t *h, u64 seed)
+{
+	h->seed = _hash_seed(seed);
+	h->lanes[0] = h->lanes[1] = h->lanes[2] = h->seed;
+	h->len = 0;
+	h->pending = 0;
+}
+
+/**
+ * @brief Start a hash matching `hash_bytes`.
+ */
+static inline void hasher_init(hasher_t *h)
+{
+	hasher_init_seeded(h, 0);
+}
+
+/**
+ * @brief Append `len` bytes to the hashed input.
+ */
+static inline void hasher_update(hasher_t *h, const void *data, usize len)
+{
+	h->len += len;
+	_hash_feed(h->buf, &h->pending, (const u8 *)data, len, _hash_block,
+		   h->lanes);
+}
+
+/**
+ * @brief Append a 64-bit integer (by value representation, as `hash_val`).
+ */
+static inline void hasher_write_u64(hasher_t *h, u64 x)
+{
+	hasher_update(h, &x, sizeof(x));
+}
+
+/**
+ * @brief Digest of everything written so far.
+ * @note Does not modify the hasher: more input may follow.
+ */
+[[nodiscard]]
+static inline u64 hasher_finish(const hasher_t *h)
+{
+	const u8 *p = h->buf + 16;
+	usize len = (usize)h->len;
+
+	if (len <= 48)
+		return _hash_small(p, len, h->seed);
+
+	u64 lanes[3] = { h->lanes[0], h->lanes[1], h->lanes[2] };
+	usize i = h->pending;
+	if (i == 48) {
+		_hash_block(lanes, p);
+		p += 48;
+		i = 0;
+	}
+	return _hash_tail(p, i, lanes[0] ^ lanes[1] ^ lanes[2], len);
+}
+
+/*
+ * ==========================================================================
+ * 128-bit Fingerprints
+ * ==========================================================================
+ * For content addressing (build caches, "did this file change?"), where a
+ * 64-bit digest collides too soon. One pass over the input feeds two sets
+ * of three lanes; the second pairs the same words differently under other
+ * secrets, so a change to any word has to cancel out in two unrelated
+ * chains at once.
+ *
+ * Unlike `hash_bytes`, the digest is STABLE: input words are read as
+ * little-endian on every host and the definition below is frozen, so
+ * fingerprints may be persisted and compared across builds and machines.
+ * It deliberately shares no code with `hash_bytes` (only the 64x64->128
+ * product), which stays free to change. The known-answer test in
+ * tests/test_hash.c pins it. Fast, not cryptographic.
+ */
+
+/// frozen copies of the secrets, independent of `_HASH_S*`
+#define _FP_S0 0x2d358dccaa6c78a5ull
+#define _FP_S1 0x8bb84b93962eacc9ull
+#define _FP_S2 0x4b33a62ed433d4a3ull
+#define _FP_S3 0x4d5a2da51de1aa47ull
+#define _FP_S4 0xa0761d6478bd642full
+#define _FP_S5 0xe7037ed1a0b428dbull
+#define _FP_SEED_HI 0x90ed1765281c388cull
+
+typedef struct Hash128 {
+	u64 lo;
+	u64 hi;
+} hash128_t;
+
+static inline bool hash128_eq(hash128_t a, hash128_t b)
+{
+	return a.lo == b.lo && a.hi == b.hi;
+}
+
+/// little-endian loads; a plain load on little-endian hosts
+static inline u64 _fp_r64(const u8 *p)
+{
+	u64 v;
+	memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+static inline u64 _fp_r32(const u8 *p)
+{
+	u32 v;
+	memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	return v;
+}
+
+static inline u64 _fp_mix(u64 a, u64 b)
+{
+	_hash_mum(&a, &b);
+	return a ^ b;
+}
+
+static inline u64 _fp_seed(u64 seed)
+{
+	return seed ^ _fp_mix(seed ^ _FP_S0, _FP_S1);
+}
+
+/// one 48-byte block: lanes[0..3) pair adjacent words, lanes[3..6) re-pair
+static inline void _fp_block(u64 lanes[6], const u8 *p)
+{
+	u64 w0 = _fp_r64(p), w1 = _fp_r64(p + 8);
+	u64 w2 = _fp_r64(p + 16), w3 = _fp_r64(p + 24);
+	u64 w4 = _fp_r64(p + 32), w5 = _fp_r64(p + 40);
+
+	lanes[0] = _fp_mix(w0 ^ _FP_S0, w1 ^ lanes[0]);
+	lanes[1] = _fp_mix(w2 ^ _FP_S1, w3 ^ lanes[1]);
+	lanes[2] = _fp_mix(w4 ^ _FP_S2, w5 ^ lanes[2]);
+	lanes[3] = _fp_mix(w0 ^ _FP_S3, w3 ^ lanes[3]);
+	lanes[4] = _fp_mix(w2 ^ _FP_S4, w5 ^ lanes[4]);
+	lanes[5] = _fp_mix(w4 ^ _FP_S5, w1 ^ lanes[5]);
+}
+
+static inline u64 _fp_final(u64 a, u64 b, u64 seed, usize len)
+{
+	a ^= _FP_S1;
+	b ^= seed;
+	_hash_mum(&a, &b);
+	return _fp_mix(a ^ _FP_S0 ^ len, b ^ _FP_S1);
+}
+
+/// the last `i` (<= 48) bytes at `p`, `p + i - 16` readable (as `_hash_tail`)
+static inline u64 _fp_tail(const u8 *p, usize i, u64 seed, usize len)
+{
+	if (i > 16) {
+		seed = _fp_mix(_fp_r64(p) ^ _FP_S2,
+			       _fp_r64(p + 8) ^ seed ^ _FP_S1);
+		if (i > 32)
+			seed = _fp_mix(_fp_r64(p + 16) ^ _FP_S2,
+				       _fp_r64(p + 24) ^ seed);
+	}
+	return _fp_final(_fp_r64(p + i - 16), _fp_r64(p + i - 8), seed, len);
+}
+
+/// inputs of up to 48 bytes; `seed` is already premixed
+static inline u64 _fp_small(const u8 *p, usize len, u64 seed)
+{
+	u64 a, b;
+
+	seed ^= len;
+	if (len > 16)
+		return _fp_tail(p, len, seed, len);
+
+	if (len >= 4) {
+		const u8 *last = p + len - 4;
+		usize delta = (len & 24) >> (len >> 3);
+		a = (_fp_r32(p) << 32) | _fp_r32(last);
+		b = (_fp_r32(p + delta) << 32) | _fp_r32(last - delta);
+	} else if (len > 0) {
+		a = ((u64)p[0] << 56) | ((u64)p[len >> 1] << 32) | p[len - 1];
+		b = 0;
+	} else {
+		a = b = 0;
+	}
+	return _fp_final(a, b, seed, len);
+}
+
+/**
+ * Streaming 128-bit fingerprint, used like `hasher_t`. The layout of `buf`
+ * and the hold-back rule are the same.
+ */
+typedef struct Hasher128 {
+	u64 lanes[6];
+	u64 len;
+	usize pending;
+	u8 buf[16 + 48];
+} hasher128_t;
+
+/**
+ * @brief Start a 128-bit fingerprint.
+ */
+static inline void hasher128_init(hasher128_t *h)
+{
+	u64 lo = _fp_seed(0), hi = _fp_seed(_FP_SEED_HI);
+	h->lanes[0] = h->lanes[1] = h->lanes[2] = lo;
+	h->lanes[3] = h->lanes[4] = h->lanes[5] = hi;
+	h->len = 0;
+	h->pending = 0;
+}
+
+/**
+ * @brief Append `len` bytes to the fingerprinted input.
+ */
+static inline void hasher128_update(hasher128_t *h, const void *data,
+				    usize len)
+{
+	h->len += len;
+	_hash_feed(h->buf, &h->pending, (const u8 *)data, len, _fp_block,
+		   h->lanes);
+}
+
+/**
+ * @brief Fingerprint of everything written so far.
+ * @note Does not modify the hasher: more input may follow.
+ */
+[[nodiscard]]
+static inline hash128_t hasher128_finish(const hasher128_t *h)
+{
+	const u8 *p = h->buf + 16;
+	usize len = (usize)h->len;
+
+	if (len <= 48) {
+		return (hash128_t){
+			.lo = _fp_small(p, len, _fp_seed(0)),
+			.hi = _fp_small(p, len, _fp_seed(_FP_SEED_HI)),
+		};
+	}
+
+	u64 l[6];
+	memcpy(l, h->lanes, sizeof(l));
+	usize i = h->pending;
+	if (i == 48) {
+		_fp_block(l, p);
+		p += 48;
+		i = 0;
+	}
+	return (hash128_t){
+		.lo = _fp_tail(p, i, l[0] ^ l[1] ^ l[2], len),
+		.hi = _fp_tail(p, i, l[3] ^ l[4] ^ l[5], len),
+	};
+}
+
+/**
+ * @brief 128-bit fingerprint of a byte buffer.
+ * @note Stable across hosts, byte orders and versions: safe to persist.
+ */
+static inline hash128_t hash128_bytes(const void *data, usize len)
+{
+	hasher128_t h;
+	hasher128_init(&h);
+	hasher128_update(&h, data, len);
+	return hasher128_finish(&h);
+}
+
+/*
+ * ==========================================================================
+ * FNV-1a (64-bit)
+ * ==========================================================================
+ * The previous `hash_bytes`: one byte per step, each step a dependent
+ * multiply. Kept as a baseline for benchmarks and for callers that need a
+ * digest that never changes.
  */
 
 #define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
@@ -30,7 +571,7 @@
 /**
  * @brief Compute FNV-1a hash for a byte buffer.
  */
-static inline u64 hash_bytes(const void *data, usize len)
+static inline u64 hash_fnv1a(const void *data, usize len)
 {
 	u64 hash = FNV_OFFSET_BASIS;
 	const u8 *bytes = (const u8 *)data;
@@ -41,8 +582,3 @@ static inline u64 hash_bytes(const void *data, usize len)
 	}
 	return hash;
 }
-
-/**
- * @brief Helper for hashing integers/pointers (by value representation).
- */
-#define hash_val(x) hash_bytes(&(x), sizeof(x))
@@ -188,3 +188,45 @@ static inline anyptr allocer_realloc(allocer_t allocer, anyptr ptr,
  */
 #define free_array(allocer, ptr, count) \
 	allocer_free(allocer, ptr, layout_of_array(typeof(*(ptr)), count))
+
+/*
+ * ============================================================================
+ * Call-Site Attribution
+ * ============================================================================
+ * Build with `-DFLUF_TRACK_ALLOC_SITES` (`make TRACK_ALLOC_SITES=1`) and every
+ * `allocer_*` call (and the macros above) stores its `__FILE__`/`__LINE__` in
+ * a thread-local slot right before dispatching. Decorators such as
+ * `tracking_t` (std/allocers/tracking.h) read it to attribute memory to the
+ * code that asked for it. Without the flag nothing is recorded.
+ */
+
+/**
+ * @brief Source location of an allocation request.
+ */
+typedef struct AllocSite {
+	const char *file; /// nullptr if unknown
+	u32 line;
+} alloc_site_t;
+
+/// site of the `allocer_*` call being dispatched on this thread
+extern thread_local alloc_site_t allocer_site;
+
+#ifdef FLUF_TRACK_ALLOC_SITES
+
+#define _allocer_mark_site() \
+	(allocer_site = (alloc_site_t){ .file = __FILE__, .line = __LINE__ })
+
+#define allocer_alloc(allocer, layout) \
+	(_allocer_mark_site(), allocer_alloc(allocer, layout))
+
+#define allocer_free(allocer, ptr, layout) \
+	(_allocer_mark_site(), allocer_free(allocer, ptr, layout))
+
+#define allocer_zalloc(allocer, layout) \
+	(_allocer_mark_site(), allocer_zalloc(allocer, layout))
+
+#define allocer_realloc(allocer, ptr, old_layout, new_layout) \
+	(_allocer_mark_site(),                                \
+	 allocer_realloc(allocer, ptr, old_layout, new_layout))
+
+#endif
@@ -21,6 +21,8 @@
 #include <core/type.h>
 #include <std/strings/str.h>
 #include <core/msg.h>
+#include <core/math.h> /// for align_up, align_down
+#include <string.h> /// for memset
 
 /*
  * ==========================================================================
@@ -51,6 +53,7 @@
 typedef struct ChunkFooter {
 	u8 *data_start;
 	usize chunk_size;
+	usize chunk_align; /// alignment the chunk was allocated with
 	struct ChunkFooter *prev;
 	u8 *ptr; /// current bump pointer
 	usize allocated_bytes; /// for stats
@@ -73,6 +76,14 @@ typedef struct Bump {
 	usize limit;
 	usize allocated; // Total bytes allocated from backing allocator
 	usize min_align; // Minimum alignment for every alloc
+
+	/// Concurrent mode (see `bump_init_concurrent`).
+	bool concurrent;
+	u32 grow_lock; // spin lock serializing chunk growth
+
+	/// Chunks detached by `bump_rewind_to(..., true)`, reused before
+	/// asking the backing allocator (linked through `prev`).
+	chunk_footer_t *spare;
 } bump_t;
 
 /*
@@ -90,6 +101,25 @@ typedef struct Bump {
  */
 void bump_init(bump_t *self, allocer_t backing, usize min_align);
 
+/**
+ * @brief Initialize a bump arena that many threads may allocate from at once.
+ *
+ * ### Strategy
+ * - **Fast path**: a lock-free CAS loop on `current_chunk->ptr`, so N worker
+ * threads can carve AST nodes out of the same chunk without locking.
+ * - **Slow path**: growing the chunk list is serialized by a spin lock. A new
+ * chunk is fully initialized before it is published as `current_chunk`.
+ *
+ * Every allocation, wherever it was made, is released by one `bump_reset` or
+ * `bump_deinit` once the workers are done.
+ *
+ * @note Only the allocation API (`bump_alloc*`, `bump_zalloc`, `bump_dup_str`,
+ * `bump_realloc` and the `bump_allocer` adapter) is thread-safe. `bump_reset`,
+ * `bump_deinit` and `bump_set_allocation_limit` must not race with allocations.
+ * `bump_realloc` never resizes in place in this mode.
+ */
+void bump_init_concurrent(bump_t *self, allocer_t backing, usize min_align);
+
 /**
  * @brief De-initialize the arena.
  * Frees all chunks allocated by this arena back to the backing allocator.
@@ -116,8 +146,8 @@ void bump_drop(bump_t *self);
  *
  * ### Strategy: "Keep the Tip".
  * This function frees all chunks *except* the current one.
- * Frees all *other* chunks to the backing allocator,
- * useful for per-frame allocators.
+ * Frees all *other* chunks to the backing allocator (or to the global chunk
+ * pool, if enabled), useful for per-frame allocators.
  *
  * ### Why?
  * Since chunks typically grow geometrically (doubling size), the current chunk
@@ -190,10 +220,15 @@ char *bump_alloc_cstr(bump_t *self, const char *str);
 char *bump_dup_str(bump_t *self, str_t s);
 
 /**
- * @brief Resize a memory block (Pseudo-realloc).
+ * @brief Resize a memory block.
+ *
+ * If `old_ptr` is the most recent allocation in the current chunk, the block
+ * is resized in place: shrinking keeps the address, growing slides the block
+ * down (the arena grows down) with `memmove`. Nothing is left behind, so a
+ * `vec`/`string_t` growing on an arena only ever occupies its final capacity.
  *
- * Since bump allocators cannot really resize in place (unless it's the last alloc),
- * this typically allocates new memory and copies data.
+ * Otherwise (or if the current chunk is full), it allocates new memory and
+ * copies data; the old block stays in the arena until reset.
  */
 [[nodiscard]]
 anyptr bump_realloc(bump_t *self, anyptr old_ptr, usize old_size,
@@ -225,7 +260,156 @@ usize bump_get_allocated_bytes(bump_t *self);
 
 /*
  * ==========================================================================
- * 6. Allocer Interface (VTable Adapter)
+ * 6. Checkpoints & Scratch Arenas
+ * ==========================================================================
+ * Temporary memory inside a pass, given back in one step without throwing
+ * away everything allocated before it (unlike `bump_reset`).
+ *
+ * ```c
+ * bump_mark_t m = bump_mark(arena);
+ * ... temporary allocations ...
+ * bump_rewind_to(arena, m, true);
+ * ```
+ *
+ * @note Not thread-safe, even for arenas in concurrent mode.
+ */
+
+/**
+ * @brief A checkpoint: the arena position at some moment.
+ */
+typedef struct BumpMark {
+	chunk_footer_t *chunk;
+	u8 *ptr;
+} bump_mark_t;
+
+/**
+ * @brief Record the current position of the arena.
+ */
+bump_mark_t bump_mark(const bump_t *self);
+
+/**
+ * @brief Free everything allocated since `mark` was taken.
+ *
+ * Restores `current_chunk` and its bump pointer. Chunks created after the
+ * mark are released (to the global pool or the backing allocator), or, if
+ * `keep_chunks` is true, kept on the arena for the next growth, so a pass
+ * that is run repeatedly stops hitting the backing allocator.
+ *
+ * @warning `mark` must come from this arena and must not predate a
+ * `bump_reset` or an earlier rewind past it.
+ */
+void bump_rewind_to(bump_t *self, bump_mark_t mark, bool keep_chunks);
+
+/**
+ * @brief Free the chunks kept by `bump_rewind_to`.
+ */
+void bump_release_spare(bump_t *self);
+
+/**
+ * @brief A borrowed thread-local scratch arena plus the mark to return to.
+ */
+typedef struct BumpScratch {
+	bump_t *arena;
+	bump_mark_t mark;
+} bump_scratch_t;
+
+/**
+ * @brief Borrow one of the calling thread's two scratch arenas.
+ *
+ * ### Conflict avoidance
+ * A function that takes an output arena and also wants scratch memory must
+ * not get the same arena back (rewinding would destroy its results). Pass
+ * that arena as `conflict` and the other scratch arena is returned. With
+ * two arenas, nested scratch scopes always have one free.
+ *
+ * @param conflict Arena that must not be returned (may be nullptr).
+ */
+bump_scratch_t bump_scratch_begin(const bump_t *conflict);
+
+/**
+ * @brief Rewind the scratch arena to where `bump_scratch_begin` found it.
+ * Chunks are kept for the next scope.
+ */
+void bump_scratch_end(bump_scratch_t *scratch);
+
+/**
+ * @brief Free the calling thread's scratch arenas.
+ * Call before a thread that used scratch memory exits.
+ */
+void bump_scratch_release(void);
+
+/**
+ * @brief Declare a scratch scope, ended automatically at the closing brace.
+ *
+ * Usage:
+ * ```c
+ * str_t build(bump_t *out)
+ * {
+ *	bump_scratch_let(tmp, out);
+ *	char *buf = bump_alloc_array(tmp.arena, char, 4096);
+ *	...
+ * }
+ * ```
+ */
+#define bump_scratch_let(var_name, conflict)              \
+	defer(bump_scratch_end) bump_scratch_t var_name = \
+		bump_scratch_begin(conflict)
+
+/*
+ * ==========================================================================
+ * 7. Global Chunk Pool
+ * ==========================================================================
+ * A process-wide cache of released chunks shared by all arenas.
+ *
+ * When enabled, `bump_reset` / `bump_deinit` / `bump_drop` hand their chunks
+ * to the pool instead of the backing allocator, and new chunks are taken from
+ * it first. Short-lived per-request arenas then reach a steady state with zero
+ * backing allocations.
+ *
+ * - Chunks are bucketed by size class (power-of-two ranges).
+ * - A cached chunk is only reused by an arena with the *same* backing
+ * allocator (same `self` and `vtable`), and is eventually freed to it.
+ * - Thread-safe (guarded by an internal spin lock).
+ *
+ * @warning The backing allocators of pooled chunks must stay valid until
+ * the chunks are trimmed (`bump_pool_trim` or lowering the limit).
+ */
+
+/**
+ * @brief Pool statistics (counters are cumulative, sizes are current).
+ */
+typedef struct BumpPoolStats {
+	usize hits; /// chunks served from the pool
+	usize misses; /// chunks that had to come from a backing allocator
+	usize returned; /// chunks given back to the pool
+	usize released; /// chunks freed to their backing (pool full or trimmed)
+	usize cached_chunks; /// chunks currently held
+	usize cached_bytes; /// bytes currently held
+	usize peak_cached_bytes; /// high-water mark of `cached_bytes`
+} bump_pool_stats_t;
+
+/**
+ * @brief Enable the pool and set its high-water mark.
+ *
+ * @param max_bytes Maximum bytes the pool may cache. Chunks released beyond
+ * this are freed to their backing allocator. Pass `0` to disable pooling
+ * (the default); this also frees every cached chunk.
+ */
+void bump_pool_set_limit(usize max_bytes);
+
+/**
+ * @brief Free every cached chunk back to its backing allocator.
+ */
+void bump_pool_trim(void);
+
+/**
+ * @brief Get a snapshot of the pool statistics.
+ */
+bump_pool_stats_t bump_pool_stats(void);
+
+/*
+ * ==========================================================================
+ * 8. Allocer Interface (VTable Adapter)
  * ==========================================================================
  */
 
@@ -235,9 +419,131 @@ usize bump_get_allocated_bytes(bump_t *self);
  */
 allocer_t bump_allocer(bump_t *self);
 
+/// the vtable behind `bump_allocer`, exposed for devirtualization
+extern const allocer_vtable_t BUMP_VTABLE;
+
+/**
+ * @brief Check whether a generic allocator is a bump arena.
+ */
+static inline bool allocer_is_bump(allocer_t allocer)
+{
+	return allocer.vtable == &BUMP_VTABLE;
+}
+
+/**
+ * @brief Inlinable allocation fast path.
+ *
+ * Bumps the pointer of the current chunk directly; anything else (new
+ * chunk, concurrent mode, zero size) goes through `bump_alloc_layout`.
+ * Same result as `bump_alloc_layout`, minus the call in the common case.
+ */
+[[nodiscard]]
+static inline anyptr bump_alloc_inline(bump_t *self, layout_t layout)
+{
+	chunk_footer_t *footer = self->current_chunk;
+	/// same alignment default as `bump_alloc_layout`
+	if (unlikely(!is_power_of_two(layout.align)))
+		layout.align = 1;
+	usize align = layout.align > self->min_align ? layout.align :
+						       self->min_align;
+	usize size = align_up(layout.size, align);
+	uptr end = align_down((uptr)footer->ptr, align);
+	uptr start = (uptr)footer->data_start;
+
+	if (likely(!self->concurrent && layout.size != 0 && end >= start &&
+		   size <= end - start)) {
+		footer->ptr = (u8 *)(end - size);
+		return (anyptr)footer->ptr;
+	}
+	return bump_alloc_layout(self, layout);
+}
+
+/*
+ * ==========================================================================
+ * 9. Devirtualized Dispatch
+ * ==========================================================================
+ * `allocer_*` always calls through `allocer_vtable_t`. For a bump arena the
+ * indirect call costs more than the allocation itself, so hot containers
+ * (`vec`, `map`, `string_t`) use these wrappers instead: one compare against
+ * `BUMP_VTABLE`, then the bump fast path is inlined into the caller. Every
+ * other allocator takes the usual vtable route. The compare carries no
+ * branch hint: no allocator is favoured over another.
+ */
+
+static inline anyptr _allocer_alloc_fast(allocer_t allocer, layout_t layout)
+{
+	if (allocer_is_bump(allocer))
+		return bump_alloc_inline((bump_t *)allocer.self, layout);
+	return (allocer_alloc)(allocer, layout);
+}
+
+static inline anyptr _allocer_zalloc_fast(allocer_t allocer, layout_t layout)
+{
+	if (allocer_is_bump(allocer)) {
+		anyptr ptr = bump_alloc_inline((bump_t *)allocer.self, layout);
+		if (ptr && layout.size > 0)
+			memset(ptr, 0, layout.size);
+		return ptr;
+	}
+	return (allocer_zalloc)(allocer, layout);
+}
+
+static inline void _allocer_free_fast(allocer_t allocer, anyptr ptr,
+				      layout_t layout)
+{
+	/// bump memory is only reclaimed by reset
+	if (allocer_is_bump(allocer))
+		return;
+	(allocer_free)(allocer, ptr, layout);
+}
+
+static inline anyptr _allocer_realloc_fast(allocer_t allocer, anyptr ptr,
+					   layout_t old_layout,
+					   layout_t new_layout)
+{
+	/// a direct call: keeps the in-place tip resize
+	if (allocer_is_bump(allocer))
+		return bump_realloc((bump_t *)allocer.self, ptr,
+				    old_layout.size, new_layout.size,
+				    new_layout.align);
+	return (allocer_realloc)(allocer, ptr, old_layout, new_layout);
+}
+
+/// same call-site attribution as `allocer_*` (see core/mem/allocer.h)
+#ifdef FLUF_TRACK_ALLOC_SITES
+#define _allocer_fast_site(call) (_allocer_mark_site(), call)
+#else
+#define _allocer_fast_site(call) (call)
+#endif
+
+/**
+ * @brief `allocer_alloc`, with the bump arena fast path inlined.
+ */
+#define allocer_alloc_fast(allocer, layout) \
+	_allocer_fast_site(_allocer_alloc_fast(allocer, layout))
+
+/**
+ * @brief `allocer_zalloc`, with the bump arena fast path inlined.
+ */
+#define allocer_zalloc_fast(allocer, layout) \
+	_allocer_fast_site(_allocer_zalloc_fast(allocer, layout))
+
+/**
+ * @brief `allocer_free`, a no-op for bump arenas without any call.
+ */
+#define allocer_free_fast(allocer, ptr, layout) \
+	_allocer_fast_site(_allocer_free_fast(allocer, ptr, layout))
+
+/**
+ * @brief `allocer_realloc`, calling `bump_realloc` directly for bump arenas.
+ */
+#define allocer_realloc_fast(allocer, ptr, old_layout, new_layout) \
+	_allocer_fast_site(                                         \
+		_allocer_realloc_fast(allocer, ptr, old_layout, new_layout))
+
 /*
  * ==========================================================================
- * 7. Helper Macros (Type-Safe Syntax Sugar)
+ * 10. Helper Macros (Type-Safe Syntax Sugar)
  * ==========================================================================
  */
 
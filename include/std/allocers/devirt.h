@@ -0,0 +1,56 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <core/mem/allocer.h>
+#include <std/allocers/bump.h>
+#include <std/allocers/pool.h>
+#include <std/allocers/tlsf.h>
+#include <std/allocers/vmem.h>
+#include <std/allocers/tracking.h>
+
+/*
+ * ==========================================================================
+ * Static Adapter Selection
+ * ==========================================================================
+ * `allocer_of` names every allocator type, hence all the includes. The
+ * devirtualized `allocer_*_fast` wrappers live in std/allocers/bump.h, next
+ * to the fast path they inline, so containers only need that one header.
+ */
+
+static inline allocer_t _allocer_identity(allocer_t allocer)
+{
+	return allocer;
+}
+
+/**
+ * @brief Turn any allocator into an `allocer_t`, picked by its static type.
+ *
+ * Usage:
+ * ```c
+ * bump_t arena;
+ * vec_init(v, allocer_of(&arena), 0); /// same as bump_allocer(&arena)
+ * ```
+ */
+#define allocer_of(a)                           \
+	_Generic((a),                           \
+		bump_t *: bump_allocer,         \
+		pool_t *: pool_allocer,         \
+		tlsf_t *: tlsf_allocer,         \
+		vmem_t *: vmem_allocer,         \
+		tracking_t *: tracking_allocer, \
+		allocer_t: _allocer_identity)(a)
@@ -0,0 +1,194 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <core/mem/layout.h>
+#include <core/mem/allocer.h>
+#include <core/type.h>
+
+/*
+ * ==========================================================================
+ * 1. Internal Structures
+ * ==========================================================================
+ */
+
+/// Objects up to this size are served from slabs.
+/// Larger (or over-aligned) requests go straight to the backing allocator.
+#define POOL_MAX_SIZE 4096
+
+/// Every object is aligned to at least this much.
+#define POOL_ALIGN 16
+
+/// Size classes: 16..256 in 16-byte steps, then 512, 1024, 2048, 4096.
+#define POOL_NUM_CLASSES 20
+
+/// Bytes requested from the backing allocator per slab.
+#define POOL_SLAB_SIZE (64 * 1024)
+
+/**
+ * @brief A slab: one block from the backing allocator, carved into objects
+ * of a single size class. All slabs are chained for bulk release.
+ *
+ * Memory Layout:
+ * [-- PoolSlab --][ obj ][ obj ][ obj ] ... [ obj ]
+ */
+typedef struct PoolSlab {
+	struct PoolSlab *next;
+	usize size; /// total bytes (for freeing)
+} pool_slab_t;
+
+/**
+ * @brief Intrusive free-list node, stored inside a freed object.
+ */
+typedef struct PoolFree {
+	struct PoolFree *next;
+} pool_free_t;
+
+/**
+ * @brief Per size-class state.
+ *
+ * Objects are handed out from `free_list` first, then carved lazily from
+ * the current slab `[cur, end)`, so a new slab is never walked up front.
+ */
+typedef struct PoolClass {
+	pool_free_t *free_list;
+	u8 *cur;
+	u8 *end;
+	usize obj_size;
+} pool_class_t;
+
+/*
+ * ==========================================================================
+ * 2. The Pool Type
+ * ==========================================================================
+ */
+
+/**
+ * @brief Size-class slab allocator.
+ *
+ * - Alloc / Free: O(1) (pop / push on an intrusive free list).
+ * - Bulk release: `pool_reset` returns every slab at once.
+ * - Thread Safe: No.
+ *
+ * Made for workloads that free and re-create many same-sized objects
+ * (IR nodes, AST nodes), where `allocer_system()` would hit the C runtime
+ * for each object and `bump_t` could never reuse memory.
+ */
+typedef struct Pool {
+	pool_class_t classes[POOL_NUM_CLASSES];
+	pool_slab_t *slabs; /// all slabs (for bulk release)
+	allocer_t backing;
+	usize slab_count;
+} pool_t;
+
+/*
+ * ==========================================================================
+ * 3. Lifecycle API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Initialize a pool on the stack (or pre-allocated memory).
+ * @note Lazy: no slab is allocated until the first request.
+ */
+void pool_init(pool_t *self, allocer_t backing);
+
+/**
+ * @brief Free every slab (and thus every object) back to the backing allocator.
+ * @warning Large objects (> POOL_MAX_SIZE) are owned by the caller and must
+ * be freed individually with `pool_free`.
+ */
+void pool_deinit(pool_t *self);
+
+/**
+ * @brief Allocate a new pool on the heap (using the backing allocator).
+ */
+pool_t *pool_new(allocer_t backing);
+
+/**
+ * @brief Destroy the pool and free the `pool_t` structure.
+ */
+void pool_drop(pool_t *self);
+
+/**
+ * @brief Release all objects at once (bulk release).
+ * Same as `pool_deinit` followed by `pool_init`.
+ */
+void pool_reset(pool_t *self);
+
+/*
+ * ==========================================================================
+ * 4. Allocation API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Allocate an object.
+ * @return nullptr on OOM.
+ */
+[[nodiscard]]
+anyptr pool_alloc_layout(pool_t *self, layout_t layout);
+
+/**
+ * @brief Allocate an object (shorthand).
+ */
+[[nodiscard]]
+anyptr pool_alloc(pool_t *self, usize size, usize align);
+
+/**
+ * @brief Return an object to its size class.
+ * @note `layout` must be the one used for allocation.
+ */
+void pool_free(pool_t *self, anyptr ptr, layout_t layout);
+
+/**
+ * @brief Resize an object.
+ * @note Returns `ptr` unchanged if both sizes map to the same size class.
+ */
+[[nodiscard]]
+anyptr pool_realloc(pool_t *self, anyptr ptr, layout_t old_layout,
+		    layout_t new_layout);
+
+/**
+ * @brief Get the number of slabs currently held.
+ */
+static inline usize pool_slab_count(const pool_t *self)
+{
+	return self->slab_count;
+}
+
+/*
+ * ==========================================================================
+ * 5. Allocer Interface (VTable Adapter)
+ * ==========================================================================
+ */
+
+/**
+ * @brief Convert the pool into a generic `allocer_t`.
+ */
+allocer_t pool_allocer(pool_t *self);
+
+/*
+ * ==========================================================================
+ * 6. Helper Macros (Type-Safe Syntax Sugar)
+ * ==========================================================================
+ */
+
+#define pool_alloc_type(pool, T) (T *)pool_alloc_layout(pool, layout_of(T))
+
+#define pool_free_type(pool, ptr) \
+	pool_free(pool, ptr, layout_of(typeof(*(ptr))))
@@ -27,12 +27,23 @@
  * - Thread Safe: Yes (relies on C runtime lock).
  * - Alignment: Fully supported (using platform specific aligned allocs).
  * - State: Stateless (self is NULL).
+ *
+ * ### Realloc
+ * - Default alignment (`<= alignof(max_align_t)`): plain `realloc`, which
+ * can grow in place.
+ * - Huge blocks (>= 64 MiB, Linux): each gets its own mapping and is resized
+ * with `mremap`, so growing a multi-hundred-MB `vec` moves page table
+ * entries instead of bytes.
+ * - Otherwise: alloc + copy + free.
+ *
+ * @note Since mapped blocks are recognized by their size, `allocer_free` and
+ * `allocer_realloc` must be given the exact layout used to allocate.
  */
 
 /**
  * @brief Get the global system allocator.
  * * @note This allocator calls OS/Libc primitives directly.
  * On Windows: _aligned_malloc / _aligned_free
- * On POSIX: posix_memalign / free
+ * On POSIX: malloc / posix_memalign / realloc / free (+ mmap / mremap on Linux)
  */
 allocer_t allocer_system(void);
@@ -0,0 +1,182 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <core/mem/layout.h>
+#include <core/mem/allocer.h>
+#include <core/type.h>
+
+/*
+ * ==========================================================================
+ * 1. Internal Structures
+ * ==========================================================================
+ * Two-Level Segregated Fit (TLSF, Masmano et al.)
+ *
+ * Free blocks are kept in FL x SL segregated lists:
+ * - First level (FL): power-of-two size ranges.
+ * - Second level (SL): each range split linearly into 2^TLSF_SL_LOG2 lists.
+ * Two bitmaps plus `ctz` find a suitable list in O(1), so alloc, free and
+ * realloc all have a bounded worst-case latency.
+ */
+
+#define TLSF_ALIGN 16 /// payload alignment (and size granularity)
+#define TLSF_SL_LOG2 5
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT 9 /// TLSF_SL_LOG2 + log2(TLSF_ALIGN)
+#define TLSF_FL_MAX_LOG2 40 /// largest block class: 1 TiB
+#define TLSF_FL_COUNT (TLSF_FL_MAX_LOG2 - TLSF_FL_SHIFT + 1)
+
+/**
+ * @brief Block header (boundary tag).
+ *
+ * Memory Layout:
+ * [ prev_phys | size+flags ][ payload ........................ ]
+ * ^                         ^
+ * block                     user pointer (block + 16)
+ *
+ * `next_free` / `prev_free` overlay the payload and are only valid while the
+ * block is free. The two low bits of `size` hold the FREE / PREV_FREE flags.
+ */
+typedef struct TlsfBlock {
+	struct TlsfBlock *prev_phys;
+	usize size;
+	struct TlsfBlock *next_free;
+	struct TlsfBlock *prev_free;
+} tlsf_block_t;
+
+/**
+ * @brief A region obtained from the backing allocator.
+ * Blocks never coalesce across regions (each ends in a used sentinel).
+ */
+typedef struct TlsfRegion {
+	struct TlsfRegion *next;
+	usize size;
+} tlsf_region_t;
+
+/*
+ * ==========================================================================
+ * 2. The TLSF Type
+ * ==========================================================================
+ */
+
+/**
+ * @brief General-purpose O(1) allocator with real free and in-place realloc.
+ *
+ * Sits between `bump_t` (no free) and `allocer_system()` (libc on every call):
+ * memory is taken from the backing allocator in large regions and managed
+ * with bounded latency, which suits long-running services.
+ *
+ * - Thread Safe: No.
+ */
+typedef struct Tlsf {
+	u64 fl_bitmap;
+	u32 sl_bitmap[TLSF_FL_COUNT];
+	tlsf_block_t *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+
+	tlsf_region_t *regions;
+	allocer_t backing;
+	usize region_size; /// minimum bytes requested per region
+	usize region_count;
+} tlsf_t;
+
+/*
+ * ==========================================================================
+ * 3. Lifecycle API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Initialize a TLSF allocator.
+ *
+ * @param backing     Where regions come from.
+ * @param region_size Minimum bytes per region (0 = default, 1 MiB), capped
+ * at 2^TLSF_FL_MAX_LOG2. Larger requests get a region of their own.
+ * @note Lazy: no region is allocated until the first request.
+ */
+void tlsf_init(tlsf_t *self, allocer_t backing, usize region_size);
+
+/**
+ * @brief Free every region back to the backing allocator.
+ */
+void tlsf_deinit(tlsf_t *self);
+
+/**
+ * @brief Allocate a new TLSF allocator on the heap (using the backing allocator).
+ */
+tlsf_t *tlsf_new(allocer_t backing, usize region_size);
+
+/**
+ * @brief Destroy the allocator and free the `tlsf_t` structure.
+ */
+void tlsf_drop(tlsf_t *self);
+
+/*
+ * ==========================================================================
+ * 4. Allocation API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Allocate memory. O(1).
+ * @return nullptr on OOM.
+ */
+[[nodiscard]]
+anyptr tlsf_alloc_layout(tlsf_t *self, layout_t layout);
+
+/**
+ * @brief Allocate memory (shorthand).
+ */
+[[nodiscard]]
+anyptr tlsf_alloc(tlsf_t *self, usize size, usize align);
+
+/**
+ * @brief Free memory. O(1), coalesces with free neighbours.
+ * @note No layout needed: the block header records the size.
+ */
+void tlsf_free(tlsf_t *self, anyptr ptr);
+
+/**
+ * @brief Resize memory. O(1).
+ *
+ * Shrinks in place, and grows in place by absorbing the following block when
+ * it is free and large enough. Only falls back to alloc + copy + free when
+ * the neighbour is in use.
+ */
+[[nodiscard]]
+anyptr tlsf_realloc(tlsf_t *self, anyptr ptr, usize new_size, usize align);
+
+/**
+ * @brief Usable size of an allocated block (>= requested size).
+ */
+usize tlsf_block_size(anyptr ptr);
+
+/**
+ * @brief Walk every region and verify the heap invariants.
+ * @return true if consistent. Intended for tests and debugging (O(n)).
+ */
+bool tlsf_check(const tlsf_t *self);
+
+/*
+ * ==========================================================================
+ * 5. Allocer Interface (VTable Adapter)
+ * ==========================================================================
+ */
+
+/**
+ * @brief Convert the allocator into a generic `allocer_t`.
+ */
+allocer_t tlsf_allocer(tlsf_t *self);
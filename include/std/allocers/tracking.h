@@ -0,0 +1,155 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <core/mem/layout.h>
+#include <core/mem/allocer.h>
+#include <core/type.h>
+#include <stdio.h> /// for FILE
+
+/*
+ * ==========================================================================
+ * Tracking Allocator (Decorator)
+ * ==========================================================================
+ * Wraps any backing allocator and records what goes through it:
+ * - alloc / free / realloc counts and failures,
+ * - live, peak and total bytes,
+ * - a power-of-two size histogram,
+ * - per call site totals (see "Call-Site Attribution" in core/mem/allocer.h).
+ *
+ * ```c
+ * tracking_t tr;
+ * tracking_init(&tr, allocer_system());
+ * map_init(m, tracking_allocer(&tr), MAP_OPS_U64);
+ * ...
+ * tracking_report(&tr, stderr);
+ * ```
+ *
+ * Every block carries a small header recording its call site, so frees and
+ * reallocs are charged to the site that allocated the block.
+ *
+ * - Thread Safe: Yes (statistics are guarded by a spin lock).
+ */
+
+/// histogram bucket `i` counts requests of (2^(i-1), 2^i] bytes
+#define TRACKING_HIST_BUCKETS 32
+/// distinct call sites recorded (power of 2); the rest go to "unknown"
+#define TRACKING_MAX_SITES 256
+
+/**
+ * @brief Totals for one call site.
+ */
+typedef struct TrackingSite {
+	alloc_site_t site;
+	bool used;
+	usize allocs;
+	usize frees;
+	usize live_bytes;
+	usize peak_bytes;
+	usize total_bytes;
+} tracking_site_t;
+
+/**
+ * @brief Global totals.
+ */
+typedef struct TrackingStats {
+	usize allocs;
+	usize frees;
+	usize reallocs;
+	usize failures; /// requests the backing allocator refused
+	usize live_bytes;
+	usize peak_bytes;
+	usize total_bytes; /// cumulative bytes requested
+	usize histogram[TRACKING_HIST_BUCKETS];
+} tracking_stats_t;
+
+typedef struct Tracking {
+	allocer_t backing;
+	tracking_stats_t stats;
+	tracking_site_t sites[TRACKING_MAX_SITES];
+	usize site_count;
+	u32 lock;
+} tracking_t;
+
+/*
+ * ==========================================================================
+ * Lifecycle API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Initialize a tracking wrapper around `backing`.
+ */
+void tracking_init(tracking_t *self, allocer_t backing);
+
+/**
+ * @brief Clear every counter and call site.
+ * @note Only call while no block from this wrapper is live.
+ */
+void tracking_reset(tracking_t *self);
+
+/**
+ * @brief Allocate a new tracking wrapper on the heap (using the backing allocator).
+ */
+tracking_t *tracking_new(allocer_t backing);
+
+/**
+ * @brief Free the `tracking_t` structure.
+ */
+void tracking_drop(tracking_t *self);
+
+/*
+ * ==========================================================================
+ * Inspection API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Get a consistent snapshot of the global totals.
+ */
+tracking_stats_t tracking_stats(tracking_t *self);
+
+/**
+ * @brief Get a snapshot of the totals for one call site.
+ * @return false if the site has never allocated.
+ */
+bool tracking_site(tracking_t *self, const char *file, u32 line,
+		   tracking_site_t *out);
+
+/**
+ * @brief Write a human readable report (sites sorted by live bytes).
+ * @note The sites are sorted in a buffer borrowed from the backing
+ * allocator; if it cannot be had, the report leaves them out.
+ */
+void tracking_report(tracking_t *self, FILE *out);
+
+/**
+ * @brief Write a JSON snapshot of all totals, the histogram and the sites.
+ * @note Same buffer as `tracking_report`: `sites` may come out empty.
+ */
+void tracking_dump_json(tracking_t *self, FILE *out);
+
+/*
+ * ==========================================================================
+ * Allocer Interface (VTable Adapter)
+ * ==========================================================================
+ */
+
+/**
+ * @brief Convert the wrapper into a generic `allocer_t`.
+ */
+allocer_t tracking_allocer(tracking_t *self);
@@ -0,0 +1,179 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <core/mem/layout.h>
+#include <core/mem/allocer.h>
+#include <core/type.h>
+
+/*
+ * ==========================================================================
+ * Virtual Memory Arena
+ * ==========================================================================
+ * An arena that reserves one large virtual range up front and commits pages
+ * on demand as the bump pointer advances.
+ *
+ * Memory Layout:
+ * [--- used ---][-- committed --][------------ reserved ------------]
+ * ^             ^               ^                                   ^
+ * base          ptr             committed                         end
+ *
+ * ### Why?
+ * - **Contiguous**: There is no chunk chaining (unlike `bump_t`), the arena is
+ * a single block of address space.
+ * - **Stable bases**: The bump pointer grows UP, so the most recent
+ * allocation can always be extended in place. A `vec`/`string_t` that keeps
+ * growing at the tip never moves its base pointer.
+ * - **Cheap**: Reserved-but-uncommitted pages cost no physical memory.
+ *
+ * - Thread Safe: No.
+ * - Platform: `mmap`/`mprotect`/`madvise` on POSIX,
+ * `VirtualAlloc`/`VirtualFree` on Windows.
+ */
+
+/// Options for `vmem_init`.
+#define VMEM_DEFAULT 0u
+/// Ask the kernel to back the range with transparent huge pages
+/// (`MADV_HUGEPAGE`, Linux only; ignored elsewhere).
+#define VMEM_HUGEPAGES (1u << 0)
+
+typedef struct VmemArena {
+	u8 *base; /// start of the reserved range
+	u8 *ptr; /// bump pointer (grows up)
+	u8 *committed; /// end of the committed (read/write) pages
+	u8 *end; /// end of the reserved range
+
+	usize page_size;
+	usize commit_step; /// minimum bytes committed at once
+	usize map_size; /// bytes actually mapped (may include alignment slack)
+	u8 *map_base; /// address actually mapped
+} vmem_t;
+
+/*
+ * ==========================================================================
+ * Lifecycle API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Reserve a virtual range for the arena. Nothing is committed yet.
+ *
+ * @param self    Pointer to the uninitialized vmem_t structure.
+ * @param reserve Size of the address range to reserve (rounded up to pages).
+ * Reserve generously (e.g., several GiB on 64-bit): it costs no memory.
+ * @param flags   `VMEM_DEFAULT` or `VMEM_HUGEPAGES`.
+ * @return true on success, false if the reservation failed.
+ */
+[[nodiscard]]
+bool vmem_init(vmem_t *self, usize reserve, u32 flags);
+
+/**
+ * @brief Release the whole reserved range.
+ */
+void vmem_deinit(vmem_t *self);
+
+/**
+ * @brief Reset the arena, keeping committed pages for reuse.
+ */
+void vmem_reset(vmem_t *self);
+
+/**
+ * @brief Decommit pages above the bump pointer.
+ *
+ * Pages are released with `MADV_DONTNEED` (the kernel takes them back) and
+ * made inaccessible again. Typically called after `vmem_reset`.
+ *
+ * @param keep Bytes (from `base`) to keep committed, even if unused.
+ */
+void vmem_trim(vmem_t *self, usize keep);
+
+/*
+ * ==========================================================================
+ * Allocation API
+ * ==========================================================================
+ */
+
+/**
+ * @brief Allocate raw memory from the arena.
+ * @return nullptr if the reservation is exhausted or the commit failed.
+ */
+[[nodiscard]]
+anyptr vmem_alloc_layout(vmem_t *self, layout_t layout);
+
+/**
+ * @brief Allocate raw memory (shorthand).
+ */
+[[nodiscard]]
+anyptr vmem_alloc(vmem_t *self, usize size, usize align);
+
+/**
+ * @brief Resize a memory block.
+ *
+ * If `old_ptr` is the most recent allocation it is resized in place (the
+ * address never changes). Otherwise it allocates new memory and copies data.
+ */
+[[nodiscard]]
+anyptr vmem_realloc(vmem_t *self, anyptr old_ptr, usize old_size,
+		    usize new_size, usize align);
+
+/**
+ * @brief Free a block.
+ * @note Only the most recent allocation is actually reclaimed; freeing
+ * anything else is a no-op until `vmem_reset`.
+ */
+void vmem_free(vmem_t *self, anyptr ptr, usize size);
+
+/*
+ * ==========================================================================
+ * Inspection
+ * ==========================================================================
+ */
+
+/**
+ * @brief Bytes currently handed out (including alignment padding).
+ */
+static inline usize vmem_used(const vmem_t *self)
+{
+	return (usize)(self->ptr - self->base);
+}
+
+/**
+ * @brief Bytes currently committed (backed by read/write pages).
+ */
+static inline usize vmem_committed(const vmem_t *self)
+{
+	return (usize)(self->committed - self->base);
+}
+
+/**
+ * @brief Size of the reserved range.
+ */
+static inline usize vmem_reserved(const vmem_t *self)
+{
+	return (usize)(self->end - self->base);
+}
+
+/*
+ * ==========================================================================
+ * Allocer Interface (VTable Adapter)
+ * ==========================================================================
+ */
+
+/**
+ * @brief Convert the arena into a generic `allocer_t`.
+ */
+allocer_t vmem_allocer(vmem_t *self);
@@ -0,0 +1,182 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <std/map.h> /// for map_ops_t, the MAP_OPS_* tables and the shards
+#include <stdalign.h> /// for alignas
+
+/*
+ * ==========================================================================
+ * Concurrent Sharded Map
+ * ==========================================================================
+ * A map that many threads can use at once. Keys are spread over a power of
+ * two number of shards, each a plain `map` behind its own reader-writer
+ * spinlock. The shard is picked from the hash bits right below H2 (the top
+ * 7 bits `map` keeps in its control bytes), so the bits a shard uses for
+ * its slots stay independent of the shard choice. Each key is hashed once.
+ *
+ * Shard Layout (one cache line apart, no false sharing between locks):
+ * [ lock | map ][ lock | map ][ lock | map ] ... [ lock | map ]
+ *
+ * ### Why?
+ * - **Lock striping**: writers only block the 1/N of the keys in their shard.
+ * - **Shared reads**: lookups take the shard lock in shared mode, so a
+ * read-mostly table (a global symbol table) scales with the reader count.
+ *
+ * ### Rules
+ * - Values are copied in and out under the lock: there is no `cmap_get`
+ * returning a pointer, since another thread may move the entry right after.
+ * - The allocator must be thread safe (e.g. `allocer_system()`): shards
+ * grow concurrently.
+ * - `cmap_init`/`cmap_deinit` are not thread safe.
+ */
+
+/// default shard count: enough to keep 32 writers mostly apart
+#define CMAP_DEFAULT_SHARDS 64
+
+/// one shard (Internal): a map behind a reader-writer spinlock
+typedef struct {
+	alignas(64) u32 lock; /// writer bit | reader count
+	map(u8, u8) map; /// untyped: sizes are cached in the header
+} _cmap_shard_t;
+
+#define cmap(K, V)                                                        \
+	struct {                                                          \
+		_cmap_shard_t *shards;                                    \
+		usize shard_count; /* Power of two */                     \
+		u32 shard_shift; /* hash >> shift picks the shard */      \
+		allocer_t alc;                                            \
+		map_ops_t ops;                                            \
+		K *_key_type; /* Always null: carries K for the macros */ \
+		V *_val_type; /* Always null: carries V for the macros */ \
+	}
+
+#define defCmap(K, V, Name) typedef cmap(K, V) Name
+
+/*
+ * ==========================================================================
+ * Public Interface
+ * ==========================================================================
+ */
+
+/**
+ * @brief Initialize a concurrent map with `CMAP_DEFAULT_SHARDS` shards.
+ * @param m The map variable.
+ * @param allocator Thread-safe backing allocator.
+ * @param ops_vtable Operations for Key (hash/eq), e.g. `MAP_OPS_U64`.
+ * @return true on success, false on OOM.
+ */
+#define cmap_init(m, allocator, ops_vtable)                             \
+	cmap_init_shards(m, allocator, ops_vtable, CMAP_DEFAULT_SHARDS)
+
+/**
+ * @brief Initialize a concurrent map with `shards` shards.
+ * @param shards Rounded up to a power of two (1 is a single global lock).
+ */
+#define cmap_init_shards(m, allocator, ops_vtable, shards)               \
+	_cmap_init_impl((anyptr) & (m), allocator, ops_vtable, (shards), \
+			sizeof(*(m)._key_type), sizeof(*(m)._val_type))
+
+/**
+ * @brief Free every shard. No other thread may use the map any more.
+ */
+#define cmap_deinit(m) _cmap_deinit_impl((anyptr) & (m))
+
+/**
+ * @brief Insert or update a value.
+ * @return true on success, false on OOM.
+ */
+#define cmap_put(m, key, val)                             \
+	({                                                \
+		typeof(*(m)._key_type) _k = (key);        \
+		typeof(*(m)._val_type) _v = (val);        \
+		_cmap_put_impl((anyptr) & (m), &_k, &_v); \
+	})
+
+/**
+ * @brief Copy the value of a key into `*out`.
+ * @param out `V *`, may be nullptr (membership test only).
+ * @return true if the key was found.
+ */
+#define cmap_get(m, key, out)                                         \
+	({                                                            \
+		typeof(*(m)._key_type) _k_lookup = (key);             \
+		typeof((m)._val_type) _out_get = (out);               \
+		_cmap_get_impl((anyptr) & (m), &_k_lookup, _out_get); \
+	})
+
+#define cmap_contains(m, key) cmap_get(m, key, nullptr)
+
+/**
+ * @brief Insert `val` unless the key is present, atomically.
+ *
+ * Either way `*out` receives the value now stored for the key, so racing
+ * threads all agree on the winner (e.g. one symbol id per name).
+ *
+ * @param out `V *`, may be nullptr.
+ * @param inserted Optional `bool *`, set to true if `val` was inserted.
+ * @return true on success, false on OOM.
+ */
+#define cmap_get_or_put(m, key, val, out, inserted)                     \
+	({                                                              \
+		typeof(*(m)._key_type) _k_gop = (key);                  \
+		typeof(*(m)._val_type) _v_gop = (val);                  \
+		typeof((m)._val_type) _out_gop = (out);                 \
+		_cmap_get_or_put_impl((anyptr) & (m), &_k_gop, &_v_gop, \
+				      _out_gop, (inserted));            \
+	})
+
+/**
+ * @brief Remove a key.
+ * @return true if key existed and was removed.
+ */
+#define cmap_remove(m, key)                                 \
+	({                                                  \
+		typeof(*(m)._key_type) _k_del = (key);      \
+		_cmap_remove_impl((anyptr) & (m), &_k_del); \
+	})
+
+/**
+ * @brief Clear all entries (keeps capacity). Shards are cleared one by one.
+ */
+#define cmap_clear(m) _cmap_clear_impl((anyptr) & (m))
+
+/**
+ * @brief Number of entries.
+ * @note Shards are counted one by one: with concurrent writers the result
+ * is only a snapshot.
+ */
+#define cmap_len(m) _cmap_len_impl((anyptr) & (m))
+
+/*
+ * ==========================================================================
+ * Internals
+ * ==========================================================================
+ */
+
+[[nodiscard]] bool _cmap_init_impl(anyptr map, allocer_t alc, map_ops_t ops,
+				   usize shards, usize k_sz, usize v_sz);
+void _cmap_deinit_impl(anyptr map);
+[[nodiscard]] bool _cmap_put_impl(anyptr map, const void *k_ptr,
+				  const void *v_ptr);
+bool _cmap_get_impl(anyptr map, const void *k_ptr, void *out);
+[[nodiscard]] bool _cmap_get_or_put_impl(anyptr map, const void *k_ptr,
+					 const void *v_ptr, void *out,
+					 bool *inserted);
+bool _cmap_remove_impl(anyptr map, const void *k_ptr);
+void _cmap_clear_impl(anyptr map);
+usize _cmap_len_impl(anyptr map);
@@ -18,6 +18,7 @@
 
 #include <core/type.h>
 #include <core/macros.h>
+#include <core/hash.h>
 #include <std/strings/string.h>
 #include <std/strings/str.h>
 
@@ -91,3 +92,31 @@ bool fs_is_file(const char *path);
  * @return true on success.
  */
 [[nodiscard]] bool file_append(const char *path, str_t content);
+
+/*
+ * ==========================================================================
+ * Content Fingerprints
+ * ==========================================================================
+ */
+
+/**
+ * @brief 128-bit fingerprint of a file's contents (see `hash128_bytes`).
+ *
+ * @param path Path to the file.
+ * @param out  Receives the fingerprint; equal to `hash128_bytes` over the
+ * file's bytes.
+ * @return true on success, false if the file cannot be opened or read.
+ *
+ * @note
+ * 1. Regular files are mapped read-only and hashed in place: nothing is
+ * copied into a `string_t`, so multi-GB inputs cost no heap memory.
+ * 2. Anything that cannot be mapped (pipes, `/proc` files, Windows) is
+ * streamed through a fixed 16 KiB stack buffer instead.
+ *
+ * @warning The mapping is not protected against concurrent truncation: if
+ * another process shrinks the file during the call, the process receives
+ * SIGBUS. Only fingerprint files nobody else is truncating (build inputs,
+ * cache entries); for files that may change underneath, read them with
+ * `file_read_to_string` and use `hash128_bytes` instead.
+ */
+[[nodiscard]] bool file_fingerprint(const char *path, hash128_t *out);
@@ -0,0 +1,202 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <std/map.h> /// for map_ops_t and the MAP_OPS_* tables
+#include <std/vec.h>
+#include <stddef.h> /// for offsetof
+
+/*
+ * ==========================================================================
+ * Insertion-Ordered Index Map
+ * ==========================================================================
+ * A hash map whose entries live densely in a `vec`, in insertion order. The
+ * hash table only holds u32 positions into that vec (plus the usual control
+ * bytes, see `std/map/group.h`).
+ *
+ * Memory Layout:
+ * ctrl:    [h2][--][h2][h2][--][--][h2][--] ...
+ * slots:   [ 2][  ][ 0][ 3][  ][  ][ 1][  ] ...
+ *             \_______|___|___________|
+ * entries: [{hash,k,v} 0][1][2][3]          (len, no holes)
+ *
+ * ### Why?
+ * - **Iteration**: `indexmap_foreach` walks `len` contiguous entries, never
+ * the sparse table, and always in insertion order (deterministic output).
+ * - **Positions**: every entry has a stable index in `[0, len)` until a
+ * removal, so it can be addressed by index as well as by key.
+ * - **Small table**: a slot is 1 control byte + 4 bytes, whatever K and V.
+ *
+ * Removal is `indexmap_swap_remove`: the last entry moves into the hole, so
+ * it is O(1) but does not preserve the order of the moved entry.
+ *
+ * - Thread Safe: No.
+ */
+
+#define indexmap(K, V)                                                         \
+	struct {                                                               \
+		vec(struct {                                                   \
+			u64 hash; /* Full hash of key (read only) */           \
+			K key;                                                 \
+			V val;                                                 \
+		}) entries;                                                    \
+		u8 *ctrl; /* Control bytes: H2, EMPTY or TOMB */               \
+		u32 *slots; /* Entry index per FULL slot */                    \
+		usize cap; /* Table slots (power of two) */                    \
+		usize occupied; /* len + tombstones (for load factor check) */ \
+		map_ops_t ops;                                                 \
+		usize entry_size; /* Cached for void* impl */                  \
+		usize entry_align;                                             \
+		usize key_off;                                                 \
+		usize key_size;                                                \
+		usize val_off;                                                 \
+		usize val_size;                                                \
+	}
+
+#define defIndexmap(K, V, Name) typedef indexmap(K, V) Name
+
+/// entry type of an index map (Internal)
+#define _indexmap_entry_t(m) typeof(*(m).entries.data)
+
+/*
+ * ==========================================================================
+ * Public Interface
+ * ==========================================================================
+ */
+
+/**
+ * @brief Initialize an index map.
+ * @param m The map variable.
+ * @param allocator Backing allocator (entries and table).
+ * @param ops_vtable Operations for Key (hash/eq), e.g. `MAP_OPS_U64`.
+ */
+#define indexmap_init(m, allocator, ops_vtable)                    \
+	_indexmap_init_impl((anyptr) & (m), allocator, ops_vtable, \
+			    sizeof(_indexmap_entry_t(m)),          \
+			    alignof(_indexmap_entry_t(m)),         \
+			    offsetof(_indexmap_entry_t(m), key),   \
+			    sizeof((m).entries.data->key),         \
+			    offsetof(_indexmap_entry_t(m), val),   \
+			    sizeof((m).entries.data->val))
+
+/**
+ * @brief Free the entries and the table.
+ */
+#define indexmap_deinit(m) _indexmap_deinit_impl((anyptr) & (m))
+
+/**
+ * @brief Reserve room for at least `n` more entries (no growth until then).
+ * @return true on success, false on OOM.
+ */
+#define indexmap_reserve(m, n) _indexmap_reserve_impl((anyptr) & (m), (n))
+
+/**
+ * @brief Insert or update a value.
+ *
+ * A new key is appended after every other entry. Updating an existing key
+ * keeps its position.
+ *
+ * @return true on success, false on OOM (or past 2^32 - 1 entries).
+ */
+#define indexmap_put(m, k, v)                                 \
+	({                                                    \
+		typeof((m).entries.data->key) _k = (k);       \
+		typeof((m).entries.data->val) _v = (v);       \
+		_indexmap_put_impl((anyptr) & (m), &_k, &_v); \
+	})
+
+/**
+ * @brief Get a pointer to the value.
+ * @return Pointer to value, or nullptr if not found.
+ * @note The pointer is invalidated by the next put or remove.
+ */
+#define indexmap_get(m, k)                                          \
+	({                                                          \
+		typeof((m).entries.data->key) _k_lookup = (k);      \
+		(typeof(&(m).entries.data->val))_indexmap_get_impl( \
+			(anyptr) & (m), &_k_lookup);                \
+	})
+
+/**
+ * @brief Position of a key in insertion order.
+ * @return Index in `[0, len)`, or `(usize)-1` if not found.
+ */
+#define indexmap_index_of(m, k)                                     \
+	({                                                          \
+		typeof((m).entries.data->key) _k_index = (k);       \
+		_indexmap_index_of_impl((anyptr) & (m), &_k_index); \
+	})
+
+/**
+ * @brief Remove a key, moving the last entry into its place.
+ * @return true if key existed and was removed.
+ */
+#define indexmap_swap_remove(m, k)                                   \
+	({                                                           \
+		typeof((m).entries.data->key) _k_del = (k);          \
+		_indexmap_swap_remove_impl((anyptr) & (m), &_k_del); \
+	})
+
+/**
+ * @brief Clear all entries (keeps capacity).
+ */
+#define indexmap_clear(m) _indexmap_clear_impl((anyptr) & (m))
+
+/* --- Utilities --- */
+#define indexmap_len(m) ((m).entries.len)
+#define indexmap_is_empty(m) ((m).entries.len == 0)
+
+/**
+ * @brief Entry at position `i` (`->key`, `->val`), bounds checked.
+ * @panic Panics if index is out of bounds.
+ */
+#define indexmap_at(m, i)                                                     \
+	({                                                                    \
+		usize _im_idx = (i);                                          \
+		if (unlikely(_im_idx >= (m).entries.len)) {                   \
+			log_panic("indexmap index out of bounds: %zu >= %zu", \
+				  _im_idx, (m).entries.len);                  \
+		}                                                             \
+		&(m).entries.data[_im_idx];                                   \
+	})
+
+/**
+ * @brief Iterate over the entries in insertion order.
+ * @param it Iterator name (pointer to entry: `it->key`, `it->val`).
+ * @note Do not put or remove while iterating.
+ */
+#define indexmap_foreach(it, m) vec_foreach(it, (m).entries)
+
+/*
+ * ==========================================================================
+ * Internals
+ * ==========================================================================
+ */
+
+[[nodiscard]] bool _indexmap_init_impl(anyptr map, allocer_t alc,
+				       map_ops_t ops, usize entry_size,
+				       usize entry_align, usize key_off,
+				       usize key_size, usize val_off,
+				       usize val_size);
+void _indexmap_deinit_impl(anyptr map);
+[[nodiscard]] bool _indexmap_reserve_impl(anyptr map, usize additional);
+[[nodiscard]] bool _indexmap_put_impl(anyptr map, const void *k_ptr,
+				      const void *v_ptr);
+void *_indexmap_get_impl(anyptr map, const void *k_ptr);
+usize _indexmap_index_of_impl(anyptr map, const void *k_ptr);
+bool _indexmap_swap_remove_impl(anyptr map, const void *k_ptr);
+void _indexmap_clear_impl(anyptr map);
@@ -35,6 +35,14 @@ typedef struct {
 
 	/** Equality function: returns true if two keys are equal. */
 	bool (*equals)(const void *key_lhs, const void *key_rhs);
+
+	/**
+	 * Store 32 hash bits per slot (4 extra bytes each). Resizes then never
+	 * hash or read keys again, and `equals` only runs when the stored
+	 * bits match. Worth it for keys that are costly to hash or compare
+	 * (strings); not for plain integers.
+	 */
+	bool cache_hashes;
 } map_ops_t;
 
 /* --- Pre-defined Operations --- */
@@ -53,7 +61,7 @@ extern const map_ops_t MAP_OPS_USIZE; /// Typically matches pointers
 extern const map_ops_t MAP_OPS_PTR;
 
 /**
- * Ops for C-strings (const char*). Hashes the content.
+ * Ops for C-strings (const char*). Hashes the content, caches hashes.
  */
 extern const map_ops_t MAP_OPS_CSTR;
 
@@ -63,16 +71,26 @@ extern const map_ops_t MAP_OPS_CSTR;
  * ==========================================================================
  */
 
-/// Control byte states (Internal)
-#define _MAP_EMPTY 0
-#define _MAP_FULL 1
-#define _MAP_TOMB 2
+/**
+ * Control bytes (Internal), one per slot, SwissTable style:
+ * - FULL slots store H2, the top 7 bits of the key's hash (0x00..0x7F).
+ * - EMPTY and TOMB have the high bit set.
+ *
+ * Lookups scan `_MAP_GROUP` control bytes at once (SSE2/NEON, or SWAR as a
+ * fallback) and only call `ops.equals` on slots whose H2 matches. The array
+ * holds `cap + _MAP_GROUP` bytes: the tail mirrors the first group so a
+ * group load never has to wrap around.
+ */
+#define _MAP_EMPTY 0xFF
+#define _MAP_TOMB 0x80
+#define _MAP_GROUP 16
 
 #define map(K, V)                                                              \
 	struct {                                                               \
 		K *keys;                                                       \
 		V *vals;                                                       \
-		u8 *states; /* Metadata: 0=Empty, 1=Full, 2=Deleted */         \
+		u8 *states; /* Control bytes: H2, EMPTY or TOMB */             \
+		u32 *hashes; /* Cached hash bits (ops.cache_hashes) */         \
 		usize len;                                                     \
 		usize cap;                                                     \
 		usize occupied; /* len + tombstones (for load factor check) */ \
@@ -80,6 +98,8 @@ extern const map_ops_t MAP_OPS_CSTR;
 		map_ops_t ops;                                                 \
 		usize key_size; /* Cached for void* impl */                    \
 		usize val_size; /* Cached for void* impl */                    \
+		void *old; /* Table being drained (incremental resize) */      \
+		bool incremental;                                              \
 	}
 
 #define defMap(K, V, Name) typedef map(K, V) Name
@@ -98,7 +118,25 @@ extern const map_ops_t MAP_OPS_CSTR;
  */
 #define map_init(m, allocator, ops_vtable)                    \
 	_map_init_impl((anyptr) & (m), allocator, ops_vtable, \
-		       sizeof(*(m).keys), sizeof(*(m).vals))
+		       sizeof(*(m).keys), sizeof(*(m).vals), false)
+
+/**
+ * @brief Initialize a map that grows incrementally.
+ *
+ * A normal map rehashes every entry at once when it grows: one put stalls
+ * for the whole table. This one keeps the previous arrays aside and moves a
+ * few slots over on every `map_put`/`map_get`/`map_remove`/`map_entry`, so
+ * no single call does more than a bounded amount of work. Lookups that
+ * miss the new arrays fall back to the old ones while a migration runs,
+ * and move the entry they find over, so returned pointers always point
+ * into the current arrays.
+ *
+ * @note Since lookups migrate entries too, a value pointer returned by any
+ * map call is only valid until the next map call (not just the next put).
+ */
+#define map_init_incremental(m, allocator, ops_vtable)        \
+	_map_init_impl((anyptr) & (m), allocator, ops_vtable, \
+		       sizeof(*(m).keys), sizeof(*(m).vals), true)
 
 /**
  * @brief Free map memory.
@@ -130,6 +168,53 @@ extern const map_ops_t MAP_OPS_CSTR;
 		(typeof((m).vals))_map_get_impl((anyptr) & (m), &_k_lookup); \
 	})
 
+/**
+ * @brief Find or insert a key with a single hash and probe.
+ *
+ * If the key is absent it is inserted with a zero-filled value. Either way
+ * the value slot is returned for the caller to read or fill in place.
+ *
+ * @param inserted Optional `bool *`, set to true if the key was inserted.
+ * @return Pointer to value, or nullptr on OOM.
+ *
+ * @example
+ * (*map_entry(counts, word, nullptr))++;
+ */
+#define map_entry(m, key, inserted)                                          \
+	({                                                                   \
+		typeof((m).keys[0]) _k_entry = (key);                        \
+		(typeof((m).vals))_map_entry_impl((anyptr) & (m), &_k_entry, \
+						  (inserted));               \
+	})
+
+/**
+ * @brief Get the value of a key, inserting `init` first if it is absent.
+ *
+ * `init` is only evaluated when the key is inserted, so it may be costly
+ * (an allocation, a call that builds the value).
+ *
+ * @return Pointer to value, or nullptr on OOM.
+ */
+#define map_get_or_insert_with(m, key, init)                              \
+	({                                                                \
+		bool _ins_with;                                           \
+		typeof((m).vals) _v_with = map_entry(m, key, &_ins_with); \
+		if (_v_with && _ins_with)                                 \
+			*_v_with = (init);                                \
+		_v_with;                                                  \
+	})
+
+/**
+ * @brief Pointer to the key stored next to a value returned by `map_get` or
+ * `map_entry`.
+ *
+ * The stored key may be overwritten with an *equal* key, e.g. to swap a
+ * borrowed string for an owned copy right after `map_entry` inserted it.
+ * Also valid on incremental maps mid-migration: lookups never return a
+ * pointer into the table being drained.
+ */
+#define map_key_at(m, val_ptr) (&(m).keys[(val_ptr) - (m).vals])
+
 /**
  * @brief Remove a key.
  * @return true if key existed and was removed.
@@ -148,6 +233,8 @@ extern const map_ops_t MAP_OPS_CSTR;
 /* --- Utilities --- */
 #define map_len(m) ((m).len)
 #define map_cap(m) ((m).cap)
+/// true while an incremental resize is still draining the old arrays
+#define map_is_migrating(m) ((m).old != nullptr)
 
 /*
  * ==========================================================================
@@ -156,10 +243,17 @@ extern const map_ops_t MAP_OPS_CSTR;
  */
 
 [[nodiscard]] bool _map_init_impl(anyptr map, allocer_t alc, map_ops_t ops,
-				  usize k_sz, usize v_sz);
+				  usize k_sz, usize v_sz, bool incremental);
 void _map_deinit_impl(anyptr map, usize k_sz, usize v_sz);
 [[nodiscard]] bool _map_put_impl(anyptr map, const void *k_ptr,
 				 const void *v_ptr);
 void *_map_get_impl(anyptr map, const void *k_ptr);
+void *_map_entry_impl(anyptr map, const void *k_ptr, bool *inserted);
 bool _map_remove_impl(anyptr map, const void *k_ptr);
 void _map_clear_impl(anyptr map);
+
+/// the same, with `hash` = `ops.hash(k_ptr)` already computed by the caller
+[[nodiscard]] bool _map_put_hashed_impl(anyptr map, const void *k_ptr,
+					const void *v_ptr, u64 hash);
+void *_map_get_hashed_impl(anyptr map, const void *k_ptr, u64 hash);
+bool _map_remove_hashed_impl(anyptr map, const void *k_ptr, u64 hash);
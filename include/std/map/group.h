@@ -0,0 +1,291 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <std/map.h> /// for _MAP_EMPTY, _MAP_TOMB, _MAP_GROUP
+#include <core/macros.h> /// for alinline, likely
+#include <core/math.h> /// for ctz64, clz64
+
+/*
+ * ==========================================================================
+ * Control Groups (Internal)
+ * ==========================================================================
+ * The probing core shared by `map`, `set`, `indexmap` and the tables
+ * generated by `defMapInline`. Each `_map_group_*` helper loads `_MAP_GROUP`
+ * control bytes starting at `ctrl` and returns a bitmask with bit `i` set
+ * when byte `i` matches. SSE2 and NEON are used when available, SWAR
+ * otherwise.
+ *
+ * H1 (the low hash bits) picks the first group, H2 (the top 7 bits) is stored
+ * in the control byte. Groups are probed triangularly (+16, +32, +48, ...),
+ * which visits every group once since `cap` is a power of two. The load
+ * factor keeps at least one EMPTY slot, so every probe terminates.
+ */
+
+#define _map_ctrl_full(c) (((c) & 0x80) == 0)
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+
+static inline u32 _map_group_match(const u8 *ctrl, u8 h2)
+{
+	__m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+	__m128i match = _mm_cmpeq_epi8(g, _mm_set1_epi8((char)h2));
+	return (u32)_mm_movemask_epi8(match);
+}
+
+static inline u32 _map_group_match_empty(const u8 *ctrl)
+{
+	return _map_group_match(ctrl, _MAP_EMPTY);
+}
+
+/// EMPTY and TOMB are exactly the bytes with the high bit set
+static inline u32 _map_group_match_free(const u8 *ctrl)
+{
+	__m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+	return (u32)_mm_movemask_epi8(g);
+}
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+/// NEON has no movemask: weight each lane by its bit and add up the halves
+static inline u32 _map_neon_movemask(uint8x16_t m)
+{
+	static const u8 weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+					1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t bits = vandq_u8(m, vld1q_u8(weights));
+	return (u32)vaddv_u8(vget_low_u8(bits)) |
+	       ((u32)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+static inline u32 _map_group_match(const u8 *ctrl, u8 h2)
+{
+	return _map_neon_movemask(vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(h2)));
+}
+
+static inline u32 _map_group_match_empty(const u8 *ctrl)
+{
+	return _map_group_match(ctrl, _MAP_EMPTY);
+}
+
+static inline u32 _map_group_match_free(const u8 *ctrl)
+{
+	int8x16_t g = vreinterpretq_s8_u8(vld1q_u8(ctrl));
+	return _map_neon_movemask(vcltzq_s8(g));
+}
+
+#else
+
+/// portable fallback: two 64-bit words per group
+#define _MAP_SWAR_LO 0x0101010101010101ull
+#define _MAP_SWAR_HI 0x8080808080808080ull
+
+static inline u64 _map_swar_load(const u8 *ctrl)
+{
+	u64 w;
+	memcpy(&w, ctrl, sizeof(w));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	w = __builtin_bswap64(w);
+#endif
+	return w;
+}
+
+/// gather the high bit of every byte into the low 8 bits
+static inline u32 _map_swar_movemask(u64 hi_bits)
+{
+	return (u32)(((hi_bits >> 7) * 0x0102040810204080ull) >> 56);
+}
+
+/// exact byte equality (no borrow false positives)
+static inline u64 _map_swar_eq(u64 w, u8 byte)
+{
+	u64 x = w ^ (_MAP_SWAR_LO * byte);
+	return ~(((x & ~_MAP_SWAR_HI) + ~_MAP_SWAR_HI) | x) & _MAP_SWAR_HI;
+}
+
+static inline u32 _map_group_match(const u8 *ctrl, u8 h2)
+{
+	u64 lo = _map_swar_eq(_map_swar_load(ctrl), h2);
+	u64 hi = _map_swar_eq(_map_swar_load(ctrl + 8), h2);
+	return _map_swar_movemask(lo) | (_map_swar_movemask(hi) << 8);
+}
+
+static inline u32 _map_group_match_empty(const u8 *ctrl)
+{
+	return _map_group_match(ctrl, _MAP_EMPTY);
+}
+
+static inline u32 _map_group_match_free(const u8 *ctrl)
+{
+	u64 lo = _map_swar_load(ctrl) & _MAP_SWAR_HI;
+	u64 hi = _map_swar_load(ctrl + 8) & _MAP_SWAR_HI;
+	return _map_swar_movemask(lo) | (_map_swar_movemask(hi) << 8);
+}
+
+#endif
+
+/*
+ * ==========================================================================
+ * Control Array Helpers
+ * ==========================================================================
+ */
+
+static inline u8 _map_h2(u64 hash)
+{
+	return (u8)(hash >> 57);
+}
+
+/// the array holds `cap + _MAP_GROUP` bytes (mirrored first group)
+static inline usize _map_ctrl_bytes(usize cap)
+{
+	return cap + _MAP_GROUP;
+}
+
+/// set a control byte, keeping the mirrored tail in sync
+static inline void _map_set_ctrl(u8 *ctrl, usize cap, usize idx, u8 c)
+{
+	ctrl[idx] = c;
+	if (idx < _MAP_GROUP)
+		ctrl[cap + idx] = c;
+}
+
+/// first EMPTY slot for `hash` in a table without tombstones (rehash)
+static inline usize _map_find_empty(const u8 *ctrl, usize cap, u64 hash)
+{
+	usize mask = cap - 1;
+	usize pos = (usize)hash & mask;
+	usize stride = 0;
+
+	for (;;) {
+		u32 empty = _map_group_match_empty(ctrl + pos);
+		if (empty)
+			return (pos + (usize)ctz64(empty)) & mask;
+		stride += _MAP_GROUP;
+		pos = (pos + stride) & mask;
+	}
+}
+
+/**
+ * Release a FULL slot. A probe only walks past a group with no EMPTY slot:
+ * if the run of non-EMPTY slots around `idx` is shorter than a group, no
+ * probe can have walked past it and the slot can become EMPTY again instead
+ * of a tombstone.
+ *
+ * @return true if the slot became EMPTY (the caller drops `occupied`).
+ */
+static inline bool _map_erase_ctrl(u8 *ctrl, usize cap, usize idx)
+{
+	usize before = (idx - _MAP_GROUP) & (cap - 1);
+	u32 empty_before = _map_group_match_empty(ctrl + before);
+	u32 empty_after = _map_group_match_empty(ctrl + idx);
+	usize run = (usize)clz64(((u64)empty_before << 48) | (1ull << 47)) +
+		    (usize)ctz64((u64)empty_after | (1ull << 16));
+
+	bool emptied = run < _MAP_GROUP;
+	_map_set_ctrl(ctrl, cap, idx, emptied ? _MAP_EMPTY : _MAP_TOMB);
+	return emptied;
+}
+
+/*
+ * ==========================================================================
+ * Probing & Growth
+ * ==========================================================================
+ * Every table built on the control bytes probes and grows the same way; only
+ * the key comparison differs. `_map_probe` takes it as a callback and is
+ * always inlined, so a constant callback is inlined as well.
+ */
+
+/// smallest table: one full group, so the mirrored tail never overlaps
+#define _MAP_MIN_CAP _MAP_GROUP
+
+/// does slot `idx` of `table` hold `key` (whose full hash is `hash`)?
+typedef bool (*_map_slot_eq_fn)(const void *table, usize idx,
+				const void *key, u64 hash);
+
+/**
+ * Look `key` up in the `cap` control bytes at `ctrl`. Returns true and its
+ * slot if present; otherwise false and the first EMPTY/TOMB slot of the
+ * probe sequence (for an insert). `slot_eq` runs only where H2 matches.
+ */
+static alinline bool _map_probe(const u8 *ctrl, usize cap, u64 hash,
+				const void *table, const void *key,
+				_map_slot_eq_fn slot_eq, usize *out_idx)
+{
+	usize mask = cap - 1; /// cap is power of 2
+	usize pos = (usize)hash & mask;
+	usize stride = 0;
+	usize insert_at = (usize)-1;
+	u8 h2 = _map_h2(hash);
+
+	for (;;) {
+		const u8 *group = ctrl + pos;
+
+		/// compare keys only where the 7-bit fragment matches
+		for (u32 bits = _map_group_match(group, h2); bits;
+		     bits &= bits - 1) {
+			usize idx = (pos + (usize)ctz64(bits)) & mask;
+			if (likely(slot_eq(table, idx, key, hash))) {
+				*out_idx = idx;
+				return true; /// found
+			}
+		}
+
+		/// remember the first EMPTY/TOMB slot for a later insert
+		if (insert_at == (usize)-1) {
+			u32 free = _map_group_match_free(group);
+			if (free)
+				insert_at = (pos + (usize)ctz64(free)) & mask;
+		}
+
+		/// an EMPTY slot ends the probe sequence
+		if (likely(_map_group_match_empty(group) != 0)) {
+			*out_idx = insert_at;
+			return false;
+		}
+
+		stride += _MAP_GROUP;
+		pos = (pos + stride) & mask;
+	}
+}
+
+/**
+ * Capacity to rehash into before one more key goes into a table of `cap`
+ * slots with `len` keys and `occupied` non-EMPTY slots; 0 if it still fits.
+ *
+ * The load factor is 7/8, tombstones included. A table that is mostly
+ * tombstones is rehashed at the same size instead of growing.
+ */
+static inline usize _map_grow_cap(usize cap, usize len, usize occupied)
+{
+	if (cap > 0 && (occupied + 1) * 8 <= cap * 7)
+		return 0;
+	if (cap == 0)
+		return _MAP_MIN_CAP;
+	return (len * 2 < cap) ? cap : cap * 2;
+}
+
+/// smallest table that holds `n` keys under the 7/8 load factor
+static inline usize _map_cap_for(usize n)
+{
+	usize cap = _MAP_MIN_CAP;
+	while (n * 8 > cap * 7)
+		cap *= 2;
+	return cap;
+}
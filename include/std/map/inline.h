@@ -0,0 +1,240 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <std/map.h>
+#include <std/map/group.h> /// for the control group primitives
+#include <std/allocers/bump.h> /// for allocer_*_fast
+#include <core/hash.h>
+
+/*
+ * ==========================================================================
+ * Specialized Inline Maps
+ * ==========================================================================
+ * `map(K, V)` is one implementation for every key type: each probe calls
+ * `ops.equals` (and each insert `ops.hash`) through a function pointer.
+ * `defMapInline` instead stamps out a table type plus `static inline`
+ * functions for one key type, so the hash and the compare inline into the
+ * probe loop. Same control bytes, same group probing, same 7/8 load factor.
+ *
+ * `hash_fn` is called as `u64 hash_fn(K key)`, `eq_fn` as
+ * `bool eq_fn(K lhs, K rhs)`; both may be functions or macros.
+ *
+ * @example
+ * defMapInline(u32, symbol_t, SymTable, map_hash_u32, map_eq_scalar);
+ *
+ * SymTable t;
+ * SymTable_init(&t, allocer_system());
+ * if (!SymTable_put(&t, 42, sym)) ... // OOM
+ * symbol_t *s = SymTable_get(&t, 42);
+ * SymTable_deinit(&t);
+ *
+ * Generated for `Name`:
+ * - `void Name_init(Name *m, allocer_t alc)` (allocates nothing)
+ * - `void Name_deinit(Name *m)`
+ * - `bool Name_put(Name *m, K key, V val)`: false on OOM
+ * - `V *Name_get(const Name *m, K key)`: nullptr if absent
+ * - `V *Name_entry(Name *m, K key, bool *inserted)`: as `map_entry`
+ * - `bool Name_remove(Name *m, K key)`
+ * - `void Name_clear(Name *m)`
+ *
+ * `map_len` / `map_cap` work on the generated type as well.
+ */
+
+/* --- Ready-made hash & equality --- */
+
+/// same digests as MAP_OPS_U32 / MAP_OPS_U64 / MAP_OPS_USIZE
+static inline u64 map_hash_u32(u32 key)
+{
+	return hash_u32(key);
+}
+
+static inline u64 map_hash_u64(u64 key)
+{
+	return hash_u64(key);
+}
+
+static inline u64 map_hash_ptr(const void *key)
+{
+	return hash_u64((usize)key);
+}
+
+/// equality for integers, pointers, enums
+#define map_eq_scalar(lhs, rhs) ((lhs) == (rhs))
+
+/* --- Generator --- */
+
+#define defMapInline(K, V, Name, hash_fn, eq_fn)                               \
+	typedef struct Name {                                                  \
+		K *keys;                                                       \
+		V *vals;                                                       \
+		u8 *states; /* Control bytes, as in map(K, V) */               \
+		usize len;                                                     \
+		usize cap;                                                     \
+		usize occupied; /* len + tombstones */                         \
+		allocer_t alc;                                                 \
+	} Name;                                                                \
+                                                                               \
+	static inline void Name##_init(Name *m, allocer_t alc)                 \
+	{                                                                      \
+		*m = (Name){ .alc = alc };                                     \
+	}                                                                      \
+                                                                               \
+	static inline void _##Name##_free_arrays(Name *m)                      \
+	{                                                                      \
+		if (m->cap == 0)                                               \
+			return;                                                \
+		allocer_free_fast(m->alc, m->keys,                             \
+				  layout_of_array(K, m->cap));                 \
+		allocer_free_fast(m->alc, m->vals,                             \
+				  layout_of_array(V, m->cap));                 \
+		allocer_free_fast(m->alc, m->states,                           \
+				  layout(_map_ctrl_bytes(m->cap), 1));         \
+	}                                                                      \
+                                                                               \
+	static inline void Name##_deinit(Name *m)                              \
+	{                                                                      \
+		_##Name##_free_arrays(m);                                      \
+		*m = (Name){ .alc = m->alc };                                  \
+	}                                                                      \
+                                                                               \
+	static inline bool _##Name##_slot_eq(const void *t, usize idx,         \
+					     const void *key,                  \
+					     [[maybe_unused]] u64 hash)        \
+	{                                                                      \
+		return eq_fn(((const Name *)t)->keys[idx], *(const K *)key);   \
+	}                                                                      \
+                                                                               \
+	/* true if found, otherwise `*out` is the slot to insert into */       \
+	static inline bool _##Name##_find(const Name *m, K key, u64 hash,      \
+					  usize *out)                          \
+	{                                                                      \
+		return _map_probe(m->states, m->cap, hash, m, &key,            \
+				  _##Name##_slot_eq, out);                     \
+	}                                                                      \
+                                                                               \
+	[[maybe_unused]] static noinline bool                                  \
+	_##Name##_resize(Name *m, usize new_cap)                               \
+	{                                                                      \
+		layout_t l_keys = layout_of_array(K, new_cap);                 \
+		layout_t l_vals = layout_of_array(V, new_cap);                 \
+		layout_t l_states = layout(_map_ctrl_bytes(new_cap), 1);       \
+                                                                               \
+		K *keys = (K *)allocer_alloc_fast(m->alc, l_keys);             \
+		V *vals = (V *)allocer_alloc_fast(m->alc, l_vals);             \
+		u8 *states = (u8 *)allocer_alloc_fast(m->alc, l_states);       \
+		if (!keys || !vals || !states) {                               \
+			if (keys)                                              \
+				allocer_free_fast(m->alc, keys, l_keys);       \
+			if (vals)                                              \
+				allocer_free_fast(m->alc, vals, l_vals);       \
+			if (states)                                            \
+				allocer_free_fast(m->alc, states, l_states);   \
+			return false;                                          \
+		}                                                              \
+		memset(states, _MAP_EMPTY, l_states.size);                     \
+                                                                               \
+		/* H2 does not depend on the capacity: reuse it */             \
+		for (usize i = 0; i < m->cap; ++i) {                           \
+			u8 c = m->states[i];                                   \
+			if (!_map_ctrl_full(c))                                \
+				continue;                                      \
+			usize idx = _map_find_empty(states, new_cap,           \
+						    hash_fn(m->keys[i]));      \
+			keys[idx] = m->keys[i];                                \
+			vals[idx] = m->vals[i];                                \
+			_map_set_ctrl(states, new_cap, idx, c);                \
+		}                                                              \
+                                                                               \
+		_##Name##_free_arrays(m);                                      \
+		m->keys = keys;                                                \
+		m->vals = vals;                                                \
+		m->states = states;                                            \
+		m->cap = new_cap;                                              \
+		m->occupied = m->len;                                          \
+		return true;                                                   \
+	}                                                                      \
+                                                                               \
+	static inline V *Name##_entry(Name *m, K key, bool *inserted)          \
+	{                                                                      \
+		u64 hash = hash_fn(key);                                       \
+		usize idx = 0;                                                 \
+                                                                               \
+		if (m->cap > 0 && _##Name##_find(m, key, hash, &idx)) {        \
+			if (inserted)                                          \
+				*inserted = false;                             \
+			return &m->vals[idx];                                  \
+		}                                                              \
+                                                                               \
+		usize new_cap = _map_grow_cap(m->cap, m->len, m->occupied);    \
+		if (new_cap != 0) {                                            \
+			if (!_##Name##_resize(m, new_cap))                     \
+				return nullptr;                                \
+			idx = _map_find_empty(m->states, m->cap, hash);        \
+		}                                                              \
+                                                                               \
+		if (m->states[idx] == _MAP_EMPTY)                              \
+			m->occupied++;                                         \
+		m->keys[idx] = key;                                            \
+		memset(&m->vals[idx], 0, sizeof(V));                           \
+		_map_set_ctrl(m->states, m->cap, idx, _map_h2(hash));          \
+		m->len++;                                                      \
+		if (inserted)                                                  \
+			*inserted = true;                                      \
+		return &m->vals[idx];                                          \
+	}                                                                      \
+                                                                               \
+	[[nodiscard]] static inline bool Name##_put(Name *m, K key, V val)     \
+	{                                                                      \
+		V *slot = Name##_entry(m, key, nullptr);                       \
+		if (unlikely(!slot))                                           \
+			return false;                                          \
+		*slot = val;                                                   \
+		return true;                                                   \
+	}                                                                      \
+                                                                               \
+	static inline V *Name##_get(const Name *m, K key)                      \
+	{                                                                      \
+		usize idx;                                                     \
+		if (m->len == 0)                                               \
+			return nullptr;                                        \
+		if (!_##Name##_find(m, key, hash_fn(key), &idx))               \
+			return nullptr;                                        \
+		return &m->vals[idx];                                          \
+	}                                                                      \
+                                                                               \
+	static inline bool Name##_remove(Name *m, K key)                       \
+	{                                                                      \
+		usize idx;                                                     \
+		if (m->len == 0)                                               \
+			return false;                                          \
+		if (!_##Name##_find(m, key, hash_fn(key), &idx))               \
+			return false;                                          \
+		if (_map_erase_ctrl(m->states, m->cap, idx))                   \
+			m->occupied--;                                         \
+		m->len--;                                                      \
+		return true;                                                   \
+	}                                                                      \
+                                                                               \
+	static inline void Name##_clear(Name *m)                               \
+	{                                                                      \
+		if (m->cap > 0)                                                \
+			memset(m->states, _MAP_EMPTY,                          \
+			       _map_ctrl_bytes(m->cap));                       \
+		m->len = 0;                                                    \
+		m->occupied = 0;                                               \
+	}
@@ -0,0 +1,135 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <core/mem/allocer.h>
+#include <core/type.h>
+#include <std/strings/str.h>
+
+/*
+ * ==========================================================================
+ * Perfect Hash Tables for Static String Keys
+ * ==========================================================================
+ * A read-only `str_t -> int` table whose key set is fixed (keywords,
+ * directives, builtin names). Every key owns exactly one of `len` slots
+ * (minimal perfect hashing, "hash and displace"):
+ *
+ *   h       = phf_hash(key, seed)
+ *   (d1,d2) = disps[(h >> 32) % bucket_count]
+ *   slot    = (f2 + f1 * d1 + d2) % len       (f1, f2: 32 bits of h)
+ *
+ * A lookup is one hash, one displacement load and one key compare: no
+ * probe chain, no allocation. A miss costs the same as a hit.
+ *
+ * Tables are usually generated ahead of time as C source:
+ *
+ *   python3 scripts/gen_phf.py KEYWORDS keywords.txt src/lex/keywords.gen
+ *
+ * which emits `static const phf_t KEYWORDS` (see the script for the input
+ * format). `phf_build` runs the same construction at runtime, for key sets
+ * only known at startup.
+ *
+ * @example
+ * #include "keywords.gen"
+ *
+ * const int *tok = phf_get(&KEYWORDS, ident);
+ * if (tok) ... // keyword *tok
+ */
+
+typedef struct {
+	u32 d1;
+	u32 d2;
+} phf_disp_t;
+
+typedef struct {
+	u64 seed;
+	u32 len; /// keys (and slots)
+	u32 bucket_count;
+	const phf_disp_t *disps; /// one per bucket
+	const str_t *keys; /// key of each slot
+	const int *vals; /// value of each slot
+} phf_t;
+
+/**
+ * @brief The hash used by every table.
+ *
+ * Seeded FNV-1a with a splitmix64 finalizer. It is defined here and not
+ * taken from `core/hash.h` on purpose: generated tables bake its output in,
+ * and `scripts/gen_phf.py` implements it bit for bit.
+ */
+static inline u64 phf_hash(str_t key, u64 seed)
+{
+	u64 h = 0xcbf29ce484222325ull ^ seed;
+	for (usize i = 0; i < key.len; ++i) {
+		h ^= (u8)key.ptr[i];
+		h *= 0x100000001b3ull;
+	}
+	h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+	h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+	return h ^ (h >> 31);
+}
+
+/// slot of hash `h` under displacement `d` (Internal, mirrored by the
+/// generator)
+static inline u32 _phf_place(u64 h, phf_disp_t d, u32 len)
+{
+	u32 f1 = (u32)h;
+	u32 f2 = (u32)((h * 0x9e3779b97f4a7c15ull) >> 32);
+	return (f2 + f1 * d.d1 + d.d2) % len;
+}
+
+static inline u32 _phf_bucket(u64 h, u32 bucket_count)
+{
+	return (u32)(h >> 32) % bucket_count;
+}
+
+/**
+ * @brief Look a key up, like `map_get`.
+ * @return Pointer to the value, or nullptr if `key` is not in the set.
+ */
+static inline const int *phf_get(const phf_t *t, str_t key)
+{
+	if (unlikely(t->len == 0))
+		return nullptr;
+	u64 h = phf_hash(key, t->seed);
+	u32 slot = _phf_place(h, t->disps[_phf_bucket(h, t->bucket_count)],
+			      t->len);
+	str_t k = t->keys[slot];
+	if (k.len != key.len ||
+	    (key.len && memcmp(k.ptr, key.ptr, key.len) != 0))
+		return nullptr;
+	return &t->vals[slot];
+}
+
+/**
+ * @brief Build a table at runtime.
+ *
+ * The key strings are not copied: they must outlive the table. Arrays are
+ * allocated from `alc` and released by `phf_deinit`.
+ *
+ * @param keys Distinct keys.
+ * @param vals Value of each key (nullptr: the key's index).
+ * @return false on OOM or if two keys are equal.
+ */
+[[nodiscard]]
+bool phf_build(phf_t *t, allocer_t alc, const str_t *keys, const int *vals,
+	       usize n);
+
+/**
+ * @brief Free a table made by `phf_build` (never a generated one).
+ */
+void phf_deinit(phf_t *t, allocer_t alc);
@@ -0,0 +1,144 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <std/map.h> /// for map_ops_t and the MAP_OPS_* tables
+
+/*
+ * ==========================================================================
+ * Robin Hood Map
+ * ==========================================================================
+ * An open-addressing map with the same macro API as `map`, using Robin Hood
+ * insertion and backward-shift deletion.
+ *
+ * ### Why?
+ * - **No tombstones**: `rhmap_remove` shifts the following run back by one
+ * slot, so insert/remove churn never fills the table with dead entries and
+ * never forces a resize on its own.
+ * - **Bounded variance**: an insert takes the slot of any entry that is
+ * closer to its home than the new key is ("rob the rich"), so probe lengths
+ * stay close to the average.
+ * - **Early misses**: a lookup stops as soon as it meets an entry closer to
+ * home than itself.
+ *
+ * Prefer `map` for lookup-heavy tables; prefer `rhmap` for tables with heavy
+ * remove traffic (work lists, live sets, caches).
+ *
+ * - Thread Safe: No.
+ */
+
+/// probe distance metadata (Internal): 0 = empty, else distance from home + 1
+typedef u32 _rhmap_dist_t;
+
+#define rhmap(K, V)                                                           \
+	struct {                                                              \
+		K *keys; /* cap + 1 slots, the last one is scratch */         \
+		V *vals; /* cap + 1 slots, the last one is scratch */         \
+		_rhmap_dist_t *dists;                                         \
+		usize len;                                                    \
+		usize cap;                                                    \
+		allocer_t alc;                                                \
+		map_ops_t ops;                                                \
+		usize key_size; /* Cached for void* impl */                   \
+		usize val_size; /* Cached for void* impl */                   \
+	}
+
+#define defRhmap(K, V, Name) typedef rhmap(K, V) Name
+
+/*
+ * ==========================================================================
+ * Public Interface
+ * ==========================================================================
+ */
+
+/**
+ * @brief Initialize a Robin Hood map.
+ * @param m The map variable.
+ * @param allocator Backing allocator.
+ * @param ops_vtable Operations for Key (hash/eq), e.g. `MAP_OPS_U64`.
+ */
+#define rhmap_init(m, allocator, ops_vtable)                    \
+	_rhmap_init_impl((anyptr) & (m), allocator, ops_vtable, \
+			 sizeof(*(m).keys), sizeof(*(m).vals))
+
+/**
+ * @brief Free map memory.
+ */
+#define rhmap_deinit(m) _rhmap_deinit_impl((anyptr) & (m))
+
+/**
+ * @brief Insert or update a value.
+ * @return true on success, false on OOM.
+ */
+#define rhmap_put(m, key, val)                             \
+	({                                                 \
+		typeof((m).keys[0]) _k = (key);            \
+		typeof((m).vals[0]) _v = (val);            \
+		_rhmap_put_impl((anyptr) & (m), &_k, &_v); \
+	})
+
+/**
+ * @brief Get a pointer to the value.
+ * @return Pointer to value, or nullptr if not found.
+ * @note The pointer is invalidated by the next put or remove (entries move).
+ */
+#define rhmap_get(m, key)                                                      \
+	({                                                                     \
+		typeof((m).keys[0]) _k_lookup = (key);                         \
+		(typeof((m).vals))_rhmap_get_impl((anyptr) & (m), &_k_lookup); \
+	})
+
+/**
+ * @brief Remove a key (backward shift, no tombstone).
+ * @return true if key existed and was removed.
+ */
+#define rhmap_remove(m, key)                                 \
+	({                                                   \
+		typeof((m).keys[0]) _k_del = (key);          \
+		_rhmap_remove_impl((anyptr) & (m), &_k_del); \
+	})
+
+/**
+ * @brief Clear all entries (keeps capacity).
+ */
+#define rhmap_clear(m) _rhmap_clear_impl((anyptr) & (m))
+
+/* --- Utilities --- */
+#define rhmap_len(m) ((m).len)
+#define rhmap_cap(m) ((m).cap)
+
+/**
+ * @brief Longest probe distance currently in the table (0 when empty).
+ * A lookup never inspects more than this many slots.
+ */
+#define rhmap_max_probe(m) _rhmap_max_probe_impl((anyptr) & (m))
+
+/*
+ * ==========================================================================
+ * Internals
+ * ==========================================================================
+ */
+
+[[nodiscard]] bool _rhmap_init_impl(anyptr map, allocer_t alc, map_ops_t ops,
+				    usize k_sz, usize v_sz);
+void _rhmap_deinit_impl(anyptr map);
+[[nodiscard]] bool _rhmap_put_impl(anyptr map, const void *k_ptr,
+				   const void *v_ptr);
+void *_rhmap_get_impl(anyptr map, const void *k_ptr);
+bool _rhmap_remove_impl(anyptr map, const void *k_ptr);
+void _rhmap_clear_impl(anyptr map);
+usize _rhmap_max_probe_impl(anyptr map);
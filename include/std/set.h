@@ -0,0 +1,180 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <std/map.h> /// for map_ops_t and the MAP_OPS_* tables
+
+/*
+ * ==========================================================================
+ * Hash Set
+ * ==========================================================================
+ * The `map` table without the values: the same control bytes, group probing
+ * (`std/map/group.h`) and optional cached hash bits, with keys only.
+ *
+ * ### Why?
+ * - `map(K, bool)` allocates, moves and copies a value array that carries
+ * no information. A `set(void *)` takes half the memory of a
+ * `map(void *, void *)` and about 8/9 of a `map(void *, bool)`.
+ * - Bulk algebra (`set_union`, `set_intersect`, `set_contains_all`) works
+ * table to table, reserving once and reusing cached hash bits.
+ *
+ * - Thread Safe: No.
+ */
+
+#define set(K)                                                                 \
+	struct {                                                               \
+		K *keys;                                                       \
+		u8 *states; /* Control bytes: H2, EMPTY or TOMB */             \
+		u32 *hashes; /* Cached hash bits (ops.cache_hashes) */         \
+		usize len;                                                     \
+		usize cap;                                                     \
+		usize occupied; /* len + tombstones (for load factor check) */ \
+		allocer_t alc;                                                 \
+		map_ops_t ops;                                                 \
+		usize key_size; /* Cached for void* impl */                    \
+	}
+
+#define defSet(K, Name) typedef set(K) Name
+
+/*
+ * ==========================================================================
+ * Public Interface
+ * ==========================================================================
+ */
+
+/**
+ * @brief Initialize a set.
+ * @param s The set variable.
+ * @param allocator Backing allocator.
+ * @param ops_vtable Operations for Key (hash/eq), e.g. `MAP_OPS_PTR`.
+ */
+#define set_init(s, allocator, ops_vtable)                                     \
+	_set_init_impl((anyptr) & (s), allocator, ops_vtable, sizeof(*(s).keys))
+
+/**
+ * @brief Free set memory.
+ */
+#define set_deinit(s) _set_deinit_impl((anyptr) & (s))
+
+/**
+ * @brief Reserve room for at least `n` more keys (no growth until then).
+ * @return true on success, false on OOM.
+ */
+#define set_reserve(s, n) _set_reserve_impl((anyptr) & (s), (n))
+
+/**
+ * @brief Add a key.
+ * @param inserted Optional `bool *`, set to true if the key was not present.
+ * @return true on success, false on OOM.
+ */
+#define set_insert(s, key, inserted)                                   \
+	({                                                             \
+		typeof((s).keys[0]) _k_ins = (key);                    \
+		_set_insert_impl((anyptr) & (s), &_k_ins, (inserted)); \
+	})
+
+/**
+ * @brief Test membership.
+ */
+#define set_contains(s, key)                                 \
+	({                                                   \
+		typeof((s).keys[0]) _k_has = (key);          \
+		_set_contains_impl((anyptr) & (s), &_k_has); \
+	})
+
+/**
+ * @brief Remove a key.
+ * @return true if key existed and was removed.
+ */
+#define set_remove(s, key)                                 \
+	({                                                 \
+		typeof((s).keys[0]) _k_del = (key);        \
+		_set_remove_impl((anyptr) & (s), &_k_del); \
+	})
+
+/**
+ * @brief Clear all keys (keeps capacity).
+ */
+#define set_clear(s) _set_clear_impl((anyptr) & (s))
+
+/* --- Set Algebra --- */
+
+/**
+ * @brief `dst = dst ∪ src`.
+ * @note Both sets must hold the same key type and use the same `ops`.
+ * @return true on success, false on OOM (`dst` then holds a partial union).
+ */
+#define set_union(dst, src)                                          \
+	({                                                           \
+		static_assert(sizeof(*(dst).keys) ==                 \
+			      sizeof(*(src).keys));                  \
+		_set_union_impl((anyptr) & (dst), (anyptr) & (src)); \
+	})
+
+/**
+ * @brief `dst = dst ∩ other` (in place, never allocates).
+ * @note Both sets must hold the same key type and use the same `ops`.
+ */
+#define set_intersect(dst, other)                                          \
+	({                                                                 \
+		static_assert(sizeof(*(dst).keys) ==                       \
+			      sizeof(*(other).keys));                      \
+		_set_intersect_impl((anyptr) & (dst), (anyptr) & (other)); \
+	})
+
+/**
+ * @brief True if every key of `sub` is in `s` (`sub ⊆ s`).
+ * @note Both sets must hold the same key type and use the same `ops`.
+ */
+#define set_contains_all(s, sub)                                          \
+	({                                                                \
+		static_assert(sizeof(*(s).keys) == sizeof(*(sub).keys));  \
+		_set_contains_all_impl((anyptr) & (s), (anyptr) & (sub)); \
+	})
+
+/* --- Utilities --- */
+#define set_len(s) ((s).len)
+#define set_cap(s) ((s).cap)
+
+/**
+ * @brief Iterate over the keys (table order, not insertion order).
+ * @param it Iterator name (pointer to key: K*).
+ * @note Do not insert or remove while iterating.
+ */
+#define set_foreach(it, s)                                                  \
+	for (usize _set_i = 0; _set_i < (s).cap; ++_set_i)                  \
+		if ((s).states[_set_i] < _MAP_TOMB) /* FULL */              \
+			for (auto it = &(s).keys[_set_i]; it; it = nullptr)
+
+/*
+ * ==========================================================================
+ * Internals
+ * ==========================================================================
+ */
+
+[[nodiscard]] bool _set_init_impl(anyptr set, allocer_t alc, map_ops_t ops,
+				  usize k_sz);
+void _set_deinit_impl(anyptr set);
+[[nodiscard]] bool _set_reserve_impl(anyptr set, usize additional);
+[[nodiscard]] bool _set_insert_impl(anyptr set, const void *k_ptr,
+				    bool *inserted);
+bool _set_contains_impl(anyptr set, const void *k_ptr);
+bool _set_remove_impl(anyptr set, const void *k_ptr);
+void _set_clear_impl(anyptr set);
+[[nodiscard]] bool _set_union_impl(anyptr dst, anyptr src);
+void _set_intersect_impl(anyptr dst, anyptr other);
+bool _set_contains_all_impl(anyptr set, anyptr sub);
@@ -0,0 +1,108 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <std/vec.h>
+#include <core/mem/allocer.h>
+#include <core/type.h>
+
+/*
+ * ==========================================================================
+ * Small Vector (inline storage, spills to the heap)
+ * ==========================================================================
+ * A `vec(T)` with room for N elements inside the struct itself. Nothing is
+ * allocated until the N+1th push; most operand or child lists never get
+ * there.
+ *
+ * The first four fields are laid out exactly like `vec(T)`, so the whole
+ * `vec_*` API works unchanged: `vec_push`, `vec_at`, `vec_foreach`,
+ * `vec_reserve`, `vec_pop`, `vec_len`, ...
+ *
+ * ### How?
+ * `alc` is not the user's allocator but an adapter whose `self` is the
+ * smallvec. When `vec` grows, the adapter sees a realloc of the inline
+ * buffer, allocates from `backing` instead and copies the elements over.
+ * Reallocs that still fit the inline buffer (`vec_shrink_to_fit`, regrowth
+ * after it) keep it, and an emptied vector gets it back on the next push.
+ * Every other request is forwarded to `backing` as is.
+ *
+ * Memory Layout:
+ * [ data | len | cap | alc | backing | inline_sz ][ inline[0] ... ]
+ *   |                                               ^
+ *   +--- points here until the first spill, into `backing` memory after
+ *
+ * @warning A smallvec points into itself: never copy or move one by value
+ * after `smallvec_init` (pass it by pointer, like `bump_t`).
+ *
+ * @example
+ * smallvec(u32, 4) ops;
+ * smallvec_init(ops, allocer_system());
+ * vec_push(ops, 7); /// no allocation
+ * vec_foreach(it, ops) { ... }
+ * smallvec_deinit(ops);
+ */
+
+/**
+ * @brief A vector with `N` inline elements.
+ */
+#define smallvec(T, N)             \
+	struct {                   \
+		T *data;           \
+		usize len;         \
+		usize cap;         \
+		allocer_t alc;     \
+		allocer_t backing; \
+		usize _inline_sz;  \
+		T _inline[N];      \
+	}
+
+#define defSmallvec(type, n, name) typedef smallvec(type, n) name
+
+/**
+ * @brief Initialize a small vector: empty, pointing at the inline buffer.
+ * @param allocator The allocator used once the inline buffer overflows.
+ * @note Cannot fail: nothing is allocated.
+ */
+#define smallvec_init(v, allocator)                                 \
+	_smallvec_init_impl((anyptr) & (v), allocator, (v)._inline, \
+			    array_size((v)._inline),                \
+			    sizeof((v)._inline),                    \
+			    alignof(typeof(*(v).data)))
+
+/**
+ * @brief Free the heap buffer, if the vector ever spilled.
+ */
+#define smallvec_deinit(v) vec_deinit(v)
+
+/**
+ * @brief Whether the elements still live in the inline buffer.
+ */
+#define smallvec_is_inline(v) ((v).data == (v)._inline)
+
+/**
+ * @brief Number of inline elements (`N`).
+ */
+#define smallvec_inline_cap(v) array_size((v)._inline)
+
+/*
+ * ==========================================================================
+ * Internal Implementation
+ * ==========================================================================
+ */
+
+void _smallvec_init_impl(anyptr vec, allocer_t backing, anyptr inline_buf,
+			 usize inline_cap, usize inline_size, usize align);
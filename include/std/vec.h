@@ -215,6 +215,128 @@
 #define vec_foreach(it, v) \
 	for (auto it = (v).data; it < (v).data + (v).len; ++it)
 
+/* --- Bulk Operations --- */
+
+/**
+ * @brief Append `n` elements copied from `arr` (one reserve, one memcpy).
+ * @param arr Pointer to `T` (type-checked against the vector).
+ * @return true on success, false on OOM (the vector is unchanged).
+ * @note `arr` may point into the vector itself.
+ */
+#define vec_extend_from_array(v, arr, n)                                       \
+	({                                                                     \
+		const typeof(*(v).data) *_src = (arr);                         \
+		_vec_extend_impl((anyptr) & (v), _src, (n), sizeof(*(v).data), \
+				 alignof(typeof(*(v).data)));                  \
+	})
+
+/**
+ * @brief Append every element of another vector of the same type.
+ * @return true on success, false on OOM (the vector is unchanged).
+ */
+#define vec_extend(v, other) vec_extend_from_array(v, (other).data, (other).len)
+
+/**
+ * @brief Insert `n` elements from `arr` before index `i` (`i <= len`).
+ *
+ * The tail is shifted with a single memmove.
+ * @return true on success, false on OOM (the vector is unchanged).
+ * @panic Panics if `i > len`.
+ * @warning `arr` must not point into the vector itself.
+ */
+#define vec_insert_n(v, i, arr, n)                               \
+	({                                                       \
+		const typeof(*(v).data) *_src = (arr);           \
+		_vec_insert_impl((anyptr) & (v), (i), _src, (n), \
+				 sizeof(*(v).data),              \
+				 alignof(typeof(*(v).data)));    \
+	})
+
+/**
+ * @brief Remove the elements in `[start, end)`, keeping the order.
+ * @panic Panics if `start > end` or `end > len`.
+ */
+#define vec_remove_range(v, start, end)                     \
+	_vec_remove_range_impl((anyptr) & (v), (start), (end), \
+			       sizeof(*(v).data))
+
+/**
+ * @brief Remove element `i` in O(1) by moving the last element into its
+ * place. Does not keep the order.
+ * @return The removed element.
+ * @panic Panics if `i` is out of bounds.
+ */
+#define vec_swap_remove(v, i)                                                  \
+	({                                                                     \
+		usize _idx = (i);                                              \
+		if (unlikely(_idx >= (v).len)) {                               \
+			log_panic("vec index out of bounds: %zu >= %zu", _idx, \
+				  (v).len);                                    \
+		}                                                              \
+		typeof(*(v).data) _removed = (v).data[_idx];                   \
+		(v).data[_idx] = (v).data[--(v).len];                          \
+		_removed;                                                      \
+	})
+
+/**
+ * @brief Keep only the elements for which `pred(T *)` is true, in order.
+ *
+ * One pass: survivors are compacted towards the front as it goes.
+ * @param pred A function or function-like macro taking `T *`.
+ * @return Number of elements removed.
+ */
+#define vec_retain(v, pred)                                          \
+	({                                                           \
+		usize _w = 0;                                        \
+		for (usize _r = 0; _r < (v).len; ++_r) {             \
+			if (pred(&(v).data[_r])) {                   \
+				if (_w != _r)                        \
+					(v).data[_w] = (v).data[_r]; \
+				++_w;                                \
+			}                                            \
+		}                                                    \
+		usize _removed = (v).len - _w;                       \
+		(v).len = _w;                                        \
+		_removed;                                            \
+	})
+
+/**
+ * @brief Collapse runs of consecutive equal elements into one.
+ *
+ * Sort first to remove all duplicates.
+ * @param eq A function or function-like macro taking `(T *, T *)`.
+ * @return Number of elements removed.
+ */
+#define vec_dedup_by(v, eq)                                        \
+	({                                                         \
+		usize _w = (v).len > 0 ? 1 : 0;                    \
+		for (usize _r = 1; _r < (v).len; ++_r) {           \
+			if (!eq(&(v).data[_w - 1], &(v).data[_r])) \
+				(v).data[_w++] = (v).data[_r];     \
+		}                                                  \
+		usize _removed = (v).len - _w;                     \
+		(v).len = _w;                                      \
+		_removed;                                          \
+	})
+
+/// `==` on element pointers, for `vec_dedup`
+#define _vec_eq_deref(a, b) (*(a) == *(b))
+
+/**
+ * @brief `vec_dedup_by` with `==`: integers, pointers, enums.
+ * @return Number of elements removed.
+ */
+#define vec_dedup(v) vec_dedup_by(v, _vec_eq_deref)
+
+/**
+ * @brief Shrink the capacity down to the length (freeing an empty buffer).
+ * @return true on success; false if the allocator failed, in which case
+ * the vector keeps its old buffer.
+ */
+#define vec_shrink_to_fit(v)                                \
+	_vec_shrink_impl((anyptr) & (v), sizeof(*(v).data), \
+			 alignof(typeof(*(v).data)))
+
 /*
  * ==========================================================================
  * 3. Internal Implementation
@@ -230,3 +352,13 @@ bool _vec_grow_impl(anyptr vec, usize item_size, usize align);
 [[nodiscard]]
 bool _vec_reserve_impl(anyptr vec, usize additional, usize item_size,
 		       usize align);
+[[nodiscard]]
+bool _vec_extend_impl(anyptr vec, const void *src, usize n, usize item_size,
+		      usize align);
+[[nodiscard]]
+bool _vec_insert_impl(anyptr vec, usize index, const void *src, usize n,
+		      usize item_size, usize align);
+void _vec_remove_range_impl(anyptr vec, usize start, usize end,
+			    usize item_size);
+[[nodiscard]]
+bool _vec_shrink_impl(anyptr vec, usize item_size, usize align);
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+Perfect Hash Table Generator for C.
+Reads a fixed set of string keys (keywords, directives, builtins) and
+generates a C source file with a minimal perfect hash table (`phf_t`, see
+include/std/map/phf.h): one hash, one displacement load and one compare
+per lookup, no allocation, no startup cost.
+
+Usage:
+    python3 scripts/gen_phf.py NAME input.txt output.gen
+
+Input format, one key per line:
+    # comment
+    if      TOK_IF
+    else    TOK_ELSE
+    while               <- no value: the key's index among the keys
+
+The value is copied verbatim into an `int` initializer, so it may be any
+constant C expression (an enum constant, a literal).
+
+The construction mirrors `phf_build` in src/std/map/phf.c step by step
+(same hash, same seeds, same bucket order), so both produce the same table.
+"""
+
+import sys
+import os
+
+# =============================================================================
+# configuration
+# =============================================================================
+
+LAMBDA = 5      # average keys per bucket
+MAX_SEEDS = 64  # attempts before giving up
+
+MASK64 = (1 << 64) - 1
+MASK32 = (1 << 32) - 1
+
+# =============================================================================
+# hashing (must match phf_hash / _phf_place / _phf_bucket)
+# =============================================================================
+
+def phf_hash(key, seed):
+    """Seeded FNV-1a with a splitmix64 finalizer."""
+    h = 0xcbf29ce484222325 ^ seed
+    for b in key:
+        h ^= b
+        h = (h * 0x100000001b3) & MASK64
+    h = ((h ^ (h >> 30)) * 0xbf58476d1ce4e5b9) & MASK64
+    h = ((h ^ (h >> 27)) * 0x94d049bb133111eb) & MASK64
+    return h ^ (h >> 31)
+
+def place(h, d1, d2, n):
+    f1 = h & MASK32
+    f2 = ((h * 0x9e3779b97f4a7c15) & MASK64) >> 32
+    return ((f2 + f1 * d1 + d2) & MASK32) % n
+
+def bucket(h, nb):
+    return (h >> 32) % nb
+
+def next_seed(state):
+    """splitmix64 step: returns (new_state, seed)."""
+    state = (state + 0x9e3779b97f4a7c15) & MASK64
+    z = state
+    z = ((z ^ (z >> 30)) * 0xbf58476d1ce4e5b9) & MASK64
+    z = ((z ^ (z >> 27)) * 0x94d049bb133111eb) & MASK64
+    return state, z ^ (z >> 31)
+
+# =============================================================================
+# core Logic
+# =============================================================================
+
+def try_seed(keys, seed, nb):
+    """One attempt: slot -> key index list, displacements, or None."""
+    n = len(keys)
+    hashes = [phf_hash(k, seed) for k in keys]
+
+    members = [[] for _ in range(nb)]
+    for i, h in enumerate(hashes):
+        members[bucket(h, nb)].append(i)
+
+    # largest bucket first, ties by index
+    order = sorted(range(nb), key=lambda b: (-len(members[b]), b))
+
+    owner = [None] * n
+    disps = [(0, 0)] * nb
+    for b in order:
+        placed = False
+        for d1 in range(n):
+            for d2 in range(n):
+                slots = [place(hashes[i], d1, d2, n) for i in members[b]]
+                if len(set(slots)) == len(slots) and \
+                   all(owner[s] is None for s in slots):
+                    for i, s in zip(members[b], slots):
+                        owner[s] = i
+                    disps[b] = (d1, d2)
+                    placed = True
+                    break
+            if placed:
+                break
+        if not placed:
+            return None
+    return owner, disps
+
+def build(keys):
+    """Find a seed that works: (seed, bucket_count, owner, disps)."""
+    if len(set(keys)) != len(keys):
+        dups = sorted({k.decode() for k in keys if keys.count(k) > 1})
+        print(f"Error: duplicate keys: {', '.join(dups)}")
+        sys.exit(1)
+
+    nb = (len(keys) + LAMBDA - 1) // LAMBDA
+    state = 0
+    for _ in range(MAX_SEEDS):
+        state, seed = next_seed(state)
+        result = try_seed(keys, seed, nb)
+        if result:
+            return seed, nb, result[0], result[1]
+
+    print(f"Error: no perfect hash found after {MAX_SEEDS} seeds.")
+    sys.exit(1)
+
+def parse_input(path):
+    """Read `key [value]` lines, returns ([key bytes], [value str])."""
+    keys, vals = [], []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.split('#')[0].strip()
+            if not line:
+                continue
+            parts = line.split(None, 1)
+            keys.append(parts[0].encode("utf-8"))
+            vals.append(parts[1].strip() if len(parts) > 1 else None)
+
+    # default values: the key's index
+    vals = [v if v is not None else str(i) for i, v in enumerate(vals)]
+    return keys, vals
+
+def c_string(key):
+    """Escape bytes as a C string literal."""
+    out = []
+    for b in key:
+        c = chr(b)
+        if c in '"\\':
+            out.append('\\' + c)
+        elif 0x20 <= b < 0x7f:
+            out.append(c)
+        else:
+            out.append(f'\\x{b:02x}""')
+    return '"' + ''.join(out) + '"'
+
+def generate_c_source(name, source, keys, vals, table, output_path):
+    """Write the table to a C source file."""
+    seed, nb, owner, disps = table
+    print(f"Generating {output_path}...")
+
+    try:
+        os.makedirs(os.path.dirname(os.path.abspath(output_path)),
+                    exist_ok=True)
+
+        with open(output_path, "w", encoding="utf-8") as f:
+            f.write("/*\n")
+            f.write(" * This file is auto-generated by scripts/gen_phf.py\n")
+            f.write(f" * Source: {source} ({len(keys)} keys)\n")
+            f.write(" * DO NOT EDIT MANUALLY.\n")
+            f.write(" */\n")
+            f.write("#pragma once\n")
+            f.write("#include <std/map/phf.h>\n\n")
+
+            f.write(f"static const phf_disp_t {name}_DISPS[] = {{\n")
+            for d1, d2 in disps:
+                f.write(f"    {{{d1}, {d2}}},\n")
+            f.write("};\n\n")
+
+            f.write(f"static const str_t {name}_KEYS[] = {{\n")
+            for i in owner:
+                f.write(f"    {{{c_string(keys[i])}, {len(keys[i])}}},\n")
+            f.write("};\n\n")
+
+            f.write(f"static const int {name}_VALS[] = {{\n")
+            for i in owner:
+                f.write(f"    {vals[i]},\n")
+            f.write("};\n\n")
+
+            f.write(f"static const phf_t {name} = {{\n")
+            f.write(f"    .seed = 0x{seed:016x}ull,\n")
+            f.write(f"    .len = {len(keys)},\n")
+            f.write(f"    .bucket_count = {nb},\n")
+            f.write(f"    .disps = {name}_DISPS,\n")
+            f.write(f"    .keys = {name}_KEYS,\n")
+            f.write(f"    .vals = {name}_VALS,\n")
+            f.write("};\n")
+
+    except IOError as e:
+        print(f"Error writing to {output_path}: {e}")
+        sys.exit(1)
+
+def main():
+    if len(sys.argv) != 4:
+        print(__doc__.strip())
+        sys.exit(1)
+    name, input_path, output_path = sys.argv[1:]
+
+    print(f"--- Perfect Hash Generator ({name}) ---")
+    keys, vals = parse_input(input_path)
+    if not keys:
+        print(f"Error: no keys in {input_path}.")
+        sys.exit(1)
+    print(f"Read {len(keys)} keys from {input_path}...")
+
+    table = build(keys)
+    print(f"  -> seed 0x{table[0]:016x}, {table[1]} buckets.")
+
+    generate_c_source(name, os.path.basename(input_path), keys, vals, table,
+                      output_path)
+    print("Done.")
+
+if __name__ == "__main__":
+    main()
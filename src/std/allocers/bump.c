@@ -18,6 +18,7 @@
 #include <core/mem/allocer.h> /// for allocer_alloc/free
 #include <core/msg.h> /// for massert
 #include <core/math.h> /// for align_up, checked_add, etc.
+#include <std/allocers/system.h> /// for allocer_system (scratch arenas)
 #include <string.h> /// for memcpy, memset
 
 /*
@@ -50,6 +51,7 @@ static chunk_footer_t *get_empty_chunk(void)
 		/// point data/ptr to itself so any access stays within valid (but 0-sized) memory
 		EMPTY_CHUNK_SINGLETON.data_start = (u8 *)&EMPTY_CHUNK_SINGLETON;
 		EMPTY_CHUNK_SINGLETON.chunk_size = 0;
+		EMPTY_CHUNK_SINGLETON.chunk_align = 0;
 		EMPTY_CHUNK_SINGLETON.prev = &EMPTY_CHUNK_SINGLETON;
 		EMPTY_CHUNK_SINGLETON.ptr = (u8 *)&EMPTY_CHUNK_SINGLETON;
 		EMPTY_CHUNK_SINGLETON.allocated_bytes = 0;
@@ -65,23 +67,186 @@ static bool chunk_is_empty(chunk_footer_t *footer)
 
 /*
  * ==========================================================================
- * 3. Internal Chunk Management
+ * 3. Global Chunk Pool
  * ==========================================================================
+ * Process-wide cache of released chunks, bucketed by floor(log2(chunk_size)).
+ * A cached chunk remembers its backing allocator and is only handed to an
+ * arena with the same backing, so it is always freed where it came from.
+ * The chunk memory itself holds the free-list node.
  */
 
-static void dealloc_chunk_list(bump_t *bump, chunk_footer_t *footer)
+#define POOL_BUCKETS 64
+
+typedef struct PooledChunk {
+	struct PooledChunk *next;
+	allocer_t backing;
+	usize chunk_size;
+	usize chunk_align; /// kept for the final free
+} pooled_chunk_t;
+
+static struct {
+	pooled_chunk_t *buckets[POOL_BUCKETS];
+	usize limit; /// high-water mark in bytes, 0 = disabled
+	bump_pool_stats_t stats;
+	u32 lock;
+} g_pool;
+
+static void pool_lock(void)
 {
-	while (!chunk_is_empty(footer)) {
-		chunk_footer_t *prev = footer->prev;
+	while (__atomic_exchange_n(&g_pool.lock, 1, __ATOMIC_ACQUIRE)) {
+		while (__atomic_load_n(&g_pool.lock, __ATOMIC_RELAXED))
+			;
+	}
+}
+
+static void pool_unlock(void)
+{
+	__atomic_store_n(&g_pool.lock, 0, __ATOMIC_RELEASE);
+}
+
+static usize pool_bucket(usize chunk_size)
+{
+	return (usize)(63 - clz64((u64)chunk_size));
+}
+
+static bool allocer_same(allocer_t a, allocer_t b)
+{
+	return a.self == b.self && a.vtable == b.vtable;
+}
+
+/**
+ * @brief Take a cached chunk of size in [min_size, max_size], or nullptr.
+ * @param out_size Receives the actual size of the returned chunk.
+ * @param out_align Receives the alignment it was allocated with.
+ */
+static u8 *pool_take(allocer_t backing, usize min_size, usize max_size,
+		     usize align, usize *out_size, usize *out_align)
+{
+	if (__atomic_load_n(&g_pool.limit, __ATOMIC_RELAXED) == 0)
+		return nullptr;
+
+	u8 *data = nullptr;
+	pool_lock();
+
+	/// the next bucket only holds chunks larger than min_size
+	usize first = pool_bucket(min_size);
+	for (usize b = first; b < POOL_BUCKETS && b <= first + 1 && !data;
+	     ++b) {
+		pooled_chunk_t **link = &g_pool.buckets[b];
+		while (*link) {
+			pooled_chunk_t *node = *link;
+			if (node->chunk_size >= min_size &&
+			    node->chunk_size <= max_size &&
+			    is_aligned((uptr)node, align) &&
+			    allocer_same(node->backing, backing)) {
+				*link = node->next;
+				*out_size = node->chunk_size;
+				*out_align = node->chunk_align;
+				data = (u8 *)node;
+				break;
+			}
+			link = &node->next;
+		}
+	}
+
+	if (data) {
+		g_pool.stats.hits++;
+		g_pool.stats.cached_chunks--;
+		g_pool.stats.cached_bytes -= *out_size;
+	} else {
+		g_pool.stats.misses++;
+	}
+
+	pool_unlock();
+	return data;
+}
+
+/**
+ * @brief Offer a chunk to the pool.
+ * @return false if the pool is disabled or full (caller frees it).
+ */
+static bool pool_give(allocer_t backing, u8 *data, usize chunk_size,
+		      usize chunk_align)
+{
+	if (__atomic_load_n(&g_pool.limit, __ATOMIC_RELAXED) == 0)
+		return false;
+
+	bool accepted = false;
+	pool_lock();
+
+	if (g_pool.stats.cached_bytes + chunk_size <= g_pool.limit) {
+		pooled_chunk_t *node = (pooled_chunk_t *)data;
+		usize b = pool_bucket(chunk_size);
+		node->next = g_pool.buckets[b];
+		node->backing = backing;
+		node->chunk_size = chunk_size;
+		node->chunk_align = chunk_align;
+		g_pool.buckets[b] = node;
+
+		g_pool.stats.returned++;
+		g_pool.stats.cached_chunks++;
+		g_pool.stats.cached_bytes += chunk_size;
+		g_pool.stats.peak_cached_bytes =
+			max(g_pool.stats.peak_cached_bytes,
+			    g_pool.stats.cached_bytes);
+		accepted = true;
+	} else {
+		g_pool.stats.released++;
+	}
+
+	pool_unlock();
+	return accepted;
+}
+
+/**
+ * @brief Free cached chunks (largest buckets first) until at most `keep`
+ * bytes remain. Must be called with the pool lock held.
+ */
+static void pool_shrink_locked(usize keep)
+{
+	for (usize b = POOL_BUCKETS; b-- > 0 && g_pool.stats.cached_bytes > keep;) {
+		while (g_pool.buckets[b] && g_pool.stats.cached_bytes > keep) {
+			pooled_chunk_t *node = g_pool.buckets[b];
+			g_pool.buckets[b] = node->next;
+
+			usize size = node->chunk_size;
+			usize align = node->chunk_align;
+			allocer_t backing = node->backing;
+			g_pool.stats.cached_chunks--;
+			g_pool.stats.cached_bytes -= size;
+			g_pool.stats.released++;
+
+			allocer_free(backing, node, layout(size, align));
+		}
+	}
+}
 
-		/// reconstruct layout to free correctly using backing allocator
-		/// we allocated `chunk_size` bytes.
-		/// the alignment used was at least CHUNK_ALIGN.
-		layout_t l = layout(footer->chunk_size, CHUNK_ALIGN);
+/*
+ * ==========================================================================
+ * 4. Internal Chunk Management
+ * ==========================================================================
+ */
 
-		/// free the raw memory block (starts at data_start)
-		allocer_free(bump->backing, footer->data_start, l);
+static void dealloc_chunk(bump_t *bump, chunk_footer_t *footer)
+{
+	/// recycle through the global pool when it has room
+	if (pool_give(bump->backing, footer->data_start, footer->chunk_size,
+		      footer->chunk_align))
+		return;
+
+	/// free with the exact layout it was allocated with: the backing
+	/// allocator may pick its release path from it (e.g. munmap vs free)
+	layout_t l = layout(footer->chunk_size, footer->chunk_align);
+
+	/// free the raw memory block (starts at data_start)
+	allocer_free(bump->backing, footer->data_start, l);
+}
 
+static void dealloc_chunk_list(bump_t *bump, chunk_footer_t *footer)
+{
+	while (!chunk_is_empty(footer)) {
+		chunk_footer_t *prev = footer->prev;
+		dealloc_chunk(bump, footer);
 		footer = prev;
 	}
 }
@@ -107,9 +272,26 @@ static chunk_footer_t *new_chunk(bump_t *bump, usize new_size_no_footer,
 	if (alloc_size == 0)
 		return nullptr;
 
-	/// [Dependency Injection] Use the backing allocator
-	layout_t l = layout(alloc_size, align);
-	u8 *data = (u8 *)allocer_alloc(bump->backing, l);
+	/// reuse a cached chunk if possible. with an allocation limit only an
+	/// exact size match is accepted, so the limit accounting stays exact.
+	usize max_size = alloc_size;
+	if (bump->limit == SIZE_MAX && alloc_size <= SIZE_MAX / 2)
+		max_size = alloc_size * 2 - 1;
+
+	usize pooled_size = 0, pooled_align = 0;
+	u8 *data = pool_take(bump->backing, alloc_size, max_size, align,
+			     &pooled_size, &pooled_align);
+
+	if (data) {
+		/// the footer goes at the very end of the (possibly larger) chunk
+		alloc_size = pooled_size;
+		align = pooled_align;
+		new_size_no_footer = alloc_size - FOOTER_SIZE;
+	} else {
+		/// [Dependency Injection] Use the backing allocator
+		layout_t l = layout(alloc_size, align);
+		data = (u8 *)allocer_alloc(bump->backing, l);
+	}
 
 	if (!data)
 		return nullptr;
@@ -121,6 +303,7 @@ static chunk_footer_t *new_chunk(bump_t *bump, usize new_size_no_footer,
 
 	footer_ptr->data_start = data;
 	footer_ptr->chunk_size = alloc_size;
+	footer_ptr->chunk_align = align;
 	footer_ptr->prev = prev;
 	footer_ptr->allocated_bytes =
 		prev->allocated_bytes + new_size_no_footer;
@@ -141,12 +324,48 @@ static chunk_footer_t *new_chunk(bump_t *bump, usize new_size_no_footer,
 
 /*
  * ==========================================================================
- * 4. Allocation Logic (Slow Path)
+ * 5. Allocation Logic (Slow Path)
  * ==========================================================================
  * Handles allocating a new chunk when the current one is full.
  */
 
-static anyptr alloc_layout_slow(bump_t *bump, layout_t layout)
+/**
+ * @brief Reuse a chunk kept by `bump_rewind_to` if one can hold `layout`.
+ */
+static chunk_footer_t *take_spare(bump_t *bump, layout_t layout,
+				  usize requested_size)
+{
+	chunk_footer_t *prev = bump->current_chunk;
+	chunk_footer_t **link = &bump->spare;
+
+	for (chunk_footer_t *c = bump->spare; !chunk_is_empty(c);
+	     link = &c->prev, c = c->prev) {
+		uptr top = align_down((uptr)c, bump->min_align);
+		uptr end = align_down(top, max(layout.align, bump->min_align));
+		if (end < (uptr)c->data_start ||
+		    end - (uptr)c->data_start < requested_size)
+			continue;
+
+		usize usable = (usize)((u8 *)c - c->data_start);
+		if (bump->limit != SIZE_MAX &&
+		    prev->allocated_bytes + usable > bump->limit)
+			continue;
+
+		*link = c->prev;
+		c->prev = prev;
+		c->ptr = (u8 *)top;
+		c->allocated_bytes = prev->allocated_bytes + usable;
+		return c;
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Allocate the next chunk in the growth sequence for `layout`.
+ *
+ * Does NOT publish the chunk as `current_chunk`; callers decide how.
+ */
+static chunk_footer_t *grow_chunk(bump_t *bump, layout_t layout)
 {
 	chunk_footer_t *current_footer = bump->current_chunk;
 
@@ -175,6 +394,13 @@ static anyptr alloc_layout_slow(bump_t *bump, layout_t layout)
 		new_size_no_footer = requested_size;
 	}
 
+	/// chunks kept by a rewind come first
+	if (!chunk_is_empty(bump->spare)) {
+		chunk_footer_t *spare = take_spare(bump, layout, requested_size);
+		if (spare)
+			return spare;
+	}
+
 	/// 3. check Hard Limit (Allocation Limit)
 	if (bump->limit != SIZE_MAX) {
 		usize allocated = current_footer->allocated_bytes;
@@ -198,9 +424,12 @@ static anyptr alloc_layout_slow(bump_t *bump, layout_t layout)
 	}
 
 	/// 5. allocate New Chunk
-	chunk_footer_t *new_footer = new_chunk(bump, new_size_no_footer,
-					       chunk_align, current_footer);
+	return new_chunk(bump, new_size_no_footer, chunk_align, current_footer);
+}
 
+static anyptr alloc_layout_slow(bump_t *bump, layout_t layout)
+{
+	chunk_footer_t *new_footer = grow_chunk(bump, layout);
 	if (!new_footer)
 		return nullptr;
 
@@ -261,7 +490,7 @@ static anyptr alloc_layout_slow(bump_t *bump, layout_t layout)
 
 /*
  * ==========================================================================
- * 5. Allocation Logic (Fast Path)
+ * 6. Allocation Logic (Fast Path)
  * ==========================================================================
  */
 
@@ -311,9 +540,128 @@ static anyptr try_alloc_layout_fast(bump_t *bump, layout_t layout)
 	return (anyptr)result_ptr;
 }
 
+/**
+ * @brief Resize the most recent allocation without leaving garbage behind.
+ *
+ * The newest block always starts at `footer->ptr`, so it owns the range
+ * [ptr, ptr + old_size). Since the arena grows down, growing keeps the end
+ * of that range fixed and moves the start down, relocating the bytes with
+ * `memmove` (the ranges may overlap). Shrinking keeps the block where it is.
+ *
+ * @return The resized block, or nullptr if `old_ptr` is not the tip or the
+ * current chunk has no room (caller falls back to alloc + copy).
+ */
+static anyptr try_realloc_tip(bump_t *bump, anyptr old_ptr, usize old_size,
+			      usize new_size, usize align)
+{
+	chunk_footer_t *footer = bump->current_chunk;
+	u8 *old = (u8 *)old_ptr;
+
+	if (chunk_is_empty(footer) || old != footer->ptr)
+		return nullptr;
+
+	if (align == 0 || !is_power_of_two(align))
+		align = 1;
+	usize requested_align = max(align, bump->min_align);
+
+	/// shrink: nothing to move, the tail simply becomes slack
+	if (new_size <= old_size) {
+		if (!is_aligned((uptr)old, requested_align))
+			return nullptr;
+		return old_ptr;
+	}
+
+	/// grow: keep the end fixed, move the start down
+	u8 *end = old + old_size;
+	u8 *start = footer->data_start;
+	if (new_size > (usize)(end - start))
+		return nullptr;
+
+	u8 *new_ptr = (u8 *)align_down((uptr)(end - new_size), requested_align);
+	if (new_ptr < start)
+		return nullptr;
+
+	memmove(new_ptr, old, old_size);
+	footer->ptr = new_ptr;
+	return (anyptr)new_ptr;
+}
+
+/*
+ * ==========================================================================
+ * 7. Concurrent Allocation (Lock-free Fast Path)
+ * ==========================================================================
+ * Used when `bump->concurrent` is set. Threads race on `footer->ptr` with a
+ * CAS loop; only chunk growth takes `grow_lock`.
+ */
+
+static void grow_lock_acquire(bump_t *bump)
+{
+	while (__atomic_exchange_n(&bump->grow_lock, 1, __ATOMIC_ACQUIRE)) {
+		/// spin on a plain load to keep the cache line shared
+		while (__atomic_load_n(&bump->grow_lock, __ATOMIC_RELAXED))
+			;
+	}
+}
+
+static void grow_lock_release(bump_t *bump)
+{
+	__atomic_store_n(&bump->grow_lock, 0, __ATOMIC_RELEASE);
+}
+
+static anyptr try_alloc_layout_atomic(chunk_footer_t *footer, layout_t layout,
+				      usize min_align)
+{
+	usize align = max(layout.align, min_align);
+	usize aligned_size = align_up(layout.size, align);
+	u8 *start = footer->data_start;
+	u8 *ptr = __atomic_load_n(&footer->ptr, __ATOMIC_RELAXED);
+	u8 *result_ptr;
+
+	do {
+		u8 *aligned_ptr_end = (u8 *)align_down((uptr)ptr, align);
+		if (aligned_ptr_end < start)
+			return nullptr;
+		if (aligned_size > (usize)(aligned_ptr_end - start))
+			return nullptr;
+		result_ptr = aligned_ptr_end - aligned_size;
+	} while (!__atomic_compare_exchange_n(&footer->ptr, &ptr, result_ptr,
+					      true, __ATOMIC_RELAXED,
+					      __ATOMIC_RELAXED));
+
+	return (anyptr)result_ptr;
+}
+
+static anyptr alloc_layout_concurrent(bump_t *bump, layout_t layout)
+{
+	for (;;) {
+		chunk_footer_t *footer =
+			__atomic_load_n(&bump->current_chunk, __ATOMIC_ACQUIRE);
+
+		anyptr alloc = try_alloc_layout_atomic(footer, layout,
+						       bump->min_align);
+		if (alloc)
+			return alloc;
+
+		/// slow path: grow, unless another thread beat us to it
+		grow_lock_acquire(bump);
+		if (__atomic_load_n(&bump->current_chunk, __ATOMIC_RELAXED) ==
+		    footer) {
+			chunk_footer_t *new_footer = grow_chunk(bump, layout);
+			if (!new_footer) {
+				grow_lock_release(bump);
+				return nullptr;
+			}
+			/// publish only after the footer is fully initialized
+			__atomic_store_n(&bump->current_chunk, new_footer,
+					 __ATOMIC_RELEASE);
+		}
+		grow_lock_release(bump);
+	}
+}
+
 /*
  * ==========================================================================
- * 6. Public API Implementation
+ * 8. Public API Implementation
  * ==========================================================================
  */
 
@@ -329,6 +677,15 @@ void bump_init(bump_t *self, allocer_t backing, usize min_align)
 	self->limit = SIZE_MAX;
 	self->allocated = 0; /// total bytes allocated via backing
 	self->min_align = min_align;
+	self->concurrent = false;
+	self->grow_lock = 0;
+	self->spare = get_empty_chunk();
+}
+
+void bump_init_concurrent(bump_t *self, allocer_t backing, usize min_align)
+{
+	bump_init(self, backing, min_align);
+	self->concurrent = true;
 }
 
 void bump_deinit(bump_t *self)
@@ -336,6 +693,7 @@ void bump_deinit(bump_t *self)
 	if (self) {
 		dealloc_chunk_list(self, self->current_chunk);
 		self->current_chunk = get_empty_chunk();
+		bump_release_spare(self);
 	}
 }
 
@@ -395,6 +753,9 @@ anyptr bump_alloc_layout(bump_t *self, layout_t layout)
 		layout.align = 1;
 	}
 
+	if (self->concurrent)
+		return alloc_layout_concurrent(self, layout);
+
 	/// try fast path
 	anyptr alloc = try_alloc_layout_fast(self, layout);
 	if (alloc)
@@ -466,6 +827,15 @@ anyptr bump_realloc(bump_t *self, anyptr old_ptr, usize old_size,
 	if (new_size == 0)
 		return nullptr;
 
+	/// try resizing the newest allocation in place
+	/// (not in concurrent mode: the tip may belong to another thread)
+	if (!self->concurrent) {
+		anyptr tip_ptr = try_realloc_tip(self, old_ptr, old_size,
+						 new_size, align);
+		if (tip_ptr)
+			return tip_ptr;
+	}
+
 	anyptr new_ptr = bump_alloc(self, new_size, align);
 	if (new_ptr) {
 		/// minimal copy
@@ -487,9 +857,116 @@ usize bump_get_allocated_bytes(bump_t *self)
 	return self->current_chunk->allocated_bytes;
 }
 
+/* --- Checkpoints --- */
+
+bump_mark_t bump_mark(const bump_t *self)
+{
+	return (bump_mark_t){ .chunk = self->current_chunk,
+			      .ptr = self->current_chunk->ptr };
+}
+
+void bump_rewind_to(bump_t *self, bump_mark_t mark, bool keep_chunks)
+{
+	/// detach every chunk created after the mark
+	chunk_footer_t *footer = self->current_chunk;
+	while (footer != mark.chunk) {
+		massert(!chunk_is_empty(footer),
+			"bump_rewind_to: mark does not belong to this arena");
+		chunk_footer_t *prev = footer->prev;
+		if (keep_chunks) {
+			/// newest first, so the next chunk to grow into ends on top
+			footer->prev = self->spare;
+			self->spare = footer;
+		} else {
+			dealloc_chunk(self, footer);
+		}
+		footer = prev;
+	}
+
+	self->current_chunk = footer;
+	if (!chunk_is_empty(footer)) {
+		massert(mark.ptr >= footer->ptr,
+			"bump_rewind_to: mark is ahead of the arena");
+		footer->ptr = mark.ptr;
+	}
+}
+
+void bump_release_spare(bump_t *self)
+{
+	dealloc_chunk_list(self, self->spare);
+	self->spare = get_empty_chunk();
+}
+
+/* --- Chunk Pool --- */
+
+void bump_pool_set_limit(usize max_bytes)
+{
+	pool_lock();
+	g_pool.limit = max_bytes;
+	pool_shrink_locked(max_bytes);
+	pool_unlock();
+}
+
+void bump_pool_trim(void)
+{
+	pool_lock();
+	pool_shrink_locked(0);
+	pool_unlock();
+}
+
+bump_pool_stats_t bump_pool_stats(void)
+{
+	pool_lock();
+	bump_pool_stats_t stats = g_pool.stats;
+	pool_unlock();
+	return stats;
+}
+
+/*
+ * ==========================================================================
+ * 9. Thread-Local Scratch Arenas
+ * ==========================================================================
+ */
+
+#define SCRATCH_COUNT 2
+
+static thread_local bump_t tl_scratch[SCRATCH_COUNT];
+static thread_local bool tl_scratch_ready;
+
+static bump_t *scratch_arenas(void)
+{
+	if (unlikely(!tl_scratch_ready)) {
+		for (usize i = 0; i < SCRATCH_COUNT; ++i)
+			bump_init(&tl_scratch[i], allocer_system(), 1);
+		tl_scratch_ready = true;
+	}
+	return tl_scratch;
+}
+
+bump_scratch_t bump_scratch_begin(const bump_t *conflict)
+{
+	bump_t *arenas = scratch_arenas();
+	bump_t *arena = (&arenas[0] == conflict) ? &arenas[1] : &arenas[0];
+	return (bump_scratch_t){ .arena = arena, .mark = bump_mark(arena) };
+}
+
+void bump_scratch_end(bump_scratch_t *scratch)
+{
+	bump_rewind_to(scratch->arena, scratch->mark, true);
+}
+
+void bump_scratch_release(void)
+{
+	if (!tl_scratch_ready)
+		return;
+	for (usize i = 0; i < SCRATCH_COUNT; ++i)
+		bump_deinit(&tl_scratch[i]);
+	tl_scratch_ready = false;
+}
+
 /*
  * ==========================================================================
- * 7. V-Table Implementation & Adapter
+ * 10. V-Table Implementation & Adapter
  * ==========================================================================
  */
 
@@ -518,7 +995,7 @@ static anyptr _bump_vt_zalloc(anyptr self, layout_t layout)
 	return bump_zalloc((bump_t *)self, layout);
 }
 
-static const allocer_vtable_t BUMP_VTABLE = {
+const allocer_vtable_t BUMP_VTABLE = {
 	.alloc = _bump_vt_alloc,
 	.free = _bump_vt_free,
 	.realloc = _bump_vt_realloc,
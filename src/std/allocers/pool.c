@@ -0,0 +1,278 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/allocers/pool.h>
+#include <core/msg.h> /// for massert
+#include <core/math.h> /// for align_up, clz64
+#include <string.h> /// for memcpy, memset
+
+/*
+ * ==========================================================================
+ * 1. Size Classes
+ * ==========================================================================
+ */
+
+#define SLAB_HEADER_SIZE (align_up(sizeof(pool_slab_t), POOL_ALIGN))
+
+/// 16-byte steps up to this size, powers of two above it
+#define SMALL_STEP_LIMIT 256
+
+static inline usize class_index(usize size)
+{
+	if (size <= SMALL_STEP_LIMIT) {
+		return size == 0 ? 0 : (size - 1) / 16;
+	}
+	/// 257..512 -> 16, 513..1024 -> 17, ...
+	usize log2_ceil = (usize)(64 - clz64((u64)(size - 1)));
+	return 16 + (log2_ceil - 9);
+}
+
+static inline usize class_size(usize idx)
+{
+	if (idx < 16) {
+		return (idx + 1) * 16;
+	}
+	return (usize)1 << (idx - 16 + 9);
+}
+
+static inline bool is_slab_sized(layout_t layout)
+{
+	return layout.size <= POOL_MAX_SIZE && layout.align <= POOL_ALIGN;
+}
+
+/*
+ * ==========================================================================
+ * 2. Slab Management
+ * ==========================================================================
+ */
+
+/// get a fresh slab for class `c` and make it the carving region
+static bool refill_class(pool_t *self, pool_class_t *c)
+{
+	layout_t l = layout(POOL_SLAB_SIZE, POOL_ALIGN);
+	pool_slab_t *slab = (pool_slab_t *)allocer_alloc(self->backing, l);
+	if (!slab)
+		return false;
+
+	slab->size = POOL_SLAB_SIZE;
+	slab->next = self->slabs;
+	self->slabs = slab;
+	self->slab_count++;
+
+	c->cur = (u8 *)slab + SLAB_HEADER_SIZE;
+	c->end = (u8 *)slab + POOL_SLAB_SIZE;
+	return true;
+}
+
+static void release_slabs(pool_t *self)
+{
+	pool_slab_t *slab = self->slabs;
+	while (slab) {
+		pool_slab_t *next = slab->next;
+		allocer_free(self->backing, slab, layout(slab->size, POOL_ALIGN));
+		slab = next;
+	}
+	self->slabs = nullptr;
+	self->slab_count = 0;
+}
+
+static void reset_classes(pool_t *self)
+{
+	for (usize i = 0; i < POOL_NUM_CLASSES; ++i) {
+		self->classes[i] = (pool_class_t){
+			.free_list = nullptr,
+			.cur = nullptr,
+			.end = nullptr,
+			.obj_size = class_size(i),
+		};
+	}
+}
+
+/// kept out of line so the hot paths do not spill `layout` for the call
+static noinline anyptr alloc_large(pool_t *self, layout_t layout)
+{
+	return allocer_alloc(self->backing, layout);
+}
+
+static noinline void free_large(pool_t *self, anyptr ptr, layout_t layout)
+{
+	allocer_free(self->backing, ptr, layout);
+}
+
+/*
+ * ==========================================================================
+ * 3. Public API Implementation
+ * ==========================================================================
+ */
+
+void pool_init(pool_t *self, allocer_t backing)
+{
+	massert(self != nullptr, "pool_t cannot be NULL");
+	self->backing = backing;
+	self->slabs = nullptr;
+	self->slab_count = 0;
+	reset_classes(self);
+}
+
+void pool_deinit(pool_t *self)
+{
+	if (self) {
+		release_slabs(self);
+		reset_classes(self);
+	}
+}
+
+pool_t *pool_new(allocer_t backing)
+{
+	pool_t *pool = (pool_t *)allocer_alloc(backing, layout_of(pool_t));
+	if (!pool)
+		return nullptr;
+
+	pool_init(pool, backing);
+	return pool;
+}
+
+void pool_drop(pool_t *self)
+{
+	if (self) {
+		allocer_t backing = self->backing; /// save backing
+		pool_deinit(self);
+		allocer_free(backing, self, layout_of(pool_t));
+	}
+}
+
+void pool_reset(pool_t *self)
+{
+	release_slabs(self);
+	reset_classes(self);
+}
+
+anyptr pool_alloc_layout(pool_t *self, layout_t layout)
+{
+	/// large or over-aligned objects bypass the slabs
+	if (unlikely(!is_slab_sized(layout))) {
+		return alloc_large(self, layout);
+	}
+
+	pool_class_t *c = &self->classes[class_index(layout.size)];
+
+	/// 1. reuse a freed object
+	pool_free_t *node = c->free_list;
+	if (likely(node != nullptr)) {
+		c->free_list = node->next;
+		return (anyptr)node;
+	}
+
+	/// 2. carve from the current slab
+	if (unlikely((usize)(c->end - c->cur) < c->obj_size)) {
+		if (!refill_class(self, c))
+			return nullptr;
+	}
+
+	anyptr obj = (anyptr)c->cur;
+	c->cur += c->obj_size;
+	return obj;
+}
+
+anyptr pool_alloc(pool_t *self, usize size, usize align)
+{
+	return pool_alloc_layout(self, layout(size, align));
+}
+
+void pool_free(pool_t *self, anyptr ptr, layout_t layout)
+{
+	if (ptr == nullptr)
+		return;
+
+	if (unlikely(!is_slab_sized(layout))) {
+		free_large(self, ptr, layout);
+		return;
+	}
+
+	pool_class_t *c = &self->classes[class_index(layout.size)];
+	pool_free_t *node = (pool_free_t *)ptr;
+	node->next = c->free_list;
+	c->free_list = node;
+}
+
+anyptr pool_realloc(pool_t *self, anyptr ptr, layout_t old_layout,
+		    layout_t new_layout)
+{
+	if (ptr == nullptr) {
+		return pool_alloc_layout(self, new_layout);
+	}
+	if (new_layout.size == 0) {
+		pool_free(self, ptr, old_layout);
+		return nullptr;
+	}
+
+	/// same size class: nothing to do
+	if (is_slab_sized(old_layout) && is_slab_sized(new_layout) &&
+	    class_index(old_layout.size) == class_index(new_layout.size)) {
+		return ptr;
+	}
+
+	anyptr new_ptr = pool_alloc_layout(self, new_layout);
+	if (new_ptr) {
+		memcpy(new_ptr, ptr, min(old_layout.size, new_layout.size));
+		pool_free(self, ptr, old_layout);
+	}
+	return new_ptr;
+}
+
+/*
+ * ==========================================================================
+ * 4. V-Table Implementation & Adapter
+ * ==========================================================================
+ */
+
+static anyptr _pool_vt_alloc(anyptr self, layout_t layout)
+{
+	return pool_alloc_layout((pool_t *)self, layout);
+}
+
+static void _pool_vt_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	pool_free((pool_t *)self, ptr, layout);
+}
+
+static anyptr _pool_vt_realloc(anyptr self, anyptr ptr, layout_t old,
+			       layout_t new_l)
+{
+	return pool_realloc((pool_t *)self, ptr, old, new_l);
+}
+
+static anyptr _pool_vt_zalloc(anyptr self, layout_t layout)
+{
+	anyptr ptr = pool_alloc_layout((pool_t *)self, layout);
+	if (ptr && layout.size > 0) {
+		memset(ptr, 0, layout.size);
+	}
+	return ptr;
+}
+
+static const allocer_vtable_t POOL_VTABLE = {
+	.alloc = _pool_vt_alloc,
+	.free = _pool_vt_free,
+	.realloc = _pool_vt_realloc,
+	.zalloc = _pool_vt_zalloc,
+};
+
+allocer_t pool_allocer(pool_t *self)
+{
+	massert(self != nullptr, "pool_t cannot be NULL");
+	return (allocer_t){ .self = self, .vtable = &POOL_VTABLE };
+}
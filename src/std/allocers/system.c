@@ -14,12 +14,18 @@
  *    limitations under the License.
  */
 
+/// for mremap / MREMAP_MAYMOVE (must come before every include)
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <std/allocers/system.h>
 #include <core/msg.h>
 #include <core/math.h>
 #include <core/macros.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stddef.h> /// for max_align_t
 
 /*
  * ==========================================================================
@@ -30,31 +36,114 @@
 #if defined(_WIN32) || defined(_WIN64)
 #include <malloc.h>
 
-#define HAS_ALIGNED_REALLOC true
 static inline anyptr _sys_alloc_impl(usize size, usize align)
 {
 	return _aligned_malloc(size, align);
 }
 
-static inline void _sys_free_impl(anyptr ptr)
+static inline anyptr _sys_zalloc_impl(usize size, usize align)
+{
+	anyptr ptr = _aligned_malloc(size, align);
+	if (ptr) {
+		memset(ptr, 0, size);
+	}
+	return ptr;
+}
+
+static inline void _sys_free_impl(anyptr ptr, usize size, usize align)
 {
+	unused(size);
+	unused(align);
 	_aligned_free(ptr);
 }
 
-static inline anyptr _sys_realloc_impl(anyptr ptr, usize size, usize align)
+static inline anyptr _sys_realloc_impl(anyptr ptr, layout_t old_l,
+				       layout_t new_l)
 {
-	return _aligned_realloc(ptr, size, align);
+	unused(old_l);
+	return _aligned_realloc(ptr, new_l.size, new_l.align);
 }
 
 #else
 /// POSIX (Linux, macOS, etc.)
 #include <stdlib.h>
+#include <string.h> /// for memcpy, memset
+
+#if defined(__linux__)
+#include <sys/mman.h> /// for mmap, mremap, munmap
+#include <unistd.h> /// for sysconf
+
+/**
+ * Huge blocks get their own mapping, so growing them is a page-table
+ * `mremap` instead of a copy. Whether a block is mapped is derived from its
+ * layout, which is why `free`/`realloc` must receive the exact layout.
+ */
+#define HAS_MREMAP true
+#define SYS_MMAP_THRESHOLD ((usize)64 * 1024 * 1024)
+
+static usize _sys_page_size(void)
+{
+	static usize page_size = 0;
+	if (unlikely(page_size == 0)) {
+		page_size = (usize)sysconf(_SC_PAGESIZE);
+	}
+	return page_size;
+}
+
+static inline bool _sys_is_mapped(usize size, usize align)
+{
+	return size >= SYS_MMAP_THRESHOLD && align <= _sys_page_size();
+}
+
+static anyptr _sys_map(usize size)
+{
+	void *ptr = mmap(nullptr, align_up(size, _sys_page_size()),
+			 PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+			 -1, 0);
+	return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+static void _sys_unmap(anyptr ptr, usize size)
+{
+	munmap(ptr, align_up(size, _sys_page_size()));
+}
+
+static anyptr _sys_remap(anyptr ptr, usize old_size, usize new_size)
+{
+	usize page = _sys_page_size();
+	void *res = mremap(ptr, align_up(old_size, page),
+			   align_up(new_size, page), MREMAP_MAYMOVE);
+	return res == MAP_FAILED ? nullptr : res;
+}
 
-/// POSIX does NOT support aligned realloc natively
-#define HAS_ALIGNED_REALLOC false
+#else
+#define HAS_MREMAP false
+
+static inline bool _sys_is_mapped(usize size, usize align)
+{
+	unused(size);
+	unused(align);
+	return false;
+}
+#endif
+
+/// plain malloc/realloc/calloc already guarantee this alignment
+static inline bool _sys_is_plain(usize align)
+{
+	return align <= alignof(max_align_t);
+}
 
 static inline anyptr _sys_alloc_impl(usize size, usize align)
 {
+#if HAS_MREMAP
+	if (_sys_is_mapped(size, align)) {
+		return _sys_map(size);
+	}
+#endif
+	if (_sys_is_plain(align)) {
+		return malloc(size);
+	}
+
 	/// posix_memalign requires alignment to be a power of two
 	/// AND a multiple of sizeof(void *).
 	if (align < sizeof(void *)) {
@@ -69,20 +158,63 @@ static inline anyptr _sys_alloc_impl(usize size, usize align)
 	return ptr;
 }
 
-static inline void _sys_free_impl(anyptr ptr)
+static inline anyptr _sys_zalloc_impl(usize size, usize align)
 {
-	free(ptr);
+#if HAS_MREMAP
+	if (_sys_is_mapped(size, align)) {
+		return _sys_map(size); /// fresh pages are already zero
+	}
+#endif
+	if (_sys_is_plain(align)) {
+		return calloc(1, size);
+	}
+
+	anyptr ptr = _sys_alloc_impl(size, align);
+	if (ptr) {
+		memset(ptr, 0, size);
+	}
+	return ptr;
 }
 
-[[maybe_unused]]
-static inline anyptr _sys_realloc_impl(anyptr ptr, usize size, usize align)
+static inline void _sys_free_impl(anyptr ptr, usize size, usize align)
 {
-	/// returning nullptr triggers the generic alloc+memcpy+free fallback
-	/// in core/mem/allocer.h logic (set realloc to nullptr in vtable).
-	unused(ptr);
+#if HAS_MREMAP
+	if (_sys_is_mapped(size, align)) {
+		_sys_unmap(ptr, size);
+		return;
+	}
+#else
 	unused(size);
 	unused(align);
-	return nullptr;
+#endif
+	free(ptr);
+}
+
+static inline anyptr _sys_realloc_impl(anyptr ptr, layout_t old_l,
+				       layout_t new_l)
+{
+	bool old_mapped = _sys_is_mapped(old_l.size, old_l.align);
+	bool new_mapped = _sys_is_mapped(new_l.size, new_l.align);
+
+#if HAS_MREMAP
+	/// 1. huge -> huge: move page table entries, never bytes
+	if (old_mapped && new_mapped) {
+		return _sys_remap(ptr, old_l.size, new_l.size);
+	}
+#endif
+
+	/// 2. heap -> heap with default alignment: libc realloc (may grow in place)
+	if (!old_mapped && !new_mapped && _sys_is_plain(new_l.align)) {
+		return realloc(ptr, new_l.size);
+	}
+
+	/// 3. crossing the threshold or over-aligned: alloc + copy + free
+	anyptr new_ptr = _sys_alloc_impl(new_l.size, new_l.align);
+	if (new_ptr) {
+		memcpy(new_ptr, ptr, min(old_l.size, new_l.size));
+		_sys_free_impl(ptr, old_l.size, old_l.align);
+	}
+	return new_ptr;
 }
 
 #endif
@@ -111,38 +243,37 @@ static anyptr sys_vt_alloc(anyptr self, layout_t layout)
 static void sys_vt_free(anyptr self, anyptr ptr, layout_t layout)
 {
 	unused(self);
-	unused(layout); /// system free usually handles size tracking itself
 	if (ptr) {
-		_sys_free_impl(ptr);
+		_sys_free_impl(ptr, layout.size, layout.align);
 	}
 }
 
-#if HAS_ALIGNED_REALLOC
 static anyptr sys_vt_realloc(anyptr self, anyptr ptr, layout_t old_l,
 			     layout_t new_l)
 {
 	unused(self);
-	unused(old_l);
 
-	/// optimized path for Windows which supports aligned realloc
-	/// for POSIX, _sys_realloc_impl returns nullptr, triggering the safe fallback.
-	return _sys_realloc_impl(ptr, new_l.size, new_l.align);
+	if (ptr == nullptr) {
+		return sys_vt_alloc(self, new_l);
+	}
+	if (new_l.size == 0) {
+		sys_vt_free(self, ptr, old_l);
+		return nullptr;
+	}
+	return _sys_realloc_impl(ptr, old_l, new_l);
 }
-#endif
 
 static anyptr sys_vt_zalloc(anyptr self, layout_t layout)
 {
 	unused(self);
-	/// standard `calloc` only guarantees default alignment
-	/// since allocer_t demands strict alignment (which might be > 16),
-	/// we cannot safely use calloc here.
-	/// so use alloc + memset strategy.
-
-	anyptr ptr = _sys_alloc_impl(layout.size, layout.align);
-	if (ptr) {
-		memset(ptr, 0, layout.size);
+	usize actual_size = layout.size;
+	if (actual_size == 0) {
+		actual_size = 1;
 	}
-	return ptr;
+
+	/// `calloc` only guarantees default alignment, so it is used only when
+	/// that is enough; over-aligned requests fall back to alloc + memset.
+	return _sys_zalloc_impl(actual_size, layout.align);
 }
 
 /*
@@ -154,13 +285,7 @@ static anyptr sys_vt_zalloc(anyptr self, layout_t layout)
 static const allocer_vtable_t SYSTEM_VTABLE = {
 	.alloc = sys_vt_alloc,
 	.free = sys_vt_free,
-/// only provide realloc pointer if platform supports it.
-/// if nullptr, the allocer_realloc wrapper will perform the safe fallback (Alloc+Copy+Free).
-#if HAS_ALIGNED_REALLOC
 	.realloc = sys_vt_realloc,
-#else
-	.realloc = nullptr,
-#endif
 	.zalloc = sys_vt_zalloc,
 };
 
@@ -0,0 +1,605 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/allocers/tlsf.h>
+#include <core/msg.h> /// for massert
+#include <core/math.h> /// for align_up, clz64, ctz64
+#include <stddef.h> /// for offsetof
+#include <string.h> /// for memcpy, memset
+
+/*
+ * ==========================================================================
+ * 1. Block Helpers
+ * ==========================================================================
+ */
+
+#define BLOCK_FREE ((usize)1)
+#define BLOCK_PREV_FREE ((usize)2)
+#define BLOCK_FLAGS (BLOCK_FREE | BLOCK_PREV_FREE)
+
+/// header bytes in front of every payload (`prev_phys` + `size`)
+#define BLOCK_HDR (offsetof(tlsf_block_t, next_free))
+/// a free block must hold its list links
+#define MIN_PAYLOAD (sizeof(tlsf_block_t) - BLOCK_HDR)
+/// smallest block that may be split off
+#define MIN_BLOCK (BLOCK_HDR + MIN_PAYLOAD)
+
+#define REGION_HDR (align_up(sizeof(tlsf_region_t), TLSF_ALIGN))
+#define DEFAULT_REGION_SIZE ((usize)1 << 20)
+/// every block of a region this size still maps below `TLSF_FL_COUNT`
+#define MAX_REGION ((usize)1 << TLSF_FL_MAX_LOG2)
+
+#define SMALL_BLOCK ((usize)1 << TLSF_FL_SHIFT)
+/// keep the rounding in `mapping_search` from overflowing
+#define MAX_ALLOC ((usize)1 << (TLSF_FL_MAX_LOG2 - 1))
+
+static inline usize block_size(const tlsf_block_t *b)
+{
+	return b->size & ~BLOCK_FLAGS;
+}
+
+static inline void block_set_size(tlsf_block_t *b, usize size)
+{
+	b->size = size | (b->size & BLOCK_FLAGS);
+}
+
+static inline bool block_is_free(const tlsf_block_t *b)
+{
+	return (b->size & BLOCK_FREE) != 0;
+}
+
+static inline bool block_is_prev_free(const tlsf_block_t *b)
+{
+	return (b->size & BLOCK_PREV_FREE) != 0;
+}
+
+static inline u8 *block_payload(const tlsf_block_t *b)
+{
+	return (u8 *)b + BLOCK_HDR;
+}
+
+static inline tlsf_block_t *block_from_ptr(const void *ptr)
+{
+	return (tlsf_block_t *)((u8 *)ptr - BLOCK_HDR);
+}
+
+static inline tlsf_block_t *block_next(const tlsf_block_t *b)
+{
+	return (tlsf_block_t *)(block_payload(b) + block_size(b));
+}
+
+/// round a request up to a payload size; 0 if it is too large
+static inline usize adjust_size(usize size)
+{
+	if (size > MAX_ALLOC)
+		return 0;
+	return align_up(size < MIN_PAYLOAD ? MIN_PAYLOAD : size, TLSF_ALIGN);
+}
+
+/*
+ * ==========================================================================
+ * 2. Size Class Mapping
+ * ==========================================================================
+ */
+
+static inline usize fls_size(usize size)
+{
+	return (usize)(63 - clz64((u64)size));
+}
+
+/// the list a block of `size` belongs to
+static inline void mapping_insert(usize size, usize *fl, usize *sl)
+{
+	if (size < SMALL_BLOCK) {
+		*fl = 0;
+		*sl = size / (SMALL_BLOCK / TLSF_SL_COUNT);
+		return;
+	}
+	usize f = fls_size(size);
+	*sl = (size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+	*fl = f - (TLSF_FL_SHIFT - 1);
+}
+
+/// round `size` up to the next list boundary, so any block found fits
+static inline usize mapping_round(usize size)
+{
+	if (size >= SMALL_BLOCK) {
+		size += ((usize)1 << (fls_size(size) - TLSF_SL_LOG2)) - 1;
+	}
+	return size;
+}
+
+static inline void mapping_search(usize size, usize *fl, usize *sl)
+{
+	mapping_insert(mapping_round(size), fl, sl);
+}
+
+/*
+ * ==========================================================================
+ * 3. Free Lists
+ * ==========================================================================
+ */
+
+static void insert_free(tlsf_t *self, tlsf_block_t *b)
+{
+	usize fl, sl;
+	mapping_insert(block_size(b), &fl, &sl);
+	/// regions are capped at MAX_REGION, so no block outgrows the table
+	massert(fl < TLSF_FL_COUNT, "tlsf: block size out of class range");
+
+	tlsf_block_t *head = self->blocks[fl][sl];
+	b->next_free = head;
+	b->prev_free = nullptr;
+	if (head)
+		head->prev_free = b;
+	self->blocks[fl][sl] = b;
+
+	self->fl_bitmap |= (u64)1 << fl;
+	self->sl_bitmap[fl] |= (u32)1 << sl;
+}
+
+static void remove_free(tlsf_t *self, tlsf_block_t *b)
+{
+	usize fl, sl;
+	mapping_insert(block_size(b), &fl, &sl);
+
+	tlsf_block_t *prev = b->prev_free;
+	tlsf_block_t *next = b->next_free;
+	if (next)
+		next->prev_free = prev;
+	if (prev) {
+		prev->next_free = next;
+		return;
+	}
+
+	self->blocks[fl][sl] = next;
+	if (next == nullptr) {
+		self->sl_bitmap[fl] &= ~((u32)1 << sl);
+		if (self->sl_bitmap[fl] == 0)
+			self->fl_bitmap &= ~((u64)1 << fl);
+	}
+}
+
+/// first non-empty list at or above (fl, sl); two bit scans
+static tlsf_block_t *find_suitable(tlsf_t *self, usize size)
+{
+	usize fl, sl;
+	mapping_search(size, &fl, &sl);
+	if (fl >= TLSF_FL_COUNT)
+		return nullptr;
+
+	u32 sl_map = self->sl_bitmap[fl] & (~(u32)0 << sl);
+	if (sl_map == 0) {
+		u64 fl_map = self->fl_bitmap & (~(u64)0 << (fl + 1));
+		if (fl_map == 0)
+			return nullptr;
+		fl = (usize)ctz64(fl_map);
+		sl_map = self->sl_bitmap[fl];
+	}
+	sl = (usize)ctz64(sl_map);
+	return self->blocks[fl][sl];
+}
+
+/*
+ * ==========================================================================
+ * 4. Split & Coalesce
+ * ==========================================================================
+ */
+
+/// flag `b` free, tell its physical successor, and file it in a list
+static void make_free(tlsf_t *self, tlsf_block_t *b)
+{
+	b->size |= BLOCK_FREE;
+	tlsf_block_t *next = block_next(b);
+	next->prev_phys = b;
+	next->size |= BLOCK_PREV_FREE;
+	insert_free(self, b);
+}
+
+/// flag a block (already out of its list) used
+static void make_used(tlsf_block_t *b)
+{
+	b->size &= ~BLOCK_FREE;
+	block_next(b)->size &= ~BLOCK_PREV_FREE;
+}
+
+/// grow `b` over its physical successor `next`
+static void absorb(tlsf_block_t *b, tlsf_block_t *next)
+{
+	block_set_size(b, block_size(b) + BLOCK_HDR + block_size(next));
+	block_next(b)->prev_phys = b;
+}
+
+static tlsf_block_t *merge_prev(tlsf_t *self, tlsf_block_t *b)
+{
+	if (block_is_prev_free(b)) {
+		tlsf_block_t *prev = b->prev_phys;
+		remove_free(self, prev);
+		absorb(prev, b);
+		b = prev;
+	}
+	return b;
+}
+
+static tlsf_block_t *merge_next(tlsf_t *self, tlsf_block_t *b)
+{
+	tlsf_block_t *next = block_next(b);
+	if (block_is_free(next)) {
+		remove_free(self, next);
+		absorb(b, next);
+	}
+	return b;
+}
+
+/// give the tail of a used block beyond `size` back to the free lists
+static void trim_used(tlsf_t *self, tlsf_block_t *b, usize size)
+{
+	if (block_size(b) < size + MIN_BLOCK)
+		return;
+
+	tlsf_block_t *rest = (tlsf_block_t *)(block_payload(b) + size);
+	rest->size = block_size(b) - size - BLOCK_HDR; /// prev (b) is used
+	rest->prev_phys = b;
+	block_set_size(b, size);
+	block_next(rest)->prev_phys = rest;
+
+	make_free(self, merge_next(self, rest));
+}
+
+/// free the head of a used block so its payload lands on `align`
+static tlsf_block_t *trim_leading(tlsf_t *self, tlsf_block_t *b, usize align)
+{
+	uptr p = (uptr)block_payload(b);
+	uptr aligned = align_up(p, align);
+	usize gap = aligned - p;
+	if (gap == 0)
+		return b;
+	if (gap < MIN_BLOCK) {
+		aligned = align_up(p + MIN_BLOCK, align);
+		gap = aligned - p;
+	}
+
+	tlsf_block_t *rest = block_from_ptr((anyptr)aligned);
+	rest->size = block_size(b) - gap;
+	rest->prev_phys = b;
+	block_set_size(b, gap - BLOCK_HDR);
+	block_next(rest)->prev_phys = rest;
+
+	/// the predecessor of `b` is used (free blocks never touch)
+	make_free(self, b);
+	return rest;
+}
+
+/*
+ * ==========================================================================
+ * 5. Regions
+ * ==========================================================================
+ */
+
+/**
+ * Memory Layout:
+ * [ region | block ......................................... | sentinel ]
+ *
+ * The sentinel is a zero-sized used header, so coalescing stops at the end
+ * of the region; the first block has no free predecessor.
+ */
+static bool add_region(tlsf_t *self, usize size)
+{
+	/// the free block must map to a list (`search` may be past MAX_ALLOC)
+	if (size > MAX_REGION - REGION_HDR - 2 * BLOCK_HDR)
+		return false;
+	usize need = align_up(mapping_round(size), TLSF_ALIGN);
+	usize bytes = REGION_HDR + BLOCK_HDR + need + BLOCK_HDR;
+	if (bytes > MAX_REGION)
+		return false;
+	if (bytes < self->region_size)
+		bytes = self->region_size;
+
+	tlsf_region_t *r = (tlsf_region_t *)allocer_alloc(
+		self->backing, layout(bytes, TLSF_ALIGN));
+	if (!r)
+		return false;
+
+	r->size = bytes;
+	r->next = self->regions;
+	self->regions = r;
+	self->region_count++;
+
+	tlsf_block_t *b = (tlsf_block_t *)((u8 *)r + REGION_HDR);
+	b->prev_phys = nullptr;
+	b->size = bytes - REGION_HDR - 2 * BLOCK_HDR;
+
+	tlsf_block_t *sentinel = block_next(b);
+	sentinel->size = 0;
+
+	make_free(self, b);
+	return true;
+}
+
+static void reset_lists(tlsf_t *self)
+{
+	self->fl_bitmap = 0;
+	memset(self->sl_bitmap, 0, sizeof(self->sl_bitmap));
+	memset(self->blocks, 0, sizeof(self->blocks));
+}
+
+/*
+ * ==========================================================================
+ * 6. Public API Implementation
+ * ==========================================================================
+ */
+
+void tlsf_init(tlsf_t *self, allocer_t backing, usize region_size)
+{
+	massert(self != nullptr, "tlsf_t cannot be NULL");
+	if (region_size == 0)
+		region_size = DEFAULT_REGION_SIZE;
+
+	self->backing = backing;
+	self->regions = nullptr;
+	self->region_count = 0;
+	if (region_size > MAX_REGION)
+		region_size = MAX_REGION;
+	self->region_size = align_up(region_size, TLSF_ALIGN);
+	reset_lists(self);
+}
+
+void tlsf_deinit(tlsf_t *self)
+{
+	if (!self)
+		return;
+
+	tlsf_region_t *r = self->regions;
+	while (r) {
+		tlsf_region_t *next = r->next;
+		allocer_free(self->backing, r, layout(r->size, TLSF_ALIGN));
+		r = next;
+	}
+	self->regions = nullptr;
+	self->region_count = 0;
+	reset_lists(self);
+}
+
+tlsf_t *tlsf_new(allocer_t backing, usize region_size)
+{
+	tlsf_t *tlsf = (tlsf_t *)allocer_alloc(backing, layout_of(tlsf_t));
+	if (!tlsf)
+		return nullptr;
+
+	tlsf_init(tlsf, backing, region_size);
+	return tlsf;
+}
+
+void tlsf_drop(tlsf_t *self)
+{
+	if (self) {
+		allocer_t backing = self->backing; /// save backing
+		tlsf_deinit(self);
+		allocer_free(backing, self, layout_of(tlsf_t));
+	}
+}
+
+anyptr tlsf_alloc_layout(tlsf_t *self, layout_t layout)
+{
+	usize size = adjust_size(layout.size);
+	if (size == 0 || layout.align > MAX_ALLOC)
+		return nullptr;
+
+	/// over-aligned: search for enough slack to cut a leading free block
+	bool over_aligned = layout.align > TLSF_ALIGN;
+	usize search = over_aligned ? size + layout.align + MIN_BLOCK : size;
+
+	tlsf_block_t *b = find_suitable(self, search);
+	if (unlikely(b == nullptr)) {
+		if (!add_region(self, search))
+			return nullptr;
+		b = find_suitable(self, search);
+		massert(b != nullptr, "tlsf: fresh region does not fit");
+	}
+
+	remove_free(self, b);
+	make_used(b);
+	if (over_aligned)
+		b = trim_leading(self, b, layout.align);
+	trim_used(self, b, size);
+	return (anyptr)block_payload(b);
+}
+
+anyptr tlsf_alloc(tlsf_t *self, usize size, usize align)
+{
+	return tlsf_alloc_layout(self, layout(size, align));
+}
+
+void tlsf_free(tlsf_t *self, anyptr ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	tlsf_block_t *b = block_from_ptr(ptr);
+	massert(!block_is_free(b), "tlsf: double free");
+
+	b = merge_prev(self, b);
+	b = merge_next(self, b);
+	make_free(self, b);
+}
+
+anyptr tlsf_realloc(tlsf_t *self, anyptr ptr, usize new_size, usize align)
+{
+	if (ptr == nullptr) {
+		return tlsf_alloc(self, new_size, align);
+	}
+	if (new_size == 0) {
+		tlsf_free(self, ptr);
+		return nullptr;
+	}
+
+	usize need = adjust_size(new_size);
+	if (need == 0)
+		return nullptr;
+
+	tlsf_block_t *b = block_from_ptr(ptr);
+	usize cur = block_size(b);
+
+	if (align <= TLSF_ALIGN || is_aligned((uptr)ptr, align)) {
+		/// 1. shrink (or same size): cut the tail
+		if (need <= cur) {
+			trim_used(self, b, need);
+			return ptr;
+		}
+
+		/// 2. grow: take over the free successor
+		tlsf_block_t *next = block_next(b);
+		if (block_is_free(next) &&
+		    cur + BLOCK_HDR + block_size(next) >= need) {
+			remove_free(self, next);
+			absorb(b, next);
+			block_next(b)->size &= ~BLOCK_PREV_FREE;
+			trim_used(self, b, need);
+			return ptr;
+		}
+	}
+
+	/// 3. move
+	anyptr new_ptr = tlsf_alloc(self, new_size, align);
+	if (new_ptr) {
+		memcpy(new_ptr, ptr, min(cur, new_size));
+		tlsf_free(self, ptr);
+	}
+	return new_ptr;
+}
+
+usize tlsf_block_size(anyptr ptr)
+{
+	return ptr ? block_size(block_from_ptr(ptr)) : 0;
+}
+
+/*
+ * ==========================================================================
+ * 7. Integrity Check
+ * ==========================================================================
+ */
+
+static bool in_list(const tlsf_t *self, const tlsf_block_t *b)
+{
+	usize fl, sl;
+	mapping_insert(block_size(b), &fl, &sl);
+	if (!(self->fl_bitmap & ((u64)1 << fl)) ||
+	    !(self->sl_bitmap[fl] & ((u32)1 << sl)))
+		return false;
+
+	for (tlsf_block_t *it = self->blocks[fl][sl]; it; it = it->next_free) {
+		if (it == b)
+			return true;
+	}
+	return false;
+}
+
+bool tlsf_check(const tlsf_t *self)
+{
+	usize walked_free = 0;
+
+	for (tlsf_region_t *r = self->regions; r; r = r->next) {
+		u8 *end = (u8 *)r + r->size;
+		tlsf_block_t *prev = nullptr;
+		tlsf_block_t *b = (tlsf_block_t *)((u8 *)r + REGION_HDR);
+
+		for (;;) {
+			if ((u8 *)b + BLOCK_HDR > end || b->prev_phys != prev)
+				return false;
+			bool prev_free = prev && block_is_free(prev);
+			if (block_is_prev_free(b) != prev_free)
+				return false;
+
+			if (block_size(b) == 0) { /// sentinel
+				if (block_is_free(b) || (u8 *)b + BLOCK_HDR != end)
+					return false;
+				break;
+			}
+
+			if (block_is_free(b)) {
+				/// free neighbours must have been coalesced
+				if (prev_free || !in_list(self, b))
+					return false;
+				walked_free++;
+			}
+			prev = b;
+			b = block_next(b);
+		}
+	}
+
+	/// every listed block is free and was reached by the walk
+	usize listed_free = 0;
+	for (usize fl = 0; fl < TLSF_FL_COUNT; ++fl) {
+		for (usize sl = 0; sl < TLSF_SL_COUNT; ++sl) {
+			tlsf_block_t *it = self->blocks[fl][sl];
+			if ((it != nullptr) !=
+			    ((self->sl_bitmap[fl] >> sl) & 1))
+				return false;
+			for (; it; it = it->next_free) {
+				if (!block_is_free(it))
+					return false;
+				listed_free++;
+			}
+		}
+	}
+	return listed_free == walked_free;
+}
+
+/*
+ * ==========================================================================
+ * 8. V-Table Implementation & Adapter
+ * ==========================================================================
+ */
+
+static anyptr _tlsf_vt_alloc(anyptr self, layout_t layout)
+{
+	return tlsf_alloc_layout((tlsf_t *)self, layout);
+}
+
+static void _tlsf_vt_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	(void)layout;
+	tlsf_free((tlsf_t *)self, ptr);
+}
+
+static anyptr _tlsf_vt_realloc(anyptr self, anyptr ptr, layout_t old,
+			       layout_t new_l)
+{
+	(void)old;
+	return tlsf_realloc((tlsf_t *)self, ptr, new_l.size, new_l.align);
+}
+
+static anyptr _tlsf_vt_zalloc(anyptr self, layout_t layout)
+{
+	anyptr ptr = tlsf_alloc_layout((tlsf_t *)self, layout);
+	if (ptr && layout.size > 0) {
+		memset(ptr, 0, layout.size);
+	}
+	return ptr;
+}
+
+static const allocer_vtable_t TLSF_VTABLE = {
+	.alloc = _tlsf_vt_alloc,
+	.free = _tlsf_vt_free,
+	.realloc = _tlsf_vt_realloc,
+	.zalloc = _tlsf_vt_zalloc,
+};
+
+allocer_t tlsf_allocer(tlsf_t *self)
+{
+	massert(self != nullptr, "tlsf_t cannot be NULL");
+	return (allocer_t){ .self = self, .vtable = &TLSF_VTABLE };
+}
@@ -0,0 +1,514 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/allocers/tracking.h>
+#include <core/msg.h> /// for massert
+#include <core/math.h> /// for align_up, clz64, checked_add
+#include <core/hash.h> /// for hash_bytes
+#include <string.h> /// for memcpy, memset, strcmp, strlen
+
+/// set by the `allocer_*` macros when built with FLUF_TRACK_ALLOC_SITES
+thread_local alloc_site_t allocer_site;
+
+/*
+ * ==========================================================================
+ * 1. Block Header
+ * ==========================================================================
+ * Memory Layout:
+ * [ padding ... | site index (u32) ][ user data ... ]
+ * ^                                 ^
+ * backing block                     user pointer (backing + offset)
+ */
+
+#define HEADER_MIN 16
+
+static inline usize header_offset(usize align)
+{
+	return align > HEADER_MIN ? align : HEADER_MIN;
+}
+
+/// layout of the backing block; false on overflow
+static inline bool backing_layout(layout_t user, layout_t *out)
+{
+	usize size;
+	if (checked_add(user.size, header_offset(user.align), &size))
+		return false;
+	*out = layout(size, user.align);
+	return true;
+}
+
+static inline u32 header_read(const u8 *user)
+{
+	u32 idx;
+	memcpy(&idx, user - sizeof(u32), sizeof(u32));
+	return idx;
+}
+
+static inline void header_write(u8 *user, u32 idx)
+{
+	memcpy(user - sizeof(u32), &idx, sizeof(u32));
+}
+
+/*
+ * ==========================================================================
+ * 2. Statistics
+ * ==========================================================================
+ */
+
+static void lock(tracking_t *self)
+{
+	while (__atomic_exchange_n(&self->lock, 1, __ATOMIC_ACQUIRE)) {
+		while (__atomic_load_n(&self->lock, __ATOMIC_RELAXED))
+			;
+	}
+}
+
+static void unlock(tracking_t *self)
+{
+	__atomic_store_n(&self->lock, 0, __ATOMIC_RELEASE);
+}
+
+/// consume the site recorded by the caller's `allocer_*` macro
+static alloc_site_t take_site(void)
+{
+	alloc_site_t site = allocer_site;
+	allocer_site = (alloc_site_t){ 0 };
+	return site;
+}
+
+static bool site_eq(alloc_site_t a, alloc_site_t b)
+{
+	if (a.line != b.line)
+		return false;
+	if (a.file == b.file)
+		return true;
+	return a.file && b.file && strcmp(a.file, b.file) == 0;
+}
+
+static usize site_hash(alloc_site_t s)
+{
+	u64 h = s.file ? hash_bytes(s.file, strlen(s.file)) : 0;
+	return (usize)(h ^ ((u64)s.line * 0x9E3779B97F4A7C15ull));
+}
+
+/// find or claim the slot for `site` (called with the lock held)
+static u32 site_index(tracking_t *self, alloc_site_t site)
+{
+	usize mask = TRACKING_MAX_SITES - 1;
+	usize i = site_hash(site) & mask;
+	for (;;) {
+		tracking_site_t *s = &self->sites[i];
+		if (!s->used) {
+			/// keep the last free slot for "unknown"
+			if (self->site_count + 1 >= TRACKING_MAX_SITES &&
+			    site.file != nullptr)
+				return site_index(self, (alloc_site_t){ 0 });
+			*s = (tracking_site_t){ .site = site, .used = true };
+			self->site_count++;
+			return (u32)i;
+		}
+		if (site_eq(s->site, site))
+			return (u32)i;
+		i = (i + 1) & mask;
+	}
+}
+
+static inline usize hist_bucket(usize size)
+{
+	if (size <= 1)
+		return 0;
+	usize b = (usize)(64 - clz64((u64)(size - 1)));
+	return b < TRACKING_HIST_BUCKETS ? b : TRACKING_HIST_BUCKETS - 1;
+}
+
+static void account_alloc(tracking_t *self, tracking_site_t *s, usize size)
+{
+	tracking_stats_t *st = &self->stats;
+	st->allocs++;
+	st->total_bytes += size;
+	st->live_bytes += size;
+	if (st->live_bytes > st->peak_bytes)
+		st->peak_bytes = st->live_bytes;
+	st->histogram[hist_bucket(size)]++;
+
+	s->allocs++;
+	s->total_bytes += size;
+	s->live_bytes += size;
+	if (s->live_bytes > s->peak_bytes)
+		s->peak_bytes = s->live_bytes;
+}
+
+static void account_free(tracking_t *self, tracking_site_t *s, usize size)
+{
+	self->stats.frees++;
+	self->stats.live_bytes -= size;
+	s->frees++;
+	s->live_bytes -= size;
+}
+
+/// an in-place or moved realloc: same block, new size
+static void account_resize(tracking_t *self, tracking_site_t *s, usize old_size,
+			   usize new_size)
+{
+	tracking_stats_t *st = &self->stats;
+	st->live_bytes = st->live_bytes - old_size + new_size;
+	s->live_bytes = s->live_bytes - old_size + new_size;
+	if (new_size > old_size) {
+		st->total_bytes += new_size - old_size;
+		s->total_bytes += new_size - old_size;
+	}
+	if (st->live_bytes > st->peak_bytes)
+		st->peak_bytes = st->live_bytes;
+	if (s->live_bytes > s->peak_bytes)
+		s->peak_bytes = s->live_bytes;
+	st->histogram[hist_bucket(new_size)]++;
+}
+
+/*
+ * ==========================================================================
+ * 3. Allocation Paths
+ * ==========================================================================
+ */
+
+static anyptr tracked_alloc(tracking_t *self, layout_t layout, bool zeroed)
+{
+	alloc_site_t site = take_site();
+
+	layout_t bl;
+	u8 *base = nullptr;
+	if (backing_layout(layout, &bl)) {
+		base = (u8 *)(zeroed ? allocer_zalloc(self->backing, bl) :
+				       allocer_alloc(self->backing, bl));
+	}
+
+	lock(self);
+	if (!base) {
+		self->stats.failures++;
+		unlock(self);
+		return nullptr;
+	}
+	u32 idx = site_index(self, site);
+	account_alloc(self, &self->sites[idx], layout.size);
+	unlock(self);
+
+	u8 *user = base + header_offset(layout.align);
+	header_write(user, idx);
+	return (anyptr)user;
+}
+
+static void tracked_free(tracking_t *self, anyptr ptr, layout_t layout)
+{
+	take_site();
+	if (ptr == nullptr)
+		return;
+
+	u8 *user = (u8 *)ptr;
+	u32 idx = header_read(user);
+
+	lock(self);
+	account_free(self, &self->sites[idx], layout.size);
+	unlock(self);
+
+	layout_t bl;
+	(void)backing_layout(layout, &bl); /// cannot overflow: it was allocated
+	allocer_free(self->backing, user - header_offset(layout.align), bl);
+}
+
+static anyptr tracked_realloc(tracking_t *self, anyptr ptr, layout_t old,
+			      layout_t new_l)
+{
+	if (ptr == nullptr)
+		return tracked_alloc(self, new_l, false);
+	if (new_l.size == 0) {
+		tracked_free(self, ptr, old);
+		return nullptr;
+	}
+
+	usize off = header_offset(old.align);
+	if (off != header_offset(new_l.align)) {
+		/// the header moves: alloc + copy + free, keeping the site
+		take_site();
+		lock(self);
+		allocer_site = self->sites[header_read((u8 *)ptr)].site;
+		unlock(self);
+		anyptr new_ptr = tracked_alloc(self, new_l, false);
+		if (new_ptr) {
+			memcpy(new_ptr, ptr, min(old.size, new_l.size));
+			tracked_free(self, ptr, old);
+		}
+		return new_ptr;
+	}
+	take_site(); /// the block keeps the site that allocated it
+
+	layout_t old_bl, new_bl;
+	u8 *base = nullptr;
+	if (backing_layout(old, &old_bl) && backing_layout(new_l, &new_bl)) {
+		base = (u8 *)allocer_realloc(self->backing, (u8 *)ptr - off,
+					     old_bl, new_bl);
+	}
+
+	lock(self);
+	if (!base) {
+		self->stats.failures++;
+		unlock(self);
+		return nullptr;
+	}
+	u8 *user = base + off;
+	tracking_site_t *s = &self->sites[header_read(user)];
+	self->stats.reallocs++;
+	account_resize(self, s, old.size, new_l.size);
+	unlock(self);
+	return (anyptr)user;
+}
+
+/*
+ * ==========================================================================
+ * 4. Public API Implementation
+ * ==========================================================================
+ */
+
+void tracking_init(tracking_t *self, allocer_t backing)
+{
+	massert(self != nullptr, "tracking_t cannot be NULL");
+	self->backing = backing;
+	self->lock = 0;
+	tracking_reset(self);
+}
+
+void tracking_reset(tracking_t *self)
+{
+	lock(self);
+	memset(&self->stats, 0, sizeof(self->stats));
+	memset(self->sites, 0, sizeof(self->sites));
+	self->site_count = 0;
+	unlock(self);
+}
+
+tracking_t *tracking_new(allocer_t backing)
+{
+	tracking_t *tr = (tracking_t *)allocer_alloc(backing,
+						     layout_of(tracking_t));
+	if (!tr)
+		return nullptr;
+
+	tracking_init(tr, backing);
+	return tr;
+}
+
+void tracking_drop(tracking_t *self)
+{
+	if (self) {
+		allocer_free(self->backing, self, layout_of(tracking_t));
+	}
+}
+
+tracking_stats_t tracking_stats(tracking_t *self)
+{
+	lock(self);
+	tracking_stats_t st = self->stats;
+	unlock(self);
+	return st;
+}
+
+bool tracking_site(tracking_t *self, const char *file, u32 line,
+		   tracking_site_t *out)
+{
+	alloc_site_t key = { .file = file, .line = line };
+	bool found = false;
+
+	lock(self);
+	for (usize i = 0; i < TRACKING_MAX_SITES; ++i) {
+		if (self->sites[i].used && site_eq(self->sites[i].site, key)) {
+			*out = self->sites[i];
+			found = true;
+			break;
+		}
+	}
+	unlock(self);
+	return found;
+}
+
+/*
+ * ==========================================================================
+ * 5. Reports
+ * ==========================================================================
+ */
+
+/// copy the used sites, sorted by live bytes (descending)
+static usize sorted_sites(tracking_t *self, tracking_site_t *out)
+{
+	usize n = 0;
+	lock(self);
+	for (usize i = 0; i < TRACKING_MAX_SITES; ++i) {
+		if (!self->sites[i].used)
+			continue;
+		tracking_site_t s = self->sites[i];
+		usize j = n++;
+		while (j > 0 && out[j - 1].live_bytes < s.live_bytes) {
+			out[j] = out[j - 1];
+			j--;
+		}
+		out[j] = s;
+	}
+	unlock(self);
+	return n;
+}
+
+#define SITES_LAYOUT layout_of_array(tracking_site_t, TRACKING_MAX_SITES)
+
+/// sorted sites for one report, in a buffer borrowed from `backing`
+static tracking_site_t *report_sites(tracking_t *self, usize *n)
+{
+	tracking_site_t *sites =
+		(tracking_site_t *)allocer_alloc(self->backing, SITES_LAYOUT);
+	*n = sites ? sorted_sites(self, sites) : 0;
+	return sites;
+}
+
+static void release_sites(tracking_t *self, tracking_site_t *sites)
+{
+	if (sites)
+		allocer_free(self->backing, sites, SITES_LAYOUT);
+}
+
+static const char *site_file(const tracking_site_t *s)
+{
+	return s->site.file ? s->site.file : "<unknown>";
+}
+
+void tracking_report(tracking_t *self, FILE *out)
+{
+	tracking_stats_t st = tracking_stats(self);
+	usize n;
+	tracking_site_t *sites = report_sites(self, &n);
+
+	fprintf(out, "allocations: %zu allocs, %zu frees, %zu reallocs, %zu failed\n",
+		st.allocs, st.frees, st.reallocs, st.failures);
+	fprintf(out, "bytes: %zu live, %zu peak, %zu total\n", st.live_bytes,
+		st.peak_bytes, st.total_bytes);
+
+	fprintf(out, "size histogram:\n");
+	for (usize i = 0; i < TRACKING_HIST_BUCKETS; ++i) {
+		if (st.histogram[i] == 0)
+			continue;
+		fprintf(out, "  <= %-12zu %zu\n", (usize)1 << i, st.histogram[i]);
+	}
+
+	fprintf(out, "call sites (by live bytes):\n");
+	for (usize i = 0; i < n; ++i) {
+		const tracking_site_t *s = &sites[i];
+		fprintf(out,
+			"  %s:%u  live=%zu peak=%zu total=%zu allocs=%zu frees=%zu\n",
+			site_file(s), s->site.line, s->live_bytes, s->peak_bytes,
+			s->total_bytes, s->allocs, s->frees);
+	}
+	release_sites(self, sites);
+}
+
+static void json_str(FILE *out, const char *s)
+{
+	fputc('"', out);
+	for (; *s; ++s) {
+		u8 c = (u8)*s;
+		if (c == '"' || c == '\\')
+			fprintf(out, "\\%c", c);
+		else if (c < 0x20)
+			fprintf(out, "\\u%04x", c);
+		else
+			fputc(c, out);
+	}
+	fputc('"', out);
+}
+
+void tracking_dump_json(tracking_t *self, FILE *out)
+{
+	tracking_stats_t st = tracking_stats(self);
+	usize n;
+	tracking_site_t *sites = report_sites(self, &n);
+
+	fprintf(out,
+		"{\"allocs\":%zu,\"frees\":%zu,\"reallocs\":%zu,\"failures\":%zu,"
+		"\"live_bytes\":%zu,\"peak_bytes\":%zu,\"total_bytes\":%zu,",
+		st.allocs, st.frees, st.reallocs, st.failures, st.live_bytes,
+		st.peak_bytes, st.total_bytes);
+
+	fprintf(out, "\"histogram\":[");
+	bool first = true;
+	for (usize i = 0; i < TRACKING_HIST_BUCKETS; ++i) {
+		if (st.histogram[i] == 0)
+			continue;
+		fprintf(out, "%s{\"le\":%zu,\"count\":%zu}", first ? "" : ",",
+			(usize)1 << i, st.histogram[i]);
+		first = false;
+	}
+
+	fprintf(out, "],\"sites\":[");
+	for (usize i = 0; i < n; ++i) {
+		const tracking_site_t *s = &sites[i];
+		fprintf(out, "%s{\"file\":", i ? "," : "");
+		if (s->site.file)
+			json_str(out, s->site.file);
+		else
+			fprintf(out, "null");
+		fprintf(out,
+			",\"line\":%u,\"allocs\":%zu,\"frees\":%zu,"
+			"\"live_bytes\":%zu,\"peak_bytes\":%zu,\"total_bytes\":%zu}",
+			s->site.line, s->allocs, s->frees, s->live_bytes,
+			s->peak_bytes, s->total_bytes);
+	}
+	fprintf(out, "]}\n");
+	release_sites(self, sites);
+}
+
+/*
+ * ==========================================================================
+ * 6. V-Table Implementation & Adapter
+ * ==========================================================================
+ */
+
+static anyptr _tracking_vt_alloc(anyptr self, layout_t layout)
+{
+	return tracked_alloc((tracking_t *)self, layout, false);
+}
+
+static void _tracking_vt_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	tracked_free((tracking_t *)self, ptr, layout);
+}
+
+static anyptr _tracking_vt_realloc(anyptr self, anyptr ptr, layout_t old,
+				   layout_t new_l)
+{
+	return tracked_realloc((tracking_t *)self, ptr, old, new_l);
+}
+
+static anyptr _tracking_vt_zalloc(anyptr self, layout_t layout)
+{
+	return tracked_alloc((tracking_t *)self, layout, true);
+}
+
+static const allocer_vtable_t TRACKING_VTABLE = {
+	.alloc = _tracking_vt_alloc,
+	.free = _tracking_vt_free,
+	.realloc = _tracking_vt_realloc,
+	.zalloc = _tracking_vt_zalloc,
+};
+
+allocer_t tracking_allocer(tracking_t *self)
+{
+	massert(self != nullptr, "tracking_t cannot be NULL");
+	return (allocer_t){ .self = self, .vtable = &TRACKING_VTABLE };
+}
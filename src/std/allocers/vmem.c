@@ -0,0 +1,337 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/allocers/vmem.h>
+#include <core/msg.h> /// for massert
+#include <core/math.h> /// for align_up, checked_add
+#include <core/macros.h> /// for unused, likely
+#include <string.h> /// for memcpy, memset
+
+/*
+ * ==========================================================================
+ * 1. Constants
+ * ==========================================================================
+ */
+
+/// commit at least this much at once to amortize syscalls
+#define VMEM_COMMIT_STEP (64 * 1024)
+
+/// transparent huge page size (x86-64 / aarch64 with 4K base pages)
+#define VMEM_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/*
+ * ==========================================================================
+ * 2. Platform Specific Implementation
+ * ==========================================================================
+ */
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+
+static usize _vm_page_size(void)
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (usize)info.dwPageSize;
+}
+
+static u8 *_vm_reserve(usize size)
+{
+	return (u8 *)VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static void _vm_release(u8 *addr, usize size)
+{
+	unused(size);
+	VirtualFree(addr, 0, MEM_RELEASE);
+}
+
+static bool _vm_commit(u8 *addr, usize size)
+{
+	return VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+static void _vm_decommit(u8 *addr, usize size)
+{
+	VirtualFree(addr, size, MEM_DECOMMIT);
+}
+
+static void _vm_advise_huge(u8 *addr, usize size)
+{
+	/// large pages need special privileges on Windows; not supported
+	unused(addr);
+	unused(size);
+}
+
+#else
+/// POSIX (Linux, macOS, etc.)
+#include <sys/mman.h>
+#include <unistd.h>
+
+static usize _vm_page_size(void)
+{
+	long sz = sysconf(_SC_PAGESIZE);
+	return sz > 0 ? (usize)sz : 4096;
+}
+
+static u8 *_vm_reserve(usize size)
+{
+	/// PROT_NONE + MAP_NORESERVE: address space only, no memory, no swap
+	void *p = mmap(nullptr, size, PROT_NONE,
+		       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	return p == MAP_FAILED ? nullptr : (u8 *)p;
+}
+
+static void _vm_release(u8 *addr, usize size)
+{
+	munmap(addr, size);
+}
+
+static bool _vm_commit(u8 *addr, usize size)
+{
+	return mprotect(addr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+static void _vm_decommit(u8 *addr, usize size)
+{
+	/// give the physical pages back, then make the range inaccessible
+	madvise(addr, size, MADV_DONTNEED);
+	mprotect(addr, size, PROT_NONE);
+}
+
+static void _vm_advise_huge(u8 *addr, usize size)
+{
+#ifdef MADV_HUGEPAGE
+	madvise(addr, size, MADV_HUGEPAGE);
+#else
+	unused(addr);
+	unused(size);
+#endif
+}
+
+#endif
+
+/*
+ * ==========================================================================
+ * 3. Internal Helpers
+ * ==========================================================================
+ */
+
+/// make sure [base, need_end) is committed
+static bool commit_until(vmem_t *self, u8 *need_end)
+{
+	if (likely(need_end <= self->committed))
+		return true;
+
+	usize needed = (usize)(need_end - self->committed);
+	usize step = align_up(max(needed, self->commit_step), self->page_size);
+	usize available = (usize)(self->end - self->committed);
+	if (step > available)
+		step = available;
+
+	if (!_vm_commit(self->committed, step))
+		return false;
+
+	self->committed += step;
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * 4. Public API Implementation
+ * ==========================================================================
+ */
+
+bool vmem_init(vmem_t *self, usize reserve, u32 flags)
+{
+	massert(self != nullptr, "vmem_t cannot be NULL");
+
+	usize page = _vm_page_size();
+	bool huge = (flags & VMEM_HUGEPAGES) != 0;
+	usize base_align = huge ? VMEM_HUGE_PAGE_SIZE : page;
+
+	if (reserve == 0)
+		reserve = page;
+	if (checked_add(reserve, base_align - 1, &reserve))
+		return false;
+	reserve = align_down(reserve, base_align);
+
+	/// huge pages want a 2MB aligned base: over-reserve and align inside
+	usize map_size = reserve;
+	if (huge && checked_add(reserve, base_align, &map_size))
+		return false;
+
+	u8 *map_base = _vm_reserve(map_size);
+	if (!map_base)
+		return false;
+
+	u8 *base = (u8 *)align_up((uptr)map_base, base_align);
+
+	self->map_base = map_base;
+	self->map_size = map_size;
+	self->base = base;
+	self->ptr = base;
+	self->committed = base;
+	self->end = base + reserve;
+	self->page_size = page;
+	self->commit_step = huge ? VMEM_HUGE_PAGE_SIZE : VMEM_COMMIT_STEP;
+
+	if (huge)
+		_vm_advise_huge(base, reserve);
+
+	return true;
+}
+
+void vmem_deinit(vmem_t *self)
+{
+	if (self && self->map_base) {
+		_vm_release(self->map_base, self->map_size);
+		*self = (vmem_t){ 0 };
+	}
+}
+
+void vmem_reset(vmem_t *self)
+{
+	self->ptr = self->base;
+}
+
+void vmem_trim(vmem_t *self, usize keep)
+{
+	/// never decommit memory that is still handed out
+	usize used = vmem_used(self);
+	if (keep < used)
+		keep = used;
+
+	usize keep_aligned = align_up(keep, self->page_size);
+	if (keep_aligned >= vmem_committed(self))
+		return;
+
+	u8 *from = self->base + keep_aligned;
+	_vm_decommit(from, (usize)(self->committed - from));
+	self->committed = from;
+}
+
+anyptr vmem_alloc_layout(vmem_t *self, layout_t layout)
+{
+	/// handle alignment default
+	if (layout.align == 0 || !is_power_of_two(layout.align)) {
+		layout.align = 1;
+	}
+
+	u8 *result = (u8 *)align_up((uptr)self->ptr, layout.align);
+	if (result > self->end)
+		return nullptr;
+	if (layout.size > (usize)(self->end - result))
+		return nullptr; /// reservation exhausted
+
+	u8 *new_ptr = result + layout.size;
+	if (!commit_until(self, new_ptr))
+		return nullptr;
+
+	self->ptr = new_ptr;
+	return (anyptr)result;
+}
+
+anyptr vmem_alloc(vmem_t *self, usize size, usize align)
+{
+	return vmem_alloc_layout(self, layout(size, align));
+}
+
+anyptr vmem_realloc(vmem_t *self, anyptr old_ptr, usize old_size,
+		    usize new_size, usize align)
+{
+	if (old_ptr == nullptr) {
+		return vmem_alloc(self, new_size, align);
+	}
+	if (new_size == 0) {
+		vmem_free(self, old_ptr, old_size);
+		return nullptr;
+	}
+
+	u8 *old = (u8 *)old_ptr;
+	if (align == 0 || !is_power_of_two(align))
+		align = 1;
+
+	/// the tip grows (or shrinks) in place: the base never moves
+	if (old + old_size == self->ptr && is_aligned((uptr)old, align)) {
+		if (new_size > (usize)(self->end - old))
+			return nullptr;
+		if (!commit_until(self, old + new_size))
+			return nullptr;
+		self->ptr = old + new_size;
+		return old_ptr;
+	}
+
+	anyptr new_ptr = vmem_alloc(self, new_size, align);
+	if (new_ptr) {
+		memcpy(new_ptr, old_ptr, min(old_size, new_size));
+	}
+	return new_ptr;
+}
+
+void vmem_free(vmem_t *self, anyptr ptr, usize size)
+{
+	/// only the tip can be given back
+	if (ptr && (u8 *)ptr + size == self->ptr) {
+		self->ptr = (u8 *)ptr;
+	}
+}
+
+/*
+ * ==========================================================================
+ * 5. V-Table Implementation & Adapter
+ * ==========================================================================
+ */
+
+static anyptr _vmem_vt_alloc(anyptr self, layout_t layout)
+{
+	return vmem_alloc_layout((vmem_t *)self, layout);
+}
+
+static void _vmem_vt_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	vmem_free((vmem_t *)self, ptr, layout.size);
+}
+
+static anyptr _vmem_vt_realloc(anyptr self, anyptr ptr, layout_t old,
+			       layout_t new_l)
+{
+	return vmem_realloc((vmem_t *)self, ptr, old.size, new_l.size,
+			    new_l.align);
+}
+
+static anyptr _vmem_vt_zalloc(anyptr self, layout_t layout)
+{
+	/// fresh pages are zero, but pages reused after a reset are not
+	anyptr ptr = vmem_alloc_layout((vmem_t *)self, layout);
+	if (ptr && layout.size > 0) {
+		memset(ptr, 0, layout.size);
+	}
+	return ptr;
+}
+
+static const allocer_vtable_t VMEM_VTABLE = {
+	.alloc = _vmem_vt_alloc,
+	.free = _vmem_vt_free,
+	.realloc = _vmem_vt_realloc,
+	.zalloc = _vmem_vt_zalloc,
+};
+
+allocer_t vmem_allocer(vmem_t *self)
+{
+	massert(self != nullptr, "vmem_t cannot be NULL");
+	return (allocer_t){ .self = self, .vtable = &VMEM_VTABLE };
+}
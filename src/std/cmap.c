@@ -0,0 +1,251 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/cmap.h>
+#include <std/allocers/bump.h> /// for allocer_*_fast
+#include <core/math.h> /// for next_power_of_two, ctz64
+#include <sched.h> /// for sched_yield
+#include <string.h> /// for memcpy
+
+/*
+ * Internal Header Layout
+ */
+typedef struct {
+	_cmap_shard_t *shards;
+	usize shard_count;
+	u32 shard_shift;
+	allocer_t alc;
+	map_ops_t ops;
+	void *key_type;
+	void *val_type;
+} cmap_header_t;
+
+/*
+ * ==========================================================================
+ * Reader-Writer Spinlock
+ * ==========================================================================
+ * `lock` holds a writer bit and a reader count. A writer first claims the
+ * writer bit, which keeps new readers out, then waits for the readers
+ * already inside to leave: a steady stream of readers cannot starve it.
+ *
+ * Critical sections are one probe, but a holder can still be preempted
+ * when threads outnumber cores: after a while spinners yield their slice
+ * instead of burning it.
+ */
+
+#define WRITER (1u << 31)
+#define SPINS_BEFORE_YIELD 64
+
+static inline void _backoff(u32 *spins)
+{
+	if (++*spins >= SPINS_BEFORE_YIELD) {
+		*spins = 0;
+		sched_yield();
+	}
+}
+
+static void _read_lock(_cmap_shard_t *s)
+{
+	u32 spins = 0;
+	for (;;) {
+		u32 cur = __atomic_load_n(&s->lock, __ATOMIC_RELAXED);
+		if (!(cur & WRITER) &&
+		    __atomic_compare_exchange_n(&s->lock, &cur, cur + 1, true,
+						__ATOMIC_ACQUIRE,
+						__ATOMIC_RELAXED))
+			return;
+		_backoff(&spins);
+	}
+}
+
+static void _read_unlock(_cmap_shard_t *s)
+{
+	__atomic_fetch_sub(&s->lock, 1, __ATOMIC_RELEASE);
+}
+
+static void _write_lock(_cmap_shard_t *s)
+{
+	u32 spins = 0;
+	/// 1. claim the writer bit
+	while (__atomic_fetch_or(&s->lock, WRITER, __ATOMIC_ACQUIRE) & WRITER)
+		_backoff(&spins);
+	/// 2. wait for the readers inside to drain
+	while (__atomic_load_n(&s->lock, __ATOMIC_ACQUIRE) != WRITER)
+		_backoff(&spins);
+}
+
+static void _write_unlock(_cmap_shard_t *s)
+{
+	__atomic_store_n(&s->lock, 0, __ATOMIC_RELEASE);
+}
+
+/*
+ * ==========================================================================
+ * Sharding
+ * ==========================================================================
+ */
+
+/// shard of `hash`: the bits right below H2 (bits 57..63)
+static inline _cmap_shard_t *_shard_of(cmap_header_t *m, u64 hash)
+{
+	usize i = (usize)(hash >> m->shard_shift) & (m->shard_count - 1);
+	return &m->shards[i];
+}
+
+static inline layout_t shards_layout(usize count)
+{
+	return layout(count * sizeof(_cmap_shard_t), alignof(_cmap_shard_t));
+}
+
+/*
+ * ==========================================================================
+ * Public Implementation
+ * ==========================================================================
+ */
+
+bool _cmap_init_impl(anyptr map, allocer_t alc, map_ops_t ops, usize shards,
+		     usize k_sz, usize v_sz)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	usize count = shards <= 1 ? 1 : next_power_of_two(shards);
+	massert(count <= 1u << 16, "cmap: too many shards");
+
+	layout_t l = shards_layout(count);
+	m->shards = (_cmap_shard_t *)allocer_alloc_fast(alc, l);
+	if (!m->shards)
+		return false;
+	m->shard_count = count;
+	m->shard_shift = 57 - (u32)ctz64(count);
+	m->alc = alc;
+	m->ops = ops;
+	m->key_type = nullptr;
+	m->val_type = nullptr;
+
+	for (usize i = 0; i < count; ++i) {
+		m->shards[i].lock = 0;
+		/// never incremental: readers share a shard, lookups must not
+		/// move entries
+		if (!_map_init_impl(&m->shards[i].map, alc, ops, k_sz, v_sz,
+				    false))
+			return false;
+	}
+	return true;
+}
+
+void _cmap_deinit_impl(anyptr map)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	if (!m->shards)
+		return;
+	for (usize i = 0; i < m->shard_count; ++i)
+		map_deinit(m->shards[i].map);
+	allocer_free_fast(m->alc, m->shards, shards_layout(m->shard_count));
+	m->shards = nullptr;
+	m->shard_count = 0;
+}
+
+bool _cmap_put_impl(anyptr map, const void *k_ptr, const void *v_ptr)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	u64 hash = m->ops.hash(k_ptr);
+	_cmap_shard_t *s = _shard_of(m, hash);
+
+	_write_lock(s);
+	bool ok = _map_put_hashed_impl(&s->map, k_ptr, v_ptr, hash);
+	_write_unlock(s);
+	return ok;
+}
+
+bool _cmap_get_impl(anyptr map, const void *k_ptr, void *out)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	u64 hash = m->ops.hash(k_ptr);
+	_cmap_shard_t *s = _shard_of(m, hash);
+
+	_read_lock(s);
+	void *val = _map_get_hashed_impl(&s->map, k_ptr, hash);
+	if (val && out)
+		memcpy(out, val, s->map.val_size);
+	_read_unlock(s);
+	return val != nullptr;
+}
+
+bool _cmap_get_or_put_impl(anyptr map, const void *k_ptr, const void *v_ptr,
+			   void *out, bool *inserted)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	u64 hash = m->ops.hash(k_ptr);
+	_cmap_shard_t *s = _shard_of(m, hash);
+
+	/// the common case for a warm table: found under the shared lock
+	_read_lock(s);
+	void *val = _map_get_hashed_impl(&s->map, k_ptr, hash);
+	if (val && out)
+		memcpy(out, val, s->map.val_size);
+	_read_unlock(s);
+	if (val) {
+		if (inserted)
+			*inserted = false;
+		return true;
+	}
+
+	/// absent: check again under the write lock, someone may have won
+	_write_lock(s);
+	bool ok = true;
+	val = _map_get_hashed_impl(&s->map, k_ptr, hash);
+	if (inserted)
+		*inserted = val == nullptr;
+	if (val)
+		v_ptr = val;
+	else
+		ok = _map_put_hashed_impl(&s->map, k_ptr, v_ptr, hash);
+	if (ok && out)
+		memcpy(out, v_ptr, s->map.val_size);
+	_write_unlock(s);
+	return ok;
+}
+
+bool _cmap_remove_impl(anyptr map, const void *k_ptr)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	u64 hash = m->ops.hash(k_ptr);
+	_cmap_shard_t *s = _shard_of(m, hash);
+
+	_write_lock(s);
+	bool found = _map_remove_hashed_impl(&s->map, k_ptr, hash);
+	_write_unlock(s);
+	return found;
+}
+
+void _cmap_clear_impl(anyptr map)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	for (usize i = 0; i < m->shard_count; ++i) {
+		_write_lock(&m->shards[i]);
+		map_clear(m->shards[i].map);
+		_write_unlock(&m->shards[i]);
+	}
+}
+
+usize _cmap_len_impl(anyptr map)
+{
+	cmap_header_t *m = (cmap_header_t *)map;
+	usize len = 0;
+	for (usize i = 0; i < m->shard_count; ++i)
+		len += __atomic_load_n(&m->shards[i].map.len,
+				       __ATOMIC_RELAXED);
+	return len;
+}
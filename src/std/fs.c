@@ -23,6 +23,8 @@
 #include <windows.h>
 #else
 #include <sys/stat.h>
+#include <sys/mman.h> /// for mmap, madvise
+#include <fcntl.h> /// for open
 #include <unistd.h>
 #endif
 
@@ -198,3 +200,84 @@ bool file_append(const char *path, str_t content)
 	fclose(f);
 	return success;
 }
+
+/*
+ * ==========================================================================
+ * Fingerprint Ops
+ * ==========================================================================
+ */
+
+/// small enough for any thread's stack; a pipe rarely holds more anyway
+#define FINGERPRINT_CHUNK (16 * 1024)
+
+/// the portable path: fixed buffer, no matter how large the file is
+static bool fingerprint_stream(FILE *f, hash128_t *out)
+{
+	u8 chunk[FINGERPRINT_CHUNK];
+	hasher128_t h;
+	hasher128_init(&h);
+
+	usize n;
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+		hasher128_update(&h, chunk, n);
+	if (ferror(f))
+		return false;
+
+	*out = hasher128_finish(&h);
+	return true;
+}
+
+#if !defined(_WIN32)
+/**
+ * regular files: hash the page cache in place; false means "try streaming".
+ * If another process truncates the file while it is mapped, touching the
+ * pages past the new end raises SIGBUS (see the warning in fs.h).
+ */
+static bool fingerprint_mapped(int fd, hash128_t *out)
+{
+	struct stat s;
+	if (fstat(fd, &s) != 0 || !S_ISREG(s.st_mode) || s.st_size <= 0)
+		return false;
+	if ((u64)s.st_size > (u64)SIZE_MAX)
+		return false;
+
+	usize size = (usize)s.st_size;
+	void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED)
+		return false;
+	/// one front-to-back pass: ask for aggressive read-ahead
+	madvise(data, size, MADV_SEQUENTIAL);
+
+	*out = hash128_bytes(data, size);
+	munmap(data, size);
+	return true;
+}
+#endif
+
+bool file_fingerprint(const char *path, hash128_t *out)
+{
+	if (!path || !out)
+		return false;
+
+#if defined(_WIN32)
+	FILE *f = fopen(path, "rb");
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+	if (fingerprint_mapped(fd, out)) {
+		close(fd);
+		return true;
+	}
+	/// same descriptor: a pipe cannot be opened a second time
+	FILE *f = fdopen(fd, "rb");
+	if (!f)
+		close(fd);
+#endif
+	if (!f)
+		return false;
+
+	bool ok = fingerprint_stream(f, out);
+	fclose(f);
+	return ok;
+}
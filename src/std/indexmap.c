@@ -0,0 +1,297 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/indexmap.h>
+#include <std/map/group.h> /// for the control group primitives
+#include <std/allocers/bump.h> /// for allocer_*_fast
+#include <core/math.h> /// for ctz64, checked_add
+#include <string.h> /// for memcpy, memset
+
+/*
+ * Internal Header Layout
+ */
+typedef struct {
+	struct {
+		u8 *data;
+		usize len;
+		usize cap;
+		allocer_t alc;
+	} entries;
+	u8 *ctrl;
+	u32 *slots;
+	usize cap;
+	usize occupied; /// len + deleted
+	map_ops_t ops;
+	usize entry_size;
+	usize entry_align;
+	usize key_off;
+	usize key_size;
+	usize val_off;
+	usize val_size;
+} indexmap_header_t;
+
+/// slots hold u32 positions, (u32)-1 is never a valid one
+#define MAX_ENTRIES ((usize)UINT32_MAX - 1)
+
+static inline u8 *_entry(indexmap_header_t *m, usize i)
+{
+	return m->entries.data + (i * m->entry_size);
+}
+
+static inline u64 _entry_hash(indexmap_header_t *m, usize i)
+{
+	u64 hash;
+	memcpy(&hash, _entry(m, i), sizeof(hash)); /// `hash` is the first field
+	return hash;
+}
+
+/*
+ * ==========================================================================
+ * Table Logic (Group Probing, see std/map/group.h)
+ * ==========================================================================
+ */
+
+static bool _slot_eq(const void *table, usize idx, const void *key,
+		     u64 hash)
+{
+	indexmap_header_t *m = (indexmap_header_t *)table;
+	usize e = m->slots[idx];
+	/// full hashes are stored: compare keys only on a match
+	if (_entry_hash(m, e) != hash)
+		return false;
+	return m->ops.equals(key, _entry(m, e) + m->key_off);
+}
+
+/**
+ * Return true and the slot of `key` if present. Otherwise return false and
+ * the first EMPTY/TOMB slot of the probe sequence (for an insert).
+ */
+static bool _find_slot(indexmap_header_t *m, const void *key, u64 hash,
+		       usize *out_idx)
+{
+	return _map_probe(m->ctrl, m->cap, hash, m, key, _slot_eq, out_idx);
+}
+
+static bool _slot_is_entry(const void *table, usize idx, const void *e,
+			   [[maybe_unused]] u64 hash)
+{
+	const indexmap_header_t *m = (const indexmap_header_t *)table;
+	return m->slots[idx] == *(const usize *)e;
+}
+
+/// slot that points at entry `e` (which must be indexed)
+static usize _find_entry_slot(indexmap_header_t *m, usize e)
+{
+	usize idx;
+	[[maybe_unused]] bool found = _map_probe(m->ctrl, m->cap,
+						 _entry_hash(m, e), m, &e,
+						 _slot_is_entry, &idx);
+	massert(found, "indexmap: entry is not indexed");
+	return idx;
+}
+
+static void _free_table(indexmap_header_t *m)
+{
+	if (m->cap == 0)
+		return;
+	allocer_free_fast(m->entries.alc, m->ctrl,
+			  layout(_map_ctrl_bytes(m->cap), 1));
+	allocer_free_fast(m->entries.alc, m->slots,
+			  layout_of_array(u32, m->cap));
+}
+
+/**
+ * Rebuild the table with `new_cap` slots from the entries. The entries
+ * carry their full hash, so no key is hashed (or even read) again.
+ */
+static noinline bool _rebuild(indexmap_header_t *m, usize new_cap)
+{
+	if (new_cap != m->cap) {
+		allocer_t alc = m->entries.alc;
+		layout_t l_ctrl = layout(_map_ctrl_bytes(new_cap), 1);
+		layout_t l_slots = layout_of_array(u32, new_cap);
+		u8 *ctrl = (u8 *)allocer_alloc_fast(alc, l_ctrl);
+		u32 *slots = (u32 *)allocer_alloc_fast(alc, l_slots);
+		if (!ctrl || !slots) {
+			if (ctrl)
+				allocer_free_fast(alc, ctrl, l_ctrl);
+			if (slots)
+				allocer_free_fast(alc, slots, l_slots);
+			return false;
+		}
+		_free_table(m);
+		m->ctrl = ctrl;
+		m->slots = slots;
+		m->cap = new_cap;
+	}
+
+	memset(m->ctrl, _MAP_EMPTY, _map_ctrl_bytes(m->cap));
+	for (usize i = 0; i < m->entries.len; ++i) {
+		u64 hash = _entry_hash(m, i);
+		usize idx = _map_find_empty(m->ctrl, m->cap, hash);
+		_map_set_ctrl(m->ctrl, m->cap, idx, _map_h2(hash));
+		m->slots[idx] = (u32)i;
+	}
+	m->occupied = m->entries.len;
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Public Implementation
+ * ==========================================================================
+ */
+
+bool _indexmap_init_impl(anyptr map, allocer_t alc, map_ops_t ops,
+			 usize entry_size, usize entry_align, usize key_off,
+			 usize key_size, usize val_off, usize val_size)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	if (!_vec_init_impl(&m->entries, alc, 0, entry_size, entry_align))
+		return false;
+	m->ctrl = nullptr;
+	m->slots = nullptr;
+	m->cap = 0;
+	m->occupied = 0;
+	m->ops = ops;
+	m->entry_size = entry_size;
+	m->entry_align = entry_align;
+	m->key_off = key_off;
+	m->key_size = key_size;
+	m->val_off = val_off;
+	m->val_size = val_size;
+	return true;
+}
+
+void _indexmap_deinit_impl(anyptr map)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	_free_table(m);
+	_vec_deinit_impl(&m->entries, m->entry_size, m->entry_align);
+	m->ctrl = nullptr;
+	m->slots = nullptr;
+	m->cap = 0;
+	m->occupied = 0;
+}
+
+bool _indexmap_reserve_impl(anyptr map, usize additional)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	usize want;
+	if (checked_add(m->entries.len, additional, &want) ||
+	    want > MAX_ENTRIES)
+		return false;
+
+	if (!_vec_reserve_impl(&m->entries, additional, m->entry_size,
+			       m->entry_align))
+		return false;
+	usize cap = _map_cap_for(want);
+	return cap <= m->cap || _rebuild(m, cap);
+}
+
+bool _indexmap_put_impl(anyptr map, const void *k_ptr, const void *v_ptr)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	u64 hash = m->ops.hash(k_ptr);
+	usize idx = 0;
+
+	if (m->cap > 0 && _find_slot(m, k_ptr, hash, &idx)) {
+		memcpy(_entry(m, m->slots[idx]) + m->val_off, v_ptr,
+		       m->val_size);
+		return true;
+	}
+
+	usize e = m->entries.len;
+	if (unlikely(e >= MAX_ENTRIES))
+		return false;
+	if (unlikely(e == m->entries.cap) &&
+	    !_vec_grow_impl(&m->entries, m->entry_size, m->entry_align))
+		return false;
+
+	usize new_cap = _map_grow_cap(m->cap, e, m->occupied);
+	if (new_cap != 0) {
+		if (!_rebuild(m, new_cap))
+			return false;
+		idx = _map_find_empty(m->ctrl, m->cap, hash);
+	}
+
+	u8 *entry = _entry(m, e);
+	memcpy(entry, &hash, sizeof(hash));
+	memcpy(entry + m->key_off, k_ptr, m->key_size);
+	memcpy(entry + m->val_off, v_ptr, m->val_size);
+	m->entries.len++;
+
+	if (m->ctrl[idx] == _MAP_EMPTY)
+		m->occupied++;
+	_map_set_ctrl(m->ctrl, m->cap, idx, _map_h2(hash));
+	m->slots[idx] = (u32)e;
+	return true;
+}
+
+usize _indexmap_index_of_impl(anyptr map, const void *k_ptr)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	if (m->entries.len == 0)
+		return (usize)-1;
+
+	usize idx;
+	if (_find_slot(m, k_ptr, m->ops.hash(k_ptr), &idx))
+		return m->slots[idx];
+	return (usize)-1;
+}
+
+void *_indexmap_get_impl(anyptr map, const void *k_ptr)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	usize e = _indexmap_index_of_impl(map, k_ptr);
+	if (e == (usize)-1)
+		return nullptr;
+	return _entry(m, e) + m->val_off;
+}
+
+bool _indexmap_swap_remove_impl(anyptr map, const void *k_ptr)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	if (m->entries.len == 0)
+		return false;
+
+	usize idx;
+	if (!_find_slot(m, k_ptr, m->ops.hash(k_ptr), &idx))
+		return false;
+
+	usize e = m->slots[idx];
+	if (_map_erase_ctrl(m->ctrl, m->cap, idx))
+		m->occupied--;
+
+	/// move the last entry into the hole and repoint its slot
+	usize last = m->entries.len - 1;
+	if (e != last) {
+		m->slots[_find_entry_slot(m, last)] = (u32)e;
+		memcpy(_entry(m, e), _entry(m, last), m->entry_size);
+	}
+	m->entries.len--;
+	return true;
+}
+
+void _indexmap_clear_impl(anyptr map)
+{
+	indexmap_header_t *m = (indexmap_header_t *)map;
+	m->entries.len = 0;
+	if (m->cap > 0) {
+		memset(m->ctrl, _MAP_EMPTY, _map_ctrl_bytes(m->cap));
+		m->occupied = 0;
+	}
+}
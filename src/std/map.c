@@ -15,6 +15,8 @@
  */
 
 #include <std/map.h>
+#include <std/map/group.h> /// for the control group primitives
+#include <std/allocers/bump.h> /// for allocer_*_fast
 #include <core/math.h> /// for checked_mul, etc. (if used) or just logic
 
 /*
@@ -24,6 +26,7 @@ typedef struct {
 	u8 *keys;
 	u8 *vals;
 	u8 *states;
+	u32 *hashes; /// low 32 hash bits per slot, or nullptr
 	usize len;
 	usize cap;
 	usize occupied; /// len + deleted
@@ -31,10 +34,10 @@ typedef struct {
 	map_ops_t ops;
 	usize key_size;
 	usize val_size;
+	void *old; /// map_old_t being drained, or nullptr
+	bool incremental;
 } map_header_t;
 
-#define MAX_LOAD_FACTOR_PERCENT 75
-
 /*
  * ==========================================================================
  * Standard Operations Implementation
@@ -46,7 +49,7 @@ typedef struct {
 /// u32 / I32
 static u64 _hash_u32(const void *key)
 {
-	return hash_bytes(key, sizeof(u32));
+	return hash_u32(*(const u32 *)key);
 }
 static bool _eq_u32(const void *a, const void *b)
 {
@@ -57,7 +60,7 @@ const map_ops_t MAP_OPS_U32 = { .hash = _hash_u32, .equals = _eq_u32 };
 /// u64 / I64
 static u64 _hash_u64(const void *key)
 {
-	return hash_bytes(key, sizeof(u64));
+	return hash_u64(*(const u64 *)key);
 }
 static bool _eq_u64(const void *a, const void *b)
 {
@@ -68,7 +71,7 @@ const map_ops_t MAP_OPS_U64 = { .hash = _hash_u64, .equals = _eq_u64 };
 /// uSIZE / Pointers (Address)
 static u64 _hash_usize(const void *key)
 {
-	return hash_bytes(key, sizeof(usize));
+	return hash_u64(*(const usize *)key);
 }
 static bool _eq_usize(const void *a, const void *b)
 {
@@ -92,119 +95,257 @@ static bool _eq_cstr(const void *a, const void *b)
 	const char *s2 = *(const char *const *)b;
 	return strcmp(s1, s2) == 0;
 }
-const map_ops_t MAP_OPS_CSTR = { .hash = _hash_cstr, .equals = _eq_cstr };
+const map_ops_t MAP_OPS_CSTR = { .hash = _hash_cstr,
+				 .equals = _eq_cstr,
+				 .cache_hashes = true };
 
 /*
  * ==========================================================================
- * Internal Logic (Linear Probing)
+ * Internal Logic (Group Probing, see std/map/group.h)
  * ==========================================================================
  */
 
-/// return true if found existing key, false if found empty slot for insert
-static bool _find_slot(map_header_t *m, const void *key, usize *out_idx)
+static bool _slot_eq(const void *table, usize idx, const void *key,
+		     u64 hash)
 {
-	if (m->cap == 0)
+	const map_header_t *m = (const map_header_t *)table;
+	if (m->hashes && m->hashes[idx] != (u32)hash)
 		return false;
+	return m->ops.equals(key, m->keys + (idx * m->key_size));
+}
 
-	u64 hash = m->ops.hash(key);
-	usize idx = (usize)(hash & (m->cap - 1)); /// cap is power of 2
-	usize start_idx = idx;
-
-	usize first_tomb = (usize)-1;
-
-	do {
-		u8 state = m->states[idx];
-
-		if (state == _MAP_EMPTY) {
-			/// not found. Use tombstone if available.
-			if (first_tomb != (usize)-1)
-				*out_idx = first_tomb;
-			else
-				*out_idx = idx;
-			return false;
-		}
-
-		if (state == _MAP_TOMB) {
-			if (first_tomb == (usize)-1)
-				first_tomb = idx;
-		} else if (state == _MAP_FULL) {
-			/// compare keys
-			void *slot_key = m->keys + (idx * m->key_size);
-			if (m->ops.equals(key, slot_key)) {
-				*out_idx = idx;
-				return true; /// found
-			}
-		}
-
-		idx = (idx + 1) & (m->cap - 1);
-	} while (idx != start_idx);
-
-	/// map full (should be prevented by load factor)
-	if (first_tomb != (usize)-1) {
-		*out_idx = first_tomb;
-		return false;
-	}
+/// return true if found existing key, false if found empty slot for insert
+static bool _find_slot(map_header_t *m, const void *key, u64 hash,
+		       usize *out_idx)
+{
+	return _map_probe(m->states, m->cap, hash, m, key, _slot_eq, out_idx);
+}
 
-	massert(false, "Map is completely full (logic error)");
-	return false;
+static inline layout_t hashes_layout(usize cap)
+{
+	return layout_of_array(u32, cap);
+}
+
+static void _map_free_arrays(map_header_t *m)
+{
+	if (m->cap == 0)
+		return;
+	allocer_free_fast(m->alc, m->keys, layout(m->cap * m->key_size, 1));
+	allocer_free_fast(m->alc, m->vals, layout(m->cap * m->val_size, 1));
+	allocer_free_fast(m->alc, m->states,
+			  layout(_map_ctrl_bytes(m->cap), 1));
+	if (m->hashes)
+		allocer_free_fast(m->alc, m->hashes, hashes_layout(m->cap));
 }
 
-static bool _map_resize(map_header_t *m, usize new_cap)
+/// allocate empty arrays for a table of `new_cap` slots into `out`
+static bool _map_alloc_table(const map_header_t *m, usize new_cap,
+			     map_header_t *out)
 {
-	/// use zalloc for states to init to _MAP_EMPTY (0)
 	layout_t l_keys =
 		layout(new_cap * m->key_size, 1); /// alignment simplified to 1
 	layout_t l_vals = layout(new_cap * m->val_size, 1);
-	layout_t l_states = layout(new_cap, 1);
+	layout_t l_states = layout(_map_ctrl_bytes(new_cap), 1);
+	layout_t l_hashes = hashes_layout(new_cap);
+	bool cached = m->ops.cache_hashes;
 
-	u8 *new_keys = (u8 *)allocer_alloc(m->alc, l_keys);
-	u8 *new_vals = (u8 *)allocer_alloc(m->alc, l_vals);
-	u8 *new_states = (u8 *)allocer_zalloc(m->alc, l_states);
+	u8 *new_keys = (u8 *)allocer_alloc_fast(m->alc, l_keys);
+	u8 *new_vals = (u8 *)allocer_alloc_fast(m->alc, l_vals);
+	u8 *new_states = (u8 *)allocer_alloc_fast(m->alc, l_states);
+	u32 *new_hashes =
+		cached ? (u32 *)allocer_alloc_fast(m->alc, l_hashes) : nullptr;
 
-	if (!new_keys || !new_vals || !new_states) {
+	if (!new_keys || !new_vals || !new_states || (cached && !new_hashes)) {
 		if (new_keys)
-			allocer_free(m->alc, new_keys, l_keys);
+			allocer_free_fast(m->alc, new_keys, l_keys);
 		if (new_vals)
-			allocer_free(m->alc, new_vals, l_vals);
+			allocer_free_fast(m->alc, new_vals, l_vals);
 		if (new_states)
-			allocer_free(m->alc, new_states, l_states);
+			allocer_free_fast(m->alc, new_states, l_states);
+		if (new_hashes)
+			allocer_free_fast(m->alc, new_hashes, l_hashes);
 		return false;
 	}
+	memset(new_states, _MAP_EMPTY, l_states.size);
+
+	*out = *m;
+	out->keys = new_keys;
+	out->vals = new_vals;
+	out->states = new_states;
+	out->hashes = new_hashes;
+	out->cap = new_cap;
+	out->len = 0;
+	out->occupied = 0;
+	out->old = nullptr;
+	return true;
+}
+
+/**
+ * Move the FULL slot `i` of `src` into an EMPTY slot of `dst` (the key is
+ * known to be absent from `dst`: no equality checks). Returns the new slot.
+ *
+ * With cached hashes the key is never hashed (or read) again: the low 32
+ * bits place the slot and H2 is carried over from the old control byte.
+ * Tables past 2^32 slots need more bits than are cached.
+ */
+static usize _map_move_slot(map_header_t *dst, const map_header_t *src,
+			    usize i)
+{
+	const u8 *k = src->keys + (i * src->key_size);
+	const u8 *v = src->vals + (i * src->val_size);
+	u8 ctrl = src->states[i];
+
+	u64 hash;
+	if (src->hashes && dst->cap <= ((usize)1 << 32)) {
+		hash = src->hashes[i];
+	} else {
+		hash = src->ops.hash(k);
+		ctrl = _map_h2(hash);
+	}
+	usize idx = _map_find_empty(dst->states, dst->cap, hash);
+
+	memcpy(dst->keys + (idx * dst->key_size), k, dst->key_size);
+	memcpy(dst->vals + (idx * dst->val_size), v, dst->val_size);
+	if (dst->hashes)
+		dst->hashes[idx] = (u32)hash;
+	_map_set_ctrl(dst->states, dst->cap, idx, ctrl);
+	dst->len++;
+	dst->occupied++;
+	return idx;
+}
 
-	/// create temp map to use _find_slot logic for rehash
-	map_header_t new_m = *m;
-	new_m.keys = new_keys;
-	new_m.vals = new_vals;
-	new_m.states = new_states;
-	new_m.cap = new_cap;
-	new_m.len = 0;
-	new_m.occupied = 0;
+/// cold: keep it out of the probe paths
+static noinline bool _map_resize(map_header_t *m, usize new_cap)
+{
+	map_header_t new_m;
+	if (!_map_alloc_table(m, new_cap, &new_m))
+		return false;
 
 	/// rehash all FULL entries
 	for (usize i = 0; i < m->cap; ++i) {
-		if (m->states[i] == _MAP_FULL) {
-			void *k = m->keys + (i * m->key_size);
-			void *v = m->vals + (i * m->val_size);
-
-			usize idx;
-			/// should always return false (not found) in a fresh map
-			_find_slot(&new_m, k, &idx);
-
-			memcpy(new_keys + (idx * m->key_size), k, m->key_size);
-			memcpy(new_vals + (idx * m->val_size), v, m->val_size);
-			new_states[idx] = _MAP_FULL;
-			new_m.len++;
-			new_m.occupied++;
-		}
+		if (_map_ctrl_full(m->states[i]))
+			_map_move_slot(&new_m, m, i);
 	}
 
 	/// free old arrays
-	if (m->cap > 0) {
-		allocer_free(m->alc, m->keys, layout(m->cap * m->key_size, 1));
-		allocer_free(m->alc, m->vals, layout(m->cap * m->val_size, 1));
-		allocer_free(m->alc, m->states, layout(m->cap, 1));
+	_map_free_arrays(m);
+
+	*m = new_m;
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Incremental Resizing
+ * ==========================================================================
+ * Instead of rehashing everything at once, growth allocates the new arrays
+ * and keeps the previous table aside as `old`. Every call then migrates the
+ * next `MIGRATE_STEP` slots of the old table, and lookups that miss the new
+ * table fall back to the old one.
+ *
+ * - Migrated old slots become tombstones, so probe chains through the old
+ * table stay intact for the keys that are still waiting.
+ * - `len` counts both tables; `occupied` only the new one.
+ * - The old table holds at most 7/8 of its capacity and the new one is at
+ * least as large, so it cannot fill up before the migration ends, even if
+ * every call in between inserts.
+ */
+
+#define MIGRATE_STEP 32
+
+typedef struct {
+	map_header_t table;
+	usize cursor; /// next old slot to migrate
+} map_old_t;
+
+static void _map_drop_old(map_header_t *m)
+{
+	map_old_t *old = (map_old_t *)m->old;
+	if (!old)
+		return;
+	_map_free_arrays(&old->table);
+	allocer_free_fast(m->alc, old, layout_of(map_old_t));
+	m->old = nullptr;
+}
+
+/// migrate up to `budget` old slots
+static noinline void _map_migrate(map_header_t *m, usize budget)
+{
+	map_old_t *old = (map_old_t *)m->old;
+	map_header_t *o = &old->table;
+	usize end = old->cursor + min(budget, o->cap - old->cursor);
+
+	for (usize i = old->cursor; i < end; ++i) {
+		if (!_map_ctrl_full(o->states[i]))
+			continue;
+		_map_move_slot(m, o, i);
+		m->len--; /// already counted while it lived in the old table
+		_map_set_ctrl(o->states, o->cap, i, _MAP_TOMB);
+	}
+
+	old->cursor = end;
+	if (end == o->cap)
+		_map_drop_old(m);
+}
+
+static inline void _map_migrate_step(map_header_t *m)
+{
+	if (unlikely(m->old != nullptr))
+		_map_migrate(m, MIGRATE_STEP);
+}
+
+/// look `key` up in the table being drained, (usize)-1 if absent
+static usize _map_find_old(map_header_t *m, const void *key, u64 hash)
+{
+	map_old_t *old = (map_old_t *)m->old;
+	usize idx;
+	if (old && _find_slot(&old->table, key, hash, &idx))
+		return idx;
+	return (usize)-1;
+}
+
+/**
+ * Move old slot `old_idx` into free new slot `idx` (as left by a missed
+ * `_find_slot`), so that pointers handed out always point into `m->vals`.
+ */
+static void _map_adopt_old(map_header_t *m, usize idx, usize old_idx,
+			   u64 hash)
+{
+	map_header_t *o = &((map_old_t *)m->old)->table;
+	if (m->states[idx] == _MAP_EMPTY)
+		m->occupied++;
+	memcpy(m->keys + (idx * m->key_size),
+	       o->keys + (old_idx * o->key_size), m->key_size);
+	memcpy(m->vals + (idx * m->val_size),
+	       o->vals + (old_idx * o->val_size), m->val_size);
+	if (m->hashes)
+		m->hashes[idx] = (u32)hash;
+	_map_set_ctrl(m->states, m->cap, idx, _map_h2(hash));
+	_map_set_ctrl(o->states, o->cap, old_idx, _MAP_TOMB);
+}
+
+/// start draining the current table into one of `new_cap` slots
+static noinline bool _map_begin_migration(map_header_t *m, usize new_cap)
+{
+	/// a migration still running: finish it first
+	if (m->old)
+		_map_migrate(m, (usize)-1);
+
+	map_old_t *old =
+		(map_old_t *)allocer_alloc_fast(m->alc, layout_of(map_old_t));
+	if (!old)
+		return _map_resize(m, new_cap); /// fall back to one go
+
+	map_header_t new_m;
+	if (!_map_alloc_table(m, new_cap, &new_m)) {
+		allocer_free_fast(m->alc, old, layout_of(map_old_t));
+		return false;
 	}
 
+	old->table = *m;
+	old->cursor = 0;
+	new_m.len = m->len;
+	new_m.old = old;
 	*m = new_m;
 	return true;
 }
@@ -216,12 +357,13 @@ static bool _map_resize(map_header_t *m, usize new_cap)
  */
 
 bool _map_init_impl(anyptr map, allocer_t alc, map_ops_t ops, usize k_sz,
-		    usize v_sz)
+		    usize v_sz, bool incremental)
 {
 	map_header_t *m = (map_header_t *)map;
 	m->keys = nullptr;
 	m->vals = nullptr;
 	m->states = nullptr;
+	m->hashes = nullptr;
 	m->len = 0;
 	m->cap = 0;
 	m->occupied = 0;
@@ -229,82 +371,178 @@ bool _map_init_impl(anyptr map, allocer_t alc, map_ops_t ops, usize k_sz,
 	m->ops = ops;
 	m->key_size = k_sz;
 	m->val_size = v_sz;
+	m->old = nullptr;
+	m->incremental = incremental;
 	return true;
 }
 
 void _map_deinit_impl(anyptr map, usize k_sz, usize v_sz)
 {
 	map_header_t *m = (map_header_t *)map;
-	if (m->cap > 0) {
-		allocer_free(m->alc, m->keys, layout(m->cap * k_sz, 1));
-		allocer_free(m->alc, m->vals, layout(m->cap * v_sz, 1));
-		allocer_free(m->alc, m->states, layout(m->cap, 1));
-	}
+	unused(k_sz); /// sizes are cached in the header
+	unused(v_sz);
+	_map_drop_old(m);
+	_map_free_arrays(m);
+	m->hashes = nullptr;
 	m->cap = 0;
 	m->len = 0;
 }
 
-bool _map_put_impl(anyptr map, const void *k_ptr, const void *v_ptr)
+/**
+ * Probe once. Returns the slot of `k_ptr`, claiming a new one (key copied
+ * in, value untouched) if the key is absent. Returns (usize)-1 on OOM.
+ */
+static usize _map_claim(map_header_t *m, const void *k_ptr, u64 hash,
+			bool *inserted)
 {
-	map_header_t *m = (map_header_t *)map;
+	_map_migrate_step(m);
 
-	/// load factor check (0.75)
-	if (m->cap == 0 || (m->occupied + 1) * 4 >= m->cap * 3) {
-		usize new_cap = (m->cap == 0) ? 8 : m->cap * 2;
-		if (!_map_resize(m, new_cap))
-			return false;
+	usize idx = 0;
+
+	if (m->cap > 0 && _find_slot(m, k_ptr, hash, &idx)) {
+		*inserted = false;
+		return idx;
 	}
 
-	usize idx;
-	bool exists = _find_slot(m, k_ptr, &idx);
+	/// not migrated yet: move it over now, into the slot just found
+	usize old_idx = _map_find_old(m, k_ptr, hash);
+	if (unlikely(old_idx != (usize)-1)) {
+		_map_adopt_old(m, idx, old_idx, hash);
+		*inserted = false;
+		return idx;
+	}
 
-	if (!exists) {
-		/// new entry
-		memcpy(m->keys + (idx * m->key_size), k_ptr, m->key_size);
-		m->states[idx] = _MAP_FULL;
-		m->len++;
-		m->occupied++;
+	usize new_cap = _map_grow_cap(m->cap, m->len, m->occupied);
+	if (new_cap != 0) {
+		bool ok = (m->incremental && m->cap > 0) ?
+				  _map_begin_migration(m, new_cap) :
+				  _map_resize(m, new_cap);
+		if (!ok)
+			return (usize)-1;
+		/// the fresh table has no tombstones and cannot hold the key
+		idx = _map_find_empty(m->states, m->cap, hash);
 	}
-	/// update value
-	memcpy(m->vals + (idx * m->val_size), v_ptr, m->val_size);
 
+	/// new entry (reusing a tombstone does not add to `occupied`)
+	if (m->states[idx] == _MAP_EMPTY)
+		m->occupied++;
+	memcpy(m->keys + (idx * m->key_size), k_ptr, m->key_size);
+	if (m->hashes)
+		m->hashes[idx] = (u32)hash;
+	_map_set_ctrl(m->states, m->cap, idx, _map_h2(hash));
+	m->len++;
+
+	*inserted = true;
+	return idx;
+}
+
+bool _map_put_hashed_impl(anyptr map, const void *k_ptr, const void *v_ptr,
+			  u64 hash)
+{
+	map_header_t *m = (map_header_t *)map;
+
+	bool inserted;
+	usize idx = _map_claim(m, k_ptr, hash, &inserted);
+	if (unlikely(idx == (usize)-1))
+		return false;
+
+	/// insert or update value
+	memcpy(m->vals + (idx * m->val_size), v_ptr, m->val_size);
 	return true;
 }
 
-void *_map_get_impl(anyptr map, const void *k_ptr)
+bool _map_put_impl(anyptr map, const void *k_ptr, const void *v_ptr)
+{
+	map_header_t *m = (map_header_t *)map;
+	return _map_put_hashed_impl(map, k_ptr, v_ptr, m->ops.hash(k_ptr));
+}
+
+void *_map_entry_impl(anyptr map, const void *k_ptr, bool *inserted)
+{
+	map_header_t *m = (map_header_t *)map;
+
+	bool fresh;
+	usize idx = _map_claim(m, k_ptr, m->ops.hash(k_ptr), &fresh);
+	if (unlikely(idx == (usize)-1))
+		return nullptr;
+
+	void *val = m->vals + (idx * m->val_size);
+	if (fresh)
+		memset(val, 0, m->val_size);
+	if (inserted)
+		*inserted = fresh;
+	return val;
+}
+
+void *_map_get_hashed_impl(anyptr map, const void *k_ptr, u64 hash)
 {
 	map_header_t *m = (map_header_t *)map;
 	if (m->len == 0)
 		return nullptr;
+	_map_migrate_step(m);
 
 	usize idx;
-	if (_find_slot(m, k_ptr, &idx)) {
+	if (_find_slot(m, k_ptr, hash, &idx)) {
+		return m->vals + (idx * m->val_size);
+	}
+
+	/// not migrated yet: move it over so the pointer is in `m->vals`
+	usize old_idx = _map_find_old(m, k_ptr, hash);
+	if (unlikely(old_idx != (usize)-1)) {
+		_map_adopt_old(m, idx, old_idx, hash);
 		return m->vals + (idx * m->val_size);
 	}
 	return nullptr;
 }
 
-bool _map_remove_impl(anyptr map, const void *k_ptr)
+void *_map_get_impl(anyptr map, const void *k_ptr)
+{
+	map_header_t *m = (map_header_t *)map;
+	if (m->len == 0)
+		return nullptr;
+	return _map_get_hashed_impl(map, k_ptr, m->ops.hash(k_ptr));
+}
+
+bool _map_remove_hashed_impl(anyptr map, const void *k_ptr, u64 hash)
 {
 	map_header_t *m = (map_header_t *)map;
 	if (m->len == 0)
 		return false;
+	_map_migrate_step(m);
 
 	usize idx;
-	if (_find_slot(m, k_ptr, &idx)) {
-		m->states[idx] = _MAP_TOMB;
+	if (_find_slot(m, k_ptr, hash, &idx)) {
+		/// a tombstone only when a probe may have walked past it
+		if (_map_erase_ctrl(m->states, m->cap, idx))
+			m->occupied--;
+		m->len--;
+		return true;
+	}
+
+	idx = _map_find_old(m, k_ptr, hash);
+	if (unlikely(idx != (usize)-1)) {
+		map_header_t *o = &((map_old_t *)m->old)->table;
+		_map_set_ctrl(o->states, o->cap, idx, _MAP_TOMB);
 		m->len--;
-		/// occupied does NOT decrease
 		return true;
 	}
 	return false;
 }
 
+bool _map_remove_impl(anyptr map, const void *k_ptr)
+{
+	map_header_t *m = (map_header_t *)map;
+	if (m->len == 0)
+		return false;
+	return _map_remove_hashed_impl(map, k_ptr, m->ops.hash(k_ptr));
+}
+
 void _map_clear_impl(anyptr map)
 {
 	map_header_t *m = (map_header_t *)map;
+	_map_drop_old(m);
 	if (m->cap > 0) {
-		memset(m->states, _MAP_EMPTY, m->cap);
+		memset(m->states, _MAP_EMPTY, _map_ctrl_bytes(m->cap));
 		m->len = 0;
 		m->occupied = 0;
 	}
@@ -0,0 +1,258 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/map/phf.h>
+#include <std/allocers/bump.h> /// for allocer_*_fast
+#include <stdlib.h> /// for qsort
+
+/*
+ * ==========================================================================
+ * Construction ("hash and displace")
+ * ==========================================================================
+ * Keys are split into buckets of about `LAMBDA` keys by the high hash bits.
+ * Largest bucket first, each bucket gets the first displacement (d1, d2)
+ * that sends all of its keys to free slots. If some bucket finds none, the
+ * whole table is retried with the next seed.
+ *
+ * `scripts/gen_phf.py` follows these exact steps (same seeds, same bucket
+ * order), so a generated table and a `phf_build` one are identical.
+ */
+
+#define LAMBDA 5
+#define MAX_SEEDS 64
+
+static u64 next_seed(u64 *state)
+{
+	u64 z = (*state += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+typedef struct {
+	u32 size;
+	u32 idx;
+} bucket_t;
+
+/// largest bucket first, ties by index (keeps the order deterministic)
+static int cmp_bucket(const void *a, const void *b)
+{
+	const bucket_t *x = (const bucket_t *)a;
+	const bucket_t *y = (const bucket_t *)b;
+	if (x->size != y->size)
+		return x->size > y->size ? -1 : 1;
+	return x->idx < y->idx ? -1 : (x->idx > y->idx);
+}
+
+typedef struct {
+	usize n;
+	u32 bucket_count;
+	u64 *hashes; /// per key
+	u32 *members; /// key indices grouped by bucket
+	u32 *starts; /// bucket_count + 1 offsets into `members`
+	bucket_t *order;
+	u32 *owner; /// slot -> key + 1, 0 = free
+	u32 *tried; /// slot -> last (d1, d2) attempt that used it
+	phf_disp_t *disps;
+} builder_t;
+
+static bool same_key(str_t a, str_t b)
+{
+	return a.len == b.len && memcmp(a.ptr, b.ptr, a.len) == 0;
+}
+
+/// do all keys of a bucket land on free, distinct slots under `d`?
+static bool try_disp(builder_t *b, const u32 *mem, u32 size, phf_disp_t d,
+		     u32 attempt)
+{
+	u32 n = (u32)b->n;
+	for (u32 i = 0; i < size; ++i) {
+		u32 s = _phf_place(b->hashes[mem[i]], d, n);
+		if (b->owner[s] || b->tried[s] == attempt)
+			return false;
+		b->tried[s] = attempt;
+	}
+	for (u32 i = 0; i < size; ++i)
+		b->owner[_phf_place(b->hashes[mem[i]], d, n)] = mem[i] + 1;
+	return true;
+}
+
+/// one attempt with `seed`: false if some bucket cannot be placed
+static bool try_seed(builder_t *b, const str_t *keys, u64 seed, bool *dup)
+{
+	usize n = b->n;
+	u32 nb = b->bucket_count;
+
+	/// 1. hash and group by bucket (counting sort, key order kept)
+	memset(b->starts, 0, sizeof(u32) * (nb + 1));
+	for (usize i = 0; i < n; ++i) {
+		b->hashes[i] = phf_hash(keys[i], seed);
+		b->starts[_phf_bucket(b->hashes[i], nb) + 1]++;
+	}
+	for (u32 i = 0; i < nb; ++i) {
+		b->order[i] = (bucket_t){ b->starts[i + 1], i };
+		b->starts[i + 1] += b->starts[i];
+	}
+	for (usize i = 0; i < n; ++i) {
+		u32 bk = _phf_bucket(b->hashes[i], nb);
+		u32 at = b->starts[bk]++;
+		b->members[at] = (u32)i;
+	}
+	/// `starts[bk]` now holds the end of bucket bk: shift back
+	for (u32 i = nb; i > 0; --i)
+		b->starts[i] = b->starts[i - 1];
+	b->starts[0] = 0;
+	qsort(b->order, nb, sizeof(bucket_t), cmp_bucket);
+
+	/// 2. equal keys share a bucket and always collide: no seed helps
+	for (u32 bk = 0; bk < nb; ++bk) {
+		for (u32 i = b->starts[bk]; i < b->starts[bk + 1]; ++i) {
+			for (u32 j = i + 1; j < b->starts[bk + 1]; ++j) {
+				u32 x = b->members[i], y = b->members[j];
+				if (b->hashes[x] == b->hashes[y] &&
+				    same_key(keys[x], keys[y])) {
+					*dup = true;
+					return false;
+				}
+			}
+		}
+	}
+
+	/// 3. place buckets, largest first
+	memset(b->owner, 0, sizeof(u32) * n);
+	memset(b->tried, 0, sizeof(u32) * n);
+	u32 attempt = 0;
+
+	for (u32 o = 0; o < nb; ++o) {
+		u32 bk = b->order[o].idx;
+		u32 *mem = b->members + b->starts[bk];
+		u32 size = b->order[o].size;
+
+		bool placed = false;
+		for (u32 d1 = 0; d1 < n && !placed; ++d1) {
+			for (u32 d2 = 0; d2 < n && !placed; ++d2) {
+				phf_disp_t d = { d1, d2 };
+				placed = try_disp(b, mem, size, d, ++attempt);
+				if (placed)
+					b->disps[bk] = d;
+			}
+		}
+		if (!placed)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Public API
+ * ==========================================================================
+ */
+
+/// release the scratch arrays (and, unless `keep_disps`, the displacements)
+static void builder_free(builder_t *b, allocer_t alc, bool keep_disps)
+{
+	usize n = b->n;
+	u32 nb = b->bucket_count;
+	if (b->hashes)
+		allocer_free_fast(alc, b->hashes, layout_of_array(u64, n));
+	if (b->members)
+		allocer_free_fast(alc, b->members, layout_of_array(u32, n));
+	if (b->starts)
+		allocer_free_fast(alc, b->starts, layout_of_array(u32, nb + 1));
+	if (b->order)
+		allocer_free_fast(alc, b->order, layout_of_array(bucket_t, nb));
+	if (b->owner)
+		allocer_free_fast(alc, b->owner, layout_of_array(u32, n));
+	if (b->tried)
+		allocer_free_fast(alc, b->tried, layout_of_array(u32, n));
+	if (b->disps && !keep_disps)
+		allocer_free_fast(alc, b->disps,
+				  layout_of_array(phf_disp_t, nb));
+}
+
+bool phf_build(phf_t *t, allocer_t alc, const str_t *keys, const int *vals,
+	       usize n)
+{
+	*t = (phf_t){ 0 };
+	if (n == 0)
+		return true;
+	if (n >= UINT32_MAX)
+		return false;
+
+	u32 nb = (u32)((n + LAMBDA - 1) / LAMBDA);
+	builder_t b = {
+		.n = n,
+		.bucket_count = nb,
+		.hashes = allocer_alloc_fast(alc, layout_of_array(u64, n)),
+		.members = allocer_alloc_fast(alc, layout_of_array(u32, n)),
+		.starts = allocer_alloc_fast(alc, layout_of_array(u32, nb + 1)),
+		.order = allocer_alloc_fast(alc, layout_of_array(bucket_t, nb)),
+		.owner = allocer_alloc_fast(alc, layout_of_array(u32, n)),
+		.tried = allocer_alloc_fast(alc, layout_of_array(u32, n)),
+		.disps = allocer_alloc_fast(alc,
+					    layout_of_array(phf_disp_t, nb)),
+	};
+	str_t *out_keys = allocer_alloc_fast(alc, layout_of_array(str_t, n));
+	int *out_vals = allocer_alloc_fast(alc, layout_of_array(int, n));
+
+	bool ok = b.hashes && b.members && b.starts && b.order && b.owner &&
+		  b.tried && b.disps && out_keys && out_vals;
+	u64 seed = 0, state = 0;
+	if (ok) {
+		ok = false;
+		bool dup = false;
+		for (int i = 0; i < MAX_SEEDS && !ok && !dup; ++i) {
+			seed = next_seed(&state);
+			ok = try_seed(&b, keys, seed, &dup);
+		}
+	}
+
+	if (ok) {
+		for (usize s = 0; s < n; ++s) {
+			u32 k = b.owner[s] - 1;
+			out_keys[s] = keys[k];
+			out_vals[s] = vals ? vals[k] : (int)k;
+		}
+		*t = (phf_t){ .seed = seed,
+			      .len = (u32)n,
+			      .bucket_count = nb,
+			      .disps = b.disps,
+			      .keys = out_keys,
+			      .vals = out_vals };
+	} else {
+		if (out_keys)
+			allocer_free_fast(alc, out_keys,
+					  layout_of_array(str_t, n));
+		if (out_vals)
+			allocer_free_fast(alc, out_vals,
+					  layout_of_array(int, n));
+	}
+	builder_free(&b, alc, ok);
+	return ok;
+}
+
+void phf_deinit(phf_t *t, allocer_t alc)
+{
+	if (t->len == 0)
+		return;
+	allocer_free_fast(alc, (void *)t->disps,
+			  layout_of_array(phf_disp_t, t->bucket_count));
+	allocer_free_fast(alc, (void *)t->keys,
+			  layout_of_array(str_t, t->len));
+	allocer_free_fast(alc, (void *)t->vals, layout_of_array(int, t->len));
+	*t = (phf_t){ 0 };
+}
@@ -0,0 +1,338 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/rhmap.h>
+#include <std/allocers/bump.h> /// for allocer_*_fast
+
+/*
+ * Internal Header Layout
+ */
+typedef struct {
+	u8 *keys;
+	u8 *vals;
+	_rhmap_dist_t *dists;
+	usize len;
+	usize cap;
+	allocer_t alc;
+	map_ops_t ops;
+	usize key_size;
+	usize val_size;
+} rhmap_header_t;
+
+#define MIN_CAP 8
+
+/*
+ * ==========================================================================
+ * Slot Helpers
+ * ==========================================================================
+ * `keys[cap]` / `vals[cap]` is a scratch slot holding the entry being
+ * carried during an insert, so displaced entries can be swapped through it
+ * without a temporary buffer of unknown size.
+ */
+
+static inline u8 *key_at(rhmap_header_t *m, usize idx)
+{
+	return m->keys + idx * m->key_size;
+}
+
+static inline u8 *val_at(rhmap_header_t *m, usize idx)
+{
+	return m->vals + idx * m->val_size;
+}
+
+/// entries move a lot here: keep the common sizes off the libc memcpy call
+static inline void copy_bytes(u8 *dst, const u8 *src, usize n)
+{
+	switch (n) {
+	case 4:
+		memcpy(dst, src, 4);
+		break;
+	case 8:
+		memcpy(dst, src, 8);
+		break;
+	case 16:
+		memcpy(dst, src, 16);
+		break;
+	default:
+		memcpy(dst, src, n);
+	}
+}
+
+static inline void swap_bytes(u8 *a, u8 *b, usize n)
+{
+	while (n >= sizeof(u64)) {
+		u64 x, y;
+		memcpy(&x, a, sizeof(u64));
+		memcpy(&y, b, sizeof(u64));
+		memcpy(a, &y, sizeof(u64));
+		memcpy(b, &x, sizeof(u64));
+		a += sizeof(u64);
+		b += sizeof(u64);
+		n -= sizeof(u64);
+	}
+	while (n--) {
+		u8 t = *a;
+		*a++ = *b;
+		*b++ = t;
+	}
+}
+
+static inline layout_t keys_layout(usize cap, usize k_sz)
+{
+	return layout((cap + 1) * k_sz, 1);
+}
+
+static inline layout_t vals_layout(usize cap, usize v_sz)
+{
+	return layout((cap + 1) * v_sz, 1);
+}
+
+static inline layout_t dists_layout(usize cap)
+{
+	return layout_of_array(_rhmap_dist_t, cap);
+}
+
+/*
+ * ==========================================================================
+ * Internal Logic (Robin Hood)
+ * ==========================================================================
+ */
+
+/**
+ * Probe for `key`. Returns true with its slot in `*out_idx` if present.
+ * Otherwise `*out_idx`/`*out_dist` is where a Robin Hood insert of the key
+ * takes over: the first slot that is empty or closer to its home than us.
+ */
+static bool _probe(rhmap_header_t *m, const void *key, u64 hash,
+		   usize *out_idx, _rhmap_dist_t *out_dist)
+{
+	usize mask = m->cap - 1;
+	usize idx = (usize)(hash & mask);
+
+	/// an entry closer to home than we are proves the key is absent
+	for (_rhmap_dist_t d = 1;; ++d) {
+		_rhmap_dist_t sd = m->dists[idx];
+		if (sd < d) {
+			*out_idx = idx;
+			*out_dist = d;
+			return false;
+		}
+		if (sd == d && m->ops.equals(key, key_at(m, idx))) {
+			*out_idx = idx;
+			return true;
+		}
+		idx = (idx + 1) & mask;
+	}
+}
+
+/// place the entry in the scratch slot at `idx`, `d` slots from its home
+static void _insert_carried(rhmap_header_t *m, usize idx, _rhmap_dist_t d)
+{
+	usize mask = m->cap - 1;
+	u8 *ck = key_at(m, m->cap);
+	u8 *cv = val_at(m, m->cap);
+
+	for (;; ++d) {
+		_rhmap_dist_t sd = m->dists[idx];
+		if (sd == 0) {
+			copy_bytes(key_at(m, idx), ck, m->key_size);
+			copy_bytes(val_at(m, idx), cv, m->val_size);
+			m->dists[idx] = d;
+			m->len++;
+			return;
+		}
+		if (sd < d) {
+			/// rob the rich: take the slot, carry the old entry on
+			swap_bytes(key_at(m, idx), ck, m->key_size);
+			swap_bytes(val_at(m, idx), cv, m->val_size);
+			m->dists[idx] = d;
+			d = sd;
+		}
+		idx = (idx + 1) & mask;
+	}
+}
+
+static bool _rhmap_resize(rhmap_header_t *m, usize new_cap)
+{
+	massert(new_cap <= (usize)UINT32_MAX, "rhmap capacity overflows dists");
+
+	layout_t l_keys = keys_layout(new_cap, m->key_size);
+	layout_t l_vals = vals_layout(new_cap, m->val_size);
+	layout_t l_dists = dists_layout(new_cap);
+
+	u8 *new_keys = (u8 *)allocer_alloc_fast(m->alc, l_keys);
+	u8 *new_vals = (u8 *)allocer_alloc_fast(m->alc, l_vals);
+	_rhmap_dist_t *new_dists =
+		(_rhmap_dist_t *)allocer_zalloc_fast(m->alc, l_dists);
+
+	if (!new_keys || !new_vals || !new_dists) {
+		if (new_keys)
+			allocer_free_fast(m->alc, new_keys, l_keys);
+		if (new_vals)
+			allocer_free_fast(m->alc, new_vals, l_vals);
+		if (new_dists)
+			allocer_free_fast(m->alc, new_dists, l_dists);
+		return false;
+	}
+
+	rhmap_header_t new_m = *m;
+	new_m.keys = new_keys;
+	new_m.vals = new_vals;
+	new_m.dists = new_dists;
+	new_m.cap = new_cap;
+	new_m.len = 0;
+
+	/// rehash every entry through the new scratch slot
+	for (usize i = 0; i < m->cap; ++i) {
+		if (m->dists[i] != 0) {
+			memcpy(key_at(&new_m, new_cap), key_at(m, i),
+			       m->key_size);
+			memcpy(val_at(&new_m, new_cap), val_at(m, i),
+			       m->val_size);
+			u64 hash = m->ops.hash(key_at(m, i));
+			_insert_carried(&new_m, (usize)hash & (new_cap - 1), 1);
+		}
+	}
+
+	_rhmap_deinit_impl(m);
+	*m = new_m;
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Public Implementation
+ * ==========================================================================
+ */
+
+bool _rhmap_init_impl(anyptr map, allocer_t alc, map_ops_t ops, usize k_sz,
+		      usize v_sz)
+{
+	rhmap_header_t *m = (rhmap_header_t *)map;
+	m->keys = nullptr;
+	m->vals = nullptr;
+	m->dists = nullptr;
+	m->len = 0;
+	m->cap = 0;
+	m->alc = alc;
+	m->ops = ops;
+	m->key_size = k_sz;
+	m->val_size = v_sz;
+	return true;
+}
+
+void _rhmap_deinit_impl(anyptr map)
+{
+	rhmap_header_t *m = (rhmap_header_t *)map;
+	if (m->cap > 0) {
+		allocer_free_fast(m->alc, m->keys,
+				  keys_layout(m->cap, m->key_size));
+		allocer_free_fast(m->alc, m->vals,
+				  vals_layout(m->cap, m->val_size));
+		allocer_free_fast(m->alc, m->dists, dists_layout(m->cap));
+	}
+	m->cap = 0;
+	m->len = 0;
+}
+
+bool _rhmap_put_impl(anyptr map, const void *k_ptr, const void *v_ptr)
+{
+	rhmap_header_t *m = (rhmap_header_t *)map;
+
+	/// load factor check (7/8, nothing but live entries counts)
+	if (m->cap == 0 || (m->len + 1) * 8 > m->cap * 7) {
+		usize new_cap = (m->cap == 0) ? MIN_CAP : m->cap * 2;
+		if (!_rhmap_resize(m, new_cap))
+			return false;
+	}
+
+	usize idx;
+	_rhmap_dist_t d;
+	if (!_probe(m, k_ptr, m->ops.hash(k_ptr), &idx, &d)) {
+		/// new entry: insert from where the probe stopped
+		memcpy(key_at(m, m->cap), k_ptr, m->key_size);
+		memcpy(val_at(m, m->cap), v_ptr, m->val_size);
+		_insert_carried(m, idx, d);
+		return true;
+	}
+	/// update value
+	memcpy(val_at(m, idx), v_ptr, m->val_size);
+	return true;
+}
+
+void *_rhmap_get_impl(anyptr map, const void *k_ptr)
+{
+	rhmap_header_t *m = (rhmap_header_t *)map;
+	if (m->len == 0)
+		return nullptr;
+
+	usize idx;
+	_rhmap_dist_t d;
+	if (_probe(m, k_ptr, m->ops.hash(k_ptr), &idx, &d))
+		return val_at(m, idx);
+	return nullptr;
+}
+
+bool _rhmap_remove_impl(anyptr map, const void *k_ptr)
+{
+	rhmap_header_t *m = (rhmap_header_t *)map;
+	if (m->len == 0)
+		return false;
+
+	usize idx;
+	_rhmap_dist_t d;
+	if (!_probe(m, k_ptr, m->ops.hash(k_ptr), &idx, &d))
+		return false;
+
+	/// backward shift: pull the run after `idx` one slot closer to home
+	usize mask = m->cap - 1;
+	for (;;) {
+		usize next = (idx + 1) & mask;
+		_rhmap_dist_t nd = m->dists[next];
+		if (nd <= 1) {
+			/// empty, or already at home: the run ends here
+			m->dists[idx] = 0;
+			break;
+		}
+		copy_bytes(key_at(m, idx), key_at(m, next), m->key_size);
+		copy_bytes(val_at(m, idx), val_at(m, next), m->val_size);
+		m->dists[idx] = nd - 1;
+		idx = next;
+	}
+
+	m->len--;
+	return true;
+}
+
+void _rhmap_clear_impl(anyptr map)
+{
+	rhmap_header_t *m = (rhmap_header_t *)map;
+	if (m->cap > 0) {
+		memset(m->dists, 0, dists_layout(m->cap).size);
+		m->len = 0;
+	}
+}
+
+usize _rhmap_max_probe_impl(anyptr map)
+{
+	rhmap_header_t *m = (rhmap_header_t *)map;
+	usize max_d = 0;
+	for (usize i = 0; i < m->cap; ++i) {
+		if (m->dists[i] > max_d)
+			max_d = m->dists[i];
+	}
+	return max_d;
+}
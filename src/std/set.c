@@ -0,0 +1,322 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/set.h>
+#include <std/map/group.h> /// for the control group primitives
+#include <std/allocers/bump.h> /// for allocer_*_fast
+#include <core/math.h> /// for ctz64, checked_add
+#include <string.h> /// for memcpy, memset
+
+/*
+ * Internal Header Layout
+ */
+typedef struct {
+	u8 *keys;
+	u8 *states;
+	u32 *hashes; /// low 32 hash bits per slot, or nullptr
+	usize len;
+	usize cap;
+	usize occupied; /// len + deleted
+	allocer_t alc;
+	map_ops_t ops;
+	usize key_size;
+} set_header_t;
+
+/*
+ * ==========================================================================
+ * Table Logic (Group Probing, see std/map/group.h)
+ * ==========================================================================
+ */
+
+static bool _slot_eq(const void *table, usize idx, const void *key,
+		     u64 hash)
+{
+	const set_header_t *s = (const set_header_t *)table;
+	if (s->hashes && s->hashes[idx] != (u32)hash)
+		return false;
+	return s->ops.equals(key, s->keys + (idx * s->key_size));
+}
+
+/// return true if found existing key, false if found empty slot for insert
+static bool _find_slot(set_header_t *s, const void *key, u64 hash,
+		       usize *out_idx)
+{
+	return _map_probe(s->states, s->cap, hash, s, key, _slot_eq, out_idx);
+}
+
+/**
+ * Hash of the key in FULL slot `i`, good enough to probe a table of
+ * `target_cap` slots. With cached hashes the key is not hashed again: the
+ * low 32 bits come from the cache and H2 from the control byte.
+ */
+static inline u64 _slot_hash(const set_header_t *s, usize i, usize target_cap)
+{
+	if (s->hashes && target_cap <= ((usize)1 << 32))
+		return ((u64)s->states[i] << 57) | s->hashes[i];
+	return s->ops.hash(s->keys + (i * s->key_size));
+}
+
+static inline layout_t hashes_layout(usize cap)
+{
+	return layout_of_array(u32, cap);
+}
+
+static void _set_free_arrays(set_header_t *s)
+{
+	if (s->cap == 0)
+		return;
+	allocer_free_fast(s->alc, s->keys, layout(s->cap * s->key_size, 1));
+	allocer_free_fast(s->alc, s->states,
+			  layout(_map_ctrl_bytes(s->cap), 1));
+	if (s->hashes)
+		allocer_free_fast(s->alc, s->hashes, hashes_layout(s->cap));
+}
+
+/// cold: keep it out of the probe paths
+static noinline bool _set_resize(set_header_t *s, usize new_cap)
+{
+	layout_t l_keys = layout(new_cap * s->key_size, 1);
+	layout_t l_states = layout(_map_ctrl_bytes(new_cap), 1);
+	layout_t l_hashes = hashes_layout(new_cap);
+
+	u8 *keys = (u8 *)allocer_alloc_fast(s->alc, l_keys);
+	u8 *states = (u8 *)allocer_alloc_fast(s->alc, l_states);
+	u32 *hashes = s->ops.cache_hashes ?
+			      (u32 *)allocer_alloc_fast(s->alc, l_hashes) :
+			      nullptr;
+	if (!keys || !states || (s->ops.cache_hashes && !hashes)) {
+		if (keys)
+			allocer_free_fast(s->alc, keys, l_keys);
+		if (states)
+			allocer_free_fast(s->alc, states, l_states);
+		if (hashes)
+			allocer_free_fast(s->alc, hashes, l_hashes);
+		return false;
+	}
+	memset(states, _MAP_EMPTY, l_states.size);
+
+	/// rehash all FULL keys (no duplicates: no equality checks)
+	for (usize i = 0; i < s->cap; ++i) {
+		if (!_map_ctrl_full(s->states[i]))
+			continue;
+		u64 hash = _slot_hash(s, i, new_cap);
+		usize idx = _map_find_empty(states, new_cap, hash);
+		memcpy(keys + (idx * s->key_size), s->keys + (i * s->key_size),
+		       s->key_size);
+		if (hashes)
+			hashes[idx] = (u32)hash;
+		_map_set_ctrl(states, new_cap, idx, _map_h2(hash));
+	}
+
+	_set_free_arrays(s);
+	s->keys = keys;
+	s->states = states;
+	s->hashes = hashes;
+	s->cap = new_cap;
+	s->occupied = s->len;
+	return true;
+}
+
+/// insert `k_ptr` (with its precomputed hash) unless it is present
+static bool _set_insert_hashed(set_header_t *s, const void *k_ptr, u64 hash,
+			       bool *inserted)
+{
+	usize idx = 0;
+	if (s->cap > 0 && _find_slot(s, k_ptr, hash, &idx)) {
+		*inserted = false;
+		return true;
+	}
+
+	usize new_cap = _map_grow_cap(s->cap, s->len, s->occupied);
+	if (new_cap != 0) {
+		if (!_set_resize(s, new_cap))
+			return false;
+		idx = _map_find_empty(s->states, s->cap, hash);
+	}
+
+	if (s->states[idx] == _MAP_EMPTY)
+		s->occupied++;
+	memcpy(s->keys + (idx * s->key_size), k_ptr, s->key_size);
+	if (s->hashes)
+		s->hashes[idx] = (u32)hash;
+	_map_set_ctrl(s->states, s->cap, idx, _map_h2(hash));
+	s->len++;
+	*inserted = true;
+	return true;
+}
+
+/// is FULL slot `i` of `src` also in `s`?
+static bool _set_has_slot(set_header_t *s, const set_header_t *src, usize i)
+{
+	usize idx;
+	return s->len > 0 &&
+	       _find_slot(s, src->keys + (i * src->key_size),
+			  _slot_hash(src, i, s->cap), &idx);
+}
+
+static void _set_check_compatible(const set_header_t *a, const set_header_t *b)
+{
+	massert(a->key_size == b->key_size, "set: key sizes differ");
+	massert(a->ops.hash == b->ops.hash, "set: hash functions differ");
+	unused(a);
+	unused(b);
+}
+
+/*
+ * ==========================================================================
+ * Public Implementation
+ * ==========================================================================
+ */
+
+bool _set_init_impl(anyptr set, allocer_t alc, map_ops_t ops, usize k_sz)
+{
+	set_header_t *s = (set_header_t *)set;
+	s->keys = nullptr;
+	s->states = nullptr;
+	s->hashes = nullptr;
+	s->len = 0;
+	s->cap = 0;
+	s->occupied = 0;
+	s->alc = alc;
+	s->ops = ops;
+	s->key_size = k_sz;
+	return true;
+}
+
+void _set_deinit_impl(anyptr set)
+{
+	set_header_t *s = (set_header_t *)set;
+	_set_free_arrays(s);
+	s->keys = nullptr;
+	s->states = nullptr;
+	s->hashes = nullptr;
+	s->cap = 0;
+	s->len = 0;
+	s->occupied = 0;
+}
+
+bool _set_reserve_impl(anyptr set, usize additional)
+{
+	set_header_t *s = (set_header_t *)set;
+	usize want;
+	if (checked_add(s->len, additional, &want))
+		return false;
+	usize cap = _map_cap_for(want);
+	return cap <= s->cap || _set_resize(s, cap);
+}
+
+bool _set_insert_impl(anyptr set, const void *k_ptr, bool *inserted)
+{
+	set_header_t *s = (set_header_t *)set;
+	bool fresh;
+	if (!_set_insert_hashed(s, k_ptr, s->ops.hash(k_ptr), &fresh))
+		return false;
+	if (inserted)
+		*inserted = fresh;
+	return true;
+}
+
+bool _set_contains_impl(anyptr set, const void *k_ptr)
+{
+	set_header_t *s = (set_header_t *)set;
+	usize idx;
+	return s->len > 0 && _find_slot(s, k_ptr, s->ops.hash(k_ptr), &idx);
+}
+
+bool _set_remove_impl(anyptr set, const void *k_ptr)
+{
+	set_header_t *s = (set_header_t *)set;
+	if (s->len == 0)
+		return false;
+
+	usize idx;
+	if (!_find_slot(s, k_ptr, s->ops.hash(k_ptr), &idx))
+		return false;
+	if (_map_erase_ctrl(s->states, s->cap, idx))
+		s->occupied--;
+	s->len--;
+	return true;
+}
+
+void _set_clear_impl(anyptr set)
+{
+	set_header_t *s = (set_header_t *)set;
+	if (s->cap > 0) {
+		memset(s->states, _MAP_EMPTY, _map_ctrl_bytes(s->cap));
+		s->len = 0;
+		s->occupied = 0;
+	}
+}
+
+bool _set_union_impl(anyptr dst, anyptr src)
+{
+	set_header_t *d = (set_header_t *)dst;
+	set_header_t *s = (set_header_t *)src;
+	_set_check_compatible(d, s);
+	if (d == s || s->len == 0)
+		return true;
+
+	/// the sets may overlap: assume half of `src` is new unless `dst` is
+	/// empty, growth covers the rest
+	usize expect = d->len == 0 ? s->len : (s->len + 1) / 2;
+	if (!_set_reserve_impl(d, expect))
+		return false;
+
+	/// growth doubles only past len >= cap / 2: `d` never gets bigger
+	usize max_cap = 4 * _map_cap_for(d->len + s->len);
+	for (usize i = 0; i < s->cap; ++i) {
+		if (!_map_ctrl_full(s->states[i]))
+			continue;
+		u64 hash = _slot_hash(s, i, max_cap);
+		bool fresh;
+		if (!_set_insert_hashed(d, s->keys + (i * s->key_size), hash,
+					&fresh))
+			return false;
+	}
+	return true;
+}
+
+void _set_intersect_impl(anyptr dst, anyptr other)
+{
+	set_header_t *d = (set_header_t *)dst;
+	set_header_t *o = (set_header_t *)other;
+	_set_check_compatible(d, o);
+	if (d == o)
+		return;
+
+	for (usize i = 0; i < d->cap && d->len > 0; ++i) {
+		if (!_map_ctrl_full(d->states[i]) || _set_has_slot(o, d, i))
+			continue;
+		if (_map_erase_ctrl(d->states, d->cap, i))
+			d->occupied--;
+		d->len--;
+	}
+}
+
+bool _set_contains_all_impl(anyptr set, anyptr sub)
+{
+	set_header_t *s = (set_header_t *)set;
+	set_header_t *b = (set_header_t *)sub;
+	_set_check_compatible(s, b);
+	if (b->len > s->len)
+		return false;
+
+	for (usize i = 0; i < b->cap; ++i) {
+		if (_map_ctrl_full(b->states[i]) && !_set_has_slot(s, b, i))
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,118 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/smallvec.h>
+#include <std/allocers/bump.h> /// for allocer_*_fast
+#include <core/math.h> /// for align_up, min
+#include <core/msg.h> /// for massert
+#include <string.h> /// for memcpy
+
+/*
+ * Internal layout matching the macro definition (the inline buffer follows,
+ * aligned for the element type).
+ */
+typedef struct {
+	u8 *data;
+	usize len;
+	usize cap;
+	allocer_t alc;
+	allocer_t backing;
+	usize inline_size; /// bytes in the inline buffer
+} smallvec_header_t;
+
+static inline u8 *inline_buf(smallvec_header_t *v, usize align)
+{
+	return (u8 *)v + align_up(sizeof(smallvec_header_t), align);
+}
+
+/*
+ * ==========================================================================
+ * Spilling Adapter
+ * ==========================================================================
+ * `vec` only ever reallocs and frees its buffer through `alc`; the inline
+ * buffer is recognized by address (the layout carries the element
+ * alignment, which fixes its offset). `alc` belongs to this one vector:
+ * it hands out the inline buffer whenever the vector holds nothing else.
+ */
+
+static anyptr _smallvec_vt_alloc(anyptr self, layout_t layout)
+{
+	smallvec_header_t *v = (smallvec_header_t *)self;
+	return allocer_alloc_fast(v->backing, layout);
+}
+
+static anyptr _smallvec_vt_zalloc(anyptr self, layout_t layout)
+{
+	smallvec_header_t *v = (smallvec_header_t *)self;
+	return allocer_zalloc_fast(v->backing, layout);
+}
+
+static void _smallvec_vt_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	smallvec_header_t *v = (smallvec_header_t *)self;
+	if (ptr == inline_buf(v, layout.align))
+		return;
+	allocer_free_fast(v->backing, ptr, layout);
+}
+
+static anyptr _smallvec_vt_realloc(anyptr self, anyptr ptr, layout_t old,
+				   layout_t new_l)
+{
+	smallvec_header_t *v = (smallvec_header_t *)self;
+	u8 *buf = inline_buf(v, old.align);
+	/// `vec_shrink_to_fit` emptied the vector: take the inline buffer back
+	if (ptr == nullptr && v->data == nullptr)
+		ptr = buf;
+	if (ptr != buf)
+		return allocer_realloc_fast(v->backing, ptr, old, new_l);
+	/// shrinks and regrowth that still fit stay inline
+	if (new_l.size <= v->inline_size)
+		return ptr;
+	/// the spill: first trip to the heap
+	anyptr heap = allocer_alloc_fast(v->backing, new_l);
+	if (heap)
+		memcpy(heap, ptr, min(old.size, new_l.size));
+	return heap;
+}
+
+static const allocer_vtable_t SMALLVEC_VTABLE = {
+	.alloc = _smallvec_vt_alloc,
+	.free = _smallvec_vt_free,
+	.realloc = _smallvec_vt_realloc,
+	.zalloc = _smallvec_vt_zalloc,
+};
+
+/*
+ * ==========================================================================
+ * Public API Implementation
+ * ==========================================================================
+ */
+
+void _smallvec_init_impl(anyptr vec, allocer_t backing, anyptr inline_data,
+			 usize inline_cap, usize inline_size,
+			 [[maybe_unused]] usize align)
+{
+	smallvec_header_t *v = (smallvec_header_t *)vec;
+	massert(inline_data == inline_buf(v, align),
+		"smallvec: unexpected inline buffer offset");
+
+	v->data = (u8 *)inline_data;
+	v->len = 0;
+	v->cap = inline_cap;
+	v->alc = (allocer_t){ .self = v, .vtable = &SMALLVEC_VTABLE };
+	v->backing = backing;
+	v->inline_size = inline_size;
+}
@@ -37,7 +37,10 @@ static bool _eq_str(const void *a, const void *b)
 	return str_eq(*s1, *s2);
 }
 
-static const map_ops_t MAP_OPS_STR = { .hash = _hash_str, .equals = _eq_str };
+/// identifiers are rehashed on every growth otherwise
+static const map_ops_t MAP_OPS_STR = { .hash = _hash_str,
+				       .equals = _eq_str,
+				       .cache_hashes = true };
 
 /*
  * ==========================================================================
@@ -101,10 +104,14 @@ void intern_drop(interner_t *it)
 
 symbol_t intern(interner_t *it, str_t s)
 {
-	/// 1. fast Lookup
-	symbol_t *existing = map_get(it->map, s);
-	if (existing) {
-		return *existing;
+	/// 1. single probe: find the symbol or claim a slot for it
+	bool inserted;
+	symbol_t *slot = map_entry(it->map, s, &inserted);
+	if (unlikely(!slot)) {
+		log_panic("Interner map OOM");
+	}
+	if (!inserted) {
+		return *slot;
 	}
 
 	/// 2. slow Path: Intern New String
@@ -116,20 +123,18 @@ symbol_t intern(interner_t *it, str_t s)
 	}
 
 	/// b. Create Key
+	/// the slot still holds the caller's borrowed `s`: point it at the copy
 	str_t stable_str = str_from_parts(stable_ptr, s.len);
+	*map_key_at(it->map, slot) = stable_str;
 
 	/// c. Create Symbol
 	symbol_t sym = { .id = (u32)vec_len(it->vec) };
 
 	/// d. Store (Vec + Map)
-	/// order matters: Map stores the key pointing to Bump memory
 	if (unlikely(!vec_push(it->vec, stable_str))) {
 		log_panic("Interner vec OOM");
 	}
-
-	if (unlikely(!map_put(it->map, stable_str, sym))) {
-		log_panic("Interner map OOM");
-	}
+	*slot = sym;
 
 	return sym;
 }
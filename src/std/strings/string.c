@@ -15,6 +15,7 @@
  */
 
 #include <std/strings/string.h>
+#include <std/allocers/bump.h> /// for allocer_*_fast
 #include <core/math.h>
 #include <core/msg.h>
 #include <stdio.h> /// vsnprintf
@@ -39,7 +40,8 @@ static bool string_grow(string_t *s, usize needed)
 	layout_t old_l = layout(s->cap, 1);
 	layout_t new_l = layout(new_cap, 1); /// strings align to 1
 
-	char *new_data = (char *)allocer_realloc(s->alc, s->data, old_l, new_l);
+	char *new_data =
+		(char *)allocer_realloc_fast(s->alc, s->data, old_l, new_l);
 	if (!new_data)
 		return false;
 
@@ -72,7 +74,7 @@ void string_deinit(string_t *s)
 {
 	if (s->data) {
 		layout_t l = layout(s->cap, 1);
-		allocer_free(s->alc, s->data, l);
+		allocer_free_fast(s->alc, s->data, l);
 	}
 	s->data = nullptr;
 	s->len = 0;
@@ -82,13 +84,13 @@ void string_deinit(string_t *s)
 string_t *string_new(allocer_t alc, usize cap_hint)
 {
 	/// 1. alloc header
-	string_t *s = (string_t *)allocer_alloc(alc, layout_of(string_t));
+	string_t *s = (string_t *)allocer_alloc_fast(alc, layout_of(string_t));
 	if (!s)
 		return nullptr;
 
 	/// 2. init body
 	if (!string_init(s, alc, cap_hint)) {
-		allocer_free(alc, s, layout_of(string_t));
+		allocer_free_fast(alc, s, layout_of(string_t));
 		return nullptr;
 	}
 	return s;
@@ -99,7 +101,7 @@ void string_drop(string_t *s)
 	if (s) {
 		allocer_t alc = s->alc;
 		string_deinit(s);
-		allocer_free(alc, s, layout_of(string_t));
+		allocer_free_fast(alc, s, layout_of(string_t));
 	}
 }
 
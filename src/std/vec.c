@@ -15,7 +15,9 @@
  */
 
 #include <std/vec.h>
+#include <std/allocers/bump.h> /// for allocer_*_fast
 #include <core/math.h>
+#include <string.h> /// for memcpy, memmove
 
 /*
  * Internal layout matching the macro definition.
@@ -43,7 +45,7 @@ bool _vec_init_impl(anyptr vec_struct, allocer_t alc, usize cap,
 			return false;
 
 		layout_t l = layout(total_bytes, align);
-		v->data = (u8 *)allocer_alloc(alc, l);
+		v->data = (u8 *)allocer_alloc_fast(alc, l);
 		if (!v->data)
 			return false;
 		v->cap = cap;
@@ -58,7 +60,7 @@ void _vec_deinit_impl(anyptr vec_struct, usize item_size, usize align)
 		/// we must assume current capacity is valid
 		usize total_bytes = v->cap * item_size;
 		layout_t l = layout(total_bytes, align);
-		allocer_free(v->alc, v->data, l);
+		allocer_free_fast(v->alc, v->data, l);
 	}
 	v->data = nullptr;
 	v->len = 0;
@@ -79,7 +81,7 @@ static bool _vec_realloc_internal(vec_header_t *v, usize new_cap,
 	layout_t old_l = layout(old_bytes, align);
 	layout_t new_l = layout(new_bytes, align);
 
-	u8 *new_data = (u8 *)allocer_realloc(v->alc, v->data, old_l, new_l);
+	u8 *new_data = (u8 *)allocer_realloc_fast(v->alc, v->data, old_l, new_l);
 	if (!new_data)
 		return false;
 
@@ -124,3 +126,87 @@ bool _vec_reserve_impl(anyptr vec_struct, usize additional, usize item_size,
 
 	return _vec_realloc_internal(v, new_cap, item_size, align);
 }
+
+/*
+ * ==========================================================================
+ * Bulk Operations
+ * ==========================================================================
+ */
+
+/// whether `p` points into the vector's current buffer
+static inline bool _vec_owns(const vec_header_t *v, const void *p,
+			     usize item_size)
+{
+	uptr addr = (uptr)p, base = (uptr)v->data;
+	return v->data && addr >= base && addr < base + v->cap * item_size;
+}
+
+bool _vec_extend_impl(anyptr vec_struct, const void *src, usize n,
+		      usize item_size, usize align)
+{
+	vec_header_t *v = (vec_header_t *)vec_struct;
+	if (n == 0)
+		return true;
+
+	/// `src` may be our own buffer, which the reserve can move
+	const u8 *from = (const u8 *)src;
+	bool aliased = _vec_owns(v, from, item_size);
+	usize offset = aliased ? (usize)(from - v->data) : 0;
+
+	if (!_vec_reserve_impl(v, n, item_size, align))
+		return false;
+	if (aliased)
+		from = v->data + offset;
+
+	memcpy(v->data + v->len * item_size, from, n * item_size);
+	v->len += n;
+	return true;
+}
+
+bool _vec_insert_impl(anyptr vec_struct, usize index, const void *src,
+		      usize n, usize item_size, usize align)
+{
+	vec_header_t *v = (vec_header_t *)vec_struct;
+	if (unlikely(index > v->len))
+		log_panic("vec insert index out of bounds: %zu > %zu", index,
+			  v->len);
+	if (n == 0)
+		return true;
+	massert(!_vec_owns(v, src, item_size),
+		"vec_insert_n: source overlaps the vector");
+
+	if (!_vec_reserve_impl(v, n, item_size, align))
+		return false;
+
+	u8 *at = v->data + index * item_size;
+	memmove(at + n * item_size, at, (v->len - index) * item_size);
+	memcpy(at, src, n * item_size);
+	v->len += n;
+	return true;
+}
+
+void _vec_remove_range_impl(anyptr vec_struct, usize start, usize end,
+			    usize item_size)
+{
+	vec_header_t *v = (vec_header_t *)vec_struct;
+	if (unlikely(start > end || end > v->len))
+		log_panic("vec range out of bounds: [%zu, %zu) with len %zu",
+			  start, end, v->len);
+
+	memmove(v->data + start * item_size, v->data + end * item_size,
+		(v->len - end) * item_size);
+	v->len -= end - start;
+}
+
+bool _vec_shrink_impl(anyptr vec_struct, usize item_size, usize align)
+{
+	vec_header_t *v = (vec_header_t *)vec_struct;
+	if (v->cap == v->len)
+		return true;
+
+	if (v->len == 0) {
+		_vec_deinit_impl(v, item_size, align);
+		return true;
+	}
+	return _vec_realloc_internal(v, v->len, item_size, align);
+}
@@ -16,10 +16,15 @@
 
 #include <std/test.h>
 #include <std/allocers/bump.h>
+#include <std/vec.h>
+#include <std/strings/string.h>
 #include <core/mem/allocer.h>
 #include <core/math.h>
 #include <string.h>
 #include <stdlib.h> /// for malloc/free in mock
+#include <pthread.h> /// for concurrent arena tests
+#include <std/allocers/devirt.h>
+#include <std/allocers/system.h>
 
 /*
  * ==========================================================================
@@ -336,6 +341,626 @@ TEST(bump_string_helper)
 	return true;
 }
 
+/*
+ * ==========================================================================
+ * 7. Realloc (In-Place Tip Resize)
+ * ==========================================================================
+ */
+
+/// bytes in use in the current chunk (between the bump ptr and the footer)
+static usize chunk_used(bump_t *bump)
+{
+	chunk_footer_t *footer = bump->current_chunk;
+	return (usize)((u8 *)footer - footer->ptr);
+}
+
+TEST(bump_realloc_tip_in_place)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	u8 *p = (u8 *)bump_alloc(&bump, 16, 1);
+	for (int i = 0; i < 16; ++i)
+		p[i] = (u8)i;
+	expect_eq(chunk_used(&bump), usize_(16));
+
+	/// 1. grow the tip: slides down, old bytes are not left behind
+	u8 *q = (u8 *)bump_realloc(&bump, p, 16, 64, 1);
+	expect(q != nullptr);
+	expect(q < p);
+	expect_eq(chunk_used(&bump), usize_(64));
+	for (int i = 0; i < 16; ++i)
+		expect_eq(q[i], u8_(i));
+
+	/// 2. shrink the tip: address is kept
+	u8 *r = (u8 *)bump_realloc(&bump, q, 64, 8, 1);
+	expect(r == q);
+	expect_eq(chunk_used(&bump), usize_(64));
+
+	/// still a single chunk
+	expect_eq(mock_st.alloc_calls, usize_(1));
+
+	bump_deinit(&bump);
+	return true;
+}
+
+TEST(bump_realloc_not_tip_copies)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	int *a = bump_alloc_array(&bump, int, 4);
+	for (int i = 0; i < 4; ++i)
+		a[i] = i * 10;
+
+	/// `b` is now the tip, so `a` must be copied
+	int *b = bump_alloc_type(&bump, int);
+	*b = 7;
+
+	int *a2 = (int *)bump_realloc(&bump, a, sizeof(int) * 4,
+				      sizeof(int) * 8, alignof(int));
+	expect(a2 != nullptr);
+	expect(a2 != a);
+	expect_eq(*b, 7); /// neighbour untouched
+	for (int i = 0; i < 4; ++i)
+		expect_eq(a2[i], i * 10);
+
+	bump_deinit(&bump);
+	return true;
+}
+
+TEST(bump_realloc_high_align)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	u64 *p = (u64 *)bump_alloc(&bump, 24, 64);
+	p[0] = 1;
+	p[2] = 3;
+
+	u64 *q = (u64 *)bump_realloc(&bump, p, 24, 200, 64);
+	expect(q != nullptr);
+	expect(is_aligned((uptr)q, 64));
+	expect_eq(q[0], u64_(1));
+	expect_eq(q[2], u64_(3));
+
+	bump_deinit(&bump);
+	return true;
+}
+
+TEST(bump_vec_growth_no_garbage)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	vec(u32) v;
+	expect(vec_init(v, bump_allocer(&bump), 0));
+
+	/// 8 -> 16 -> ... -> 512 elements, every growth hits the tip
+	for (u32 i = 0; i < 500; ++i)
+		expect(vec_push(v, i));
+
+	/// the arena only holds the final buffer (no 8+16+...+256 garbage)
+	expect_eq(chunk_used(&bump), vec_cap(v) * sizeof(u32));
+	expect_eq(mock_st.alloc_calls, usize_(1));
+
+	for (u32 i = 0; i < 500; ++i)
+		expect_eq(vec_at(v, i), i);
+
+	bump_deinit(&bump);
+	return true;
+}
+
+TEST(bump_string_growth_no_garbage)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	string_t s;
+	expect(string_init(&s, bump_allocer(&bump), 0));
+
+	for (int i = 0; i < 1000; ++i)
+		expect(string_push(&s, (char)('a' + i % 26)));
+
+	expect_eq(chunk_used(&bump), s.cap);
+	expect_eq(string_len(&s), usize_(1000));
+	expect_eq(string_cstr(&s)[0], 'a');
+	expect_eq(string_cstr(&s)[999], (char)('a' + 999 % 26));
+
+	bump_deinit(&bump);
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * 8. Concurrent Mode
+ * ==========================================================================
+ */
+
+#define WORKERS 8
+#define NODES_PER_WORKER 20000
+
+struct Worker {
+	bump_t *bump;
+	u64 id;
+	u64 *nodes[NODES_PER_WORKER];
+};
+
+static void *worker_main(void *arg)
+{
+	struct Worker *w = (struct Worker *)arg;
+	allocer_t alc = bump_allocer(w->bump);
+
+	for (u64 i = 0; i < NODES_PER_WORKER; ++i) {
+		/// mix sizes so some requests force new chunks
+		usize n = 1 + (i % 7);
+		u64 *node = (u64 *)allocer_alloc(alc, layout_of_array(u64, n));
+		if (!node)
+			return nullptr;
+		for (usize j = 0; j < n; ++j)
+			node[j] = (w->id << 32) | i;
+		w->nodes[i] = node;
+	}
+	return w;
+}
+
+TEST(bump_concurrent_workers)
+{
+	/// the mock is not thread-safe, but chunk growth is serialized
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+
+	bump_t bump;
+	bump_init_concurrent(&bump, backing, 8);
+
+	static struct Worker workers[WORKERS];
+	pthread_t threads[WORKERS];
+	for (u64 t = 0; t < WORKERS; ++t) {
+		workers[t].bump = &bump;
+		workers[t].id = t;
+		expect(pthread_create(&threads[t], nullptr, worker_main,
+				      &workers[t]) == 0);
+	}
+
+	bool all_ok = true;
+	for (u64 t = 0; t < WORKERS; ++t) {
+		void *ret = nullptr;
+		pthread_join(threads[t], &ret);
+		all_ok = all_ok && ret != nullptr;
+	}
+	expect(all_ok);
+
+	/// no two threads got overlapping memory: every node kept its pattern
+	for (u64 t = 0; t < WORKERS; ++t) {
+		for (u64 i = 0; i < NODES_PER_WORKER; ++i) {
+			u64 *node = workers[t].nodes[i];
+			expect(is_aligned((uptr)node, 8));
+			usize n = 1 + (i % 7);
+			for (usize j = 0; j < n; ++j)
+				expect_eq(node[j], (t << 32) | i);
+		}
+	}
+
+	/// one reset releases everything but the tip
+	bump_reset(&bump);
+	expect_eq(mock_st.alloc_calls - mock_st.free_calls, usize_(1));
+
+	bump_deinit(&bump);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * 9. Global Chunk Pool
+ * ==========================================================================
+ */
+
+TEST(bump_pool_steady_state)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_pool_set_limit(1 << 20);
+	bump_pool_stats_t before = bump_pool_stats();
+
+	usize calls_after_warmup = 0;
+	for (int round = 0; round < 50; ++round) {
+		/// a short-lived per-request arena spanning three chunks
+		bump_t bump;
+		bump_init(&bump, backing, 1);
+		for (int i = 0; i < 5; ++i)
+			expect(bump_alloc(&bump, 3000, 8) != nullptr);
+		bump_deinit(&bump);
+
+		if (round == 0)
+			calls_after_warmup = mock_st.alloc_calls;
+	}
+
+	/// every chunk after the first round came from the pool
+	expect_eq(mock_st.alloc_calls, calls_after_warmup);
+	expect_eq(mock_st.free_calls, usize_(0));
+
+	bump_pool_stats_t after = bump_pool_stats();
+	expect(after.hits - before.hits >= usize_(49 * 3));
+	expect(after.cached_chunks > 0);
+
+	/// trim returns everything to the backing allocator
+	bump_pool_trim();
+	expect_eq(bump_pool_stats().cached_bytes, usize_(0));
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+
+	bump_pool_set_limit(0);
+	return true;
+}
+
+TEST(bump_pool_high_water_mark)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	/// room for a single default chunk only
+	bump_pool_set_limit(4096);
+
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+	for (int i = 0; i < 5; ++i)
+		expect(bump_alloc(&bump, 3000, 1) != nullptr);
+	usize chunks = mock_st.alloc_calls;
+	bump_deinit(&bump);
+
+	bump_pool_stats_t st = bump_pool_stats();
+	expect(st.cached_bytes <= usize_(4096));
+	/// whatever did not fit went back to the backing allocator
+	expect_eq(mock_st.free_calls + st.cached_chunks, chunks);
+
+	/// disabling the pool frees the rest
+	bump_pool_set_limit(0);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+TEST(bump_pool_respects_backing)
+{
+	struct MockState st_a, st_b;
+	allocer_t a = mock_allocator(&st_a);
+	allocer_t b = mock_allocator(&st_b);
+	bump_pool_set_limit(1 << 20);
+
+	bump_t bump;
+	bump_init(&bump, a, 1);
+	expect(bump_alloc(&bump, 100, 1) != nullptr);
+	bump_deinit(&bump);
+
+	/// a chunk cached from `a` is never handed to an arena backed by `b`
+	bump_init(&bump, b, 1);
+	expect(bump_alloc(&bump, 100, 1) != nullptr);
+	expect_eq(st_b.alloc_calls, usize_(1));
+	bump_deinit(&bump);
+
+	bump_pool_set_limit(0);
+	expect_eq(st_a.bytes_allocated, usize_(0));
+	expect_eq(st_b.bytes_allocated, usize_(0));
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * 10. Checkpoints & Scratch Arenas
+ * ==========================================================================
+ */
+
+TEST(bump_mark_rewind_same_chunk)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	u64 *keep = bump_alloc_type(&bump, u64);
+	*keep = 42;
+	bump_mark_t m = bump_mark(&bump);
+	usize used = chunk_used(&bump);
+
+	for (int i = 0; i < 10; ++i)
+		expect(bump_alloc(&bump, 100, 8) != nullptr);
+	bump_rewind_to(&bump, m, false);
+
+	/// back to the mark, earlier data untouched
+	expect_eq(chunk_used(&bump), used);
+	expect_eq(*keep, u64_(42));
+
+	bump_deinit(&bump);
+	return true;
+}
+
+TEST(bump_mark_rewind_across_chunks)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	expect(bump_alloc(&bump, 100, 1) != nullptr);
+	bump_mark_t m = bump_mark(&bump);
+	chunk_footer_t *chunk = bump.current_chunk;
+
+	for (int i = 0; i < 5; ++i)
+		expect(bump_alloc(&bump, 3000, 8) != nullptr);
+	expect(bump.current_chunk != chunk);
+
+	/// newer chunks released, the marked one is current again
+	bump_rewind_to(&bump, m, false);
+	expect(bump.current_chunk == chunk);
+	expect_eq(mock_st.alloc_calls, mock_st.free_calls + 1);
+
+	/// a mark on a fresh arena rewinds everything
+	bump_t fresh;
+	bump_init(&fresh, backing, 1);
+	bump_mark_t empty = bump_mark(&fresh);
+	expect(bump_alloc(&fresh, 5000, 8) != nullptr);
+	bump_rewind_to(&fresh, empty, false);
+	expect_eq(bump_get_allocated_bytes(&fresh), usize_(0));
+	bump_deinit(&fresh);
+
+	bump_deinit(&bump);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+TEST(bump_rewind_keeps_chunks)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t bump;
+	bump_init(&bump, backing, 1);
+
+	expect(bump_alloc(&bump, 100, 1) != nullptr);
+	bump_mark_t m = bump_mark(&bump);
+
+	usize calls_after_warmup = 0;
+	for (int round = 0; round < 20; ++round) {
+		/// a pass that spills over several chunks every time
+		for (int i = 0; i < 5; ++i) {
+			u8 *p = (u8 *)bump_alloc(&bump, 3000, 8);
+			expect(p != nullptr);
+			memset(p, round, 3000);
+		}
+		bump_rewind_to(&bump, m, true);
+
+		if (round == 0)
+			calls_after_warmup = mock_st.alloc_calls;
+	}
+
+	/// later passes run entirely on the kept chunks
+	expect_eq(mock_st.alloc_calls, calls_after_warmup);
+	expect_eq(mock_st.free_calls, usize_(0));
+
+	bump_release_spare(&bump);
+	expect_eq(mock_st.alloc_calls, mock_st.free_calls + 1);
+
+	bump_deinit(&bump);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+static u64 *scratch_sum(bump_t *out, u64 n, bump_t **used)
+{
+	/// result lives in `out`, temporaries in the other scratch arena
+	bump_scratch_let(tmp, out);
+	*used = tmp.arena;
+
+	u64 *squares = bump_alloc_array(tmp.arena, u64, n);
+	for (u64 i = 0; i < n; ++i)
+		squares[i] = i * i;
+
+	u64 *sum = bump_alloc_type(out, u64);
+	*sum = 0;
+	for (u64 i = 0; i < n; ++i)
+		*sum += squares[i];
+	return sum;
+}
+
+TEST(bump_scratch_scopes)
+{
+	bump_t *outer_arena;
+	bump_mark_t before;
+	{
+		bump_scratch_let(outer, nullptr);
+		outer_arena = outer.arena;
+		before = outer.mark;
+
+		/// the outer scratch is the conflict for the inner one
+		bump_t *inner_arena = nullptr;
+		u64 *sum = scratch_sum(outer.arena, 1000, &inner_arena);
+		expect(inner_arena != outer.arena);
+		expect_eq(*sum, u64_(332833500));
+
+		for (int i = 0; i < 100; ++i)
+			expect(bump_alloc(outer.arena, 1000, 8) != nullptr);
+	}
+
+	/// leaving the scope rewound the arena
+	bump_mark_t after = bump_mark(outer_arena);
+	expect(after.chunk == before.chunk);
+	expect(after.ptr == before.ptr);
+
+	bump_scratch_release();
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * 11. Devirtualized Dispatch
+ * ==========================================================================
+ */
+
+TEST(bump_alloc_inline_matches)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+	bump_t a, b;
+	bump_init(&a, backing, 4);
+	bump_init(&b, backing, 4);
+
+	/// the inline fast path consumes exactly what the regular one does
+	/// (alignments up to the chunk alignment, so padding is the same)
+	usize sizes[] = { 1, 7, 24, 3000, 0, 100, 5000, 33 };
+	usize aligns[] = { 1, 8, 8, 16, 4, 16, 8, 2 };
+	for (usize i = 0; i < array_size(sizes); ++i) {
+		layout_t l = layout(sizes[i], aligns[i]);
+		u8 *p = (u8 *)bump_alloc_inline(&a, l);
+		u8 *q = (u8 *)bump_alloc_layout(&b, l);
+		expect(p != nullptr && q != nullptr);
+		expect(is_aligned((uptr)p, aligns[i]));
+		expect_eq(chunk_used(&a), chunk_used(&b));
+	}
+
+	/// invalid alignments fall back to 1 on both paths
+	usize bad_aligns[] = { 0, 3, 12, 24, 100 };
+	for (usize i = 0; i < array_size(bad_aligns); ++i) {
+		layout_t l = { .size = 40 + i, .align = bad_aligns[i] };
+		u8 *p = (u8 *)bump_alloc_inline(&a, l);
+		u8 *q = (u8 *)bump_alloc_layout(&b, l);
+		expect(p != nullptr && q != nullptr);
+		expect(is_aligned((uptr)p, 4));
+		expect_eq(chunk_used(&a), chunk_used(&b));
+	}
+
+	bump_deinit(&a);
+	bump_deinit(&b);
+	return true;
+}
+
+TEST(bump_devirt_wrappers)
+{
+	struct MockState mock_st;
+	bump_t bump;
+	bump_init(&bump, mock_allocator(&mock_st), 1);
+
+	allocer_t alc = allocer_of(&bump);
+	expect(allocer_is_bump(alc));
+	expect(allocer_of(alc).self == &bump); /// allocer_t passes through
+	expect(!allocer_is_bump(allocer_system()));
+
+	u64 *p = (u64 *)allocer_zalloc_fast(alc, layout_of_array(u64, 4));
+	expect_eq(p[3], u64_(0));
+	p[0] = 9;
+
+	/// realloc goes straight to bump_realloc: the tip grows in place
+	u64 *q = (u64 *)allocer_realloc_fast(alc, p, layout_of_array(u64, 4),
+					     layout_of_array(u64, 8));
+	expect_eq(q[0], u64_(9));
+	expect_eq(chunk_used(&bump), sizeof(u64) * 8);
+
+	allocer_free_fast(alc, q, layout_of_array(u64, 8));
+	bump_deinit(&bump);
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Layout Round-Trip
+ * ==========================================================================
+ * The system allocator picks free() or munmap() from the layout it is
+ * given back, so every chunk must be freed with the layout it was
+ * allocated with, alignment included.
+ */
+
+#define LAYOUT_LOG_MAX 8
+
+struct LayoutLog {
+	anyptr ptrs[LAYOUT_LOG_MAX];
+	layout_t layouts[LAYOUT_LOG_MAX];
+	usize live;
+	usize mismatches;
+};
+
+static anyptr layout_log_alloc(anyptr self, layout_t l)
+{
+	struct LayoutLog *log = (struct LayoutLog *)self;
+	anyptr p = allocer_alloc(allocer_system(), l);
+	if (p && log->live < LAYOUT_LOG_MAX) {
+		log->ptrs[log->live] = p;
+		log->layouts[log->live++] = l;
+	}
+	return p;
+}
+
+static void layout_log_free(anyptr self, anyptr ptr, layout_t l)
+{
+	struct LayoutLog *log = (struct LayoutLog *)self;
+	for (usize i = 0; i < log->live; ++i) {
+		if (log->ptrs[i] != ptr)
+			continue;
+		if (log->layouts[i].size != l.size ||
+		    log->layouts[i].align != l.align)
+			log->mismatches++;
+		/// free with the recorded layout, whatever we were given
+		allocer_free(allocer_system(), ptr, log->layouts[i]);
+		log->ptrs[i] = log->ptrs[--log->live];
+		log->layouts[i] = log->layouts[log->live];
+		return;
+	}
+	log->mismatches++;
+}
+
+static const allocer_vtable_t LAYOUT_LOG_VTABLE = {
+	.alloc = layout_log_alloc,
+	.free = layout_log_free,
+};
+
+TEST(bump_huge_overaligned_chunk)
+{
+	/// >= 64 MiB with align > page size: posix_memalign, never mmap
+	const usize huge = (usize)80 << 20;
+	const usize align = 1 << 16;
+
+	struct LayoutLog log = { 0 };
+	allocer_t backing = { .self = &log, .vtable = &LAYOUT_LOG_VTABLE };
+
+	/// 1. straight back to the backing allocator
+	bump_t b;
+	bump_init(&b, backing, 1);
+	u8 *p = bump_alloc(&b, huge, align);
+	expect(p != nullptr);
+	expect(is_aligned((uptr)p, align));
+	p[0] = 1;
+	p[huge - 1] = 2;
+	bump_deinit(&b);
+	expect_eq(log.live, usize_(0));
+	expect_eq(log.mismatches, usize_(0));
+
+	/// 2. through the chunk pool, then trimmed
+	bump_pool_set_limit((usize)256 << 20);
+	bump_init(&b, backing, 1);
+	expect(bump_alloc(&b, huge, align) != nullptr);
+	bump_deinit(&b); /// cached, not freed
+	bump_init(&b, backing, 1);
+	expect(bump_alloc(&b, huge - 4096, align) != nullptr); /// reused
+	bump_deinit(&b);
+	bump_pool_set_limit(0);
+	bump_pool_trim();
+	expect_eq(log.live, usize_(0));
+	expect_eq(log.mismatches, usize_(0));
+
+	/// 3. the real system allocator end to end
+	bump_init(&b, allocer_system(), 1);
+	p = bump_alloc(&b, huge, align);
+	expect(p != nullptr);
+	p[huge - 1] = 3;
+	bump_deinit(&b);
+	return true;
+}
+
 int main()
 {
 	RUN(bump_lifecycle_stack);
@@ -347,6 +972,22 @@ int main()
 	RUN(bump_oom_backing);
 	RUN(bump_as_allocer_vtable);
 	RUN(bump_string_helper);
+	RUN(bump_realloc_tip_in_place);
+	RUN(bump_realloc_not_tip_copies);
+	RUN(bump_realloc_high_align);
+	RUN(bump_vec_growth_no_garbage);
+	RUN(bump_string_growth_no_garbage);
+	RUN(bump_concurrent_workers);
+	RUN(bump_pool_steady_state);
+	RUN(bump_pool_high_water_mark);
+	RUN(bump_pool_respects_backing);
+	RUN(bump_mark_rewind_same_chunk);
+	RUN(bump_mark_rewind_across_chunks);
+	RUN(bump_rewind_keeps_chunks);
+	RUN(bump_scratch_scopes);
+	RUN(bump_alloc_inline_matches);
+	RUN(bump_devirt_wrappers);
+	RUN(bump_huge_overaligned_chunk);
 
 	SUMMARY();
 }
@@ -0,0 +1,179 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/cmap.h>
+#include <std/allocers/system.h>
+#include <pthread.h> /// for the concurrent tests
+
+defCmap(u64, u64, U64Cmap);
+
+/*
+ * ==========================================================================
+ * Single Thread
+ * ==========================================================================
+ */
+
+TEST(cmap_basic)
+{
+	U64Cmap m;
+	expect(cmap_init(m, allocer_system(), MAP_OPS_U64));
+
+	expect(cmap_put(m, 1, 10));
+	expect(cmap_put(m, 2, 20));
+	expect(cmap_put(m, 1, 11));
+	expect_eq(cmap_len(m), usize_(2));
+
+	u64 v = 0;
+	expect(cmap_get(m, 1, &v));
+	expect_eq(v, u64_(11));
+	expect(!cmap_get(m, 3, &v));
+	expect(cmap_contains(m, 2));
+
+	bool inserted = true;
+	expect(cmap_get_or_put(m, 2, 99, &v, &inserted));
+	expect(!inserted);
+	expect_eq(v, u64_(20));
+	expect(cmap_get_or_put(m, 3, 30, &v, &inserted));
+	expect(inserted);
+	expect_eq(v, u64_(30));
+
+	expect(cmap_remove(m, 1));
+	expect(!cmap_remove(m, 1));
+	expect(!cmap_contains(m, 1));
+
+	cmap_clear(m);
+	expect_eq(cmap_len(m), usize_(0));
+	expect(!cmap_contains(m, 2));
+
+	cmap_deinit(m);
+	return true;
+}
+
+TEST(cmap_shards)
+{
+	/// any shard count works, 1 being a single global lock
+	static const usize counts[] = { 1, 3, 64 };
+	for (usize c = 0; c < array_size(counts); ++c) {
+		U64Cmap m;
+		expect(cmap_init_shards(m, allocer_system(), MAP_OPS_U64,
+					counts[c]));
+		for (u64 i = 0; i < 5000; ++i)
+			expect(cmap_put(m, i, i * 2));
+		expect_eq(cmap_len(m), usize_(5000));
+
+		u64 v;
+		for (u64 i = 0; i < 5000; ++i)
+			expect(cmap_get(m, i, &v) && v == i * 2);
+
+		/// every shard got some keys
+		usize used = 0;
+		for (usize s = 0; s < m.shard_count; ++s)
+			used += map_len(m.shards[s].map) > 0;
+		expect_eq(used, m.shard_count);
+		cmap_deinit(m);
+	}
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Concurrent
+ * ==========================================================================
+ */
+
+#define WORKERS 8
+#define KEYS_PER_WORKER 20000
+#define SHARED_KEYS 1000
+
+typedef struct {
+	U64Cmap *map;
+	u64 id;
+	bool ok;
+} Worker;
+
+/// own keys: put, read back, remove half; shared keys: race to insert
+static void *worker_main(void *arg)
+{
+	Worker *w = (Worker *)arg;
+	U64Cmap *m = w->map;
+	u64 base = (w->id + 1) << 32;
+	w->ok = true;
+
+	for (u64 i = 0; i < KEYS_PER_WORKER; ++i) {
+		if (!cmap_put(*m, base | i, i))
+			w->ok = false;
+
+		u64 shared;
+		if (!cmap_get_or_put(*m, i % SHARED_KEYS, w->id, &shared,
+				     nullptr))
+			w->ok = false;
+		/// the winner's id, whoever it was, never changes
+		u64 again = ~0ull;
+		if (!cmap_get(*m, i % SHARED_KEYS, &again) || again != shared)
+			w->ok = false;
+	}
+	for (u64 i = 0; i < KEYS_PER_WORKER; ++i) {
+		u64 v;
+		if (!cmap_get(*m, base | i, &v) || v != i)
+			w->ok = false;
+		if (i % 2 && !cmap_remove(*m, base | i))
+			w->ok = false;
+	}
+	return nullptr;
+}
+
+TEST(cmap_concurrent_workers)
+{
+	U64Cmap m;
+	expect(cmap_init_shards(m, allocer_system(), MAP_OPS_U64, 4));
+
+	static Worker workers[WORKERS];
+	pthread_t threads[WORKERS];
+	for (u64 t = 0; t < WORKERS; ++t) {
+		workers[t] = (Worker){ .map = &m, .id = t };
+		expect(pthread_create(&threads[t], nullptr, worker_main,
+				      &workers[t]) == 0);
+	}
+	for (u64 t = 0; t < WORKERS; ++t) {
+		pthread_join(threads[t], nullptr);
+		expect(workers[t].ok);
+	}
+
+	/// half of every worker's keys plus the shared ones are left
+	expect_eq(cmap_len(m), usize_(WORKERS * KEYS_PER_WORKER / 2 +
+				      SHARED_KEYS));
+	for (u64 t = 0; t < WORKERS; ++t) {
+		u64 base = (t + 1) << 32;
+		for (u64 i = 0; i < KEYS_PER_WORKER; ++i)
+			expect(cmap_contains(m, base | i) == (i % 2 == 0));
+	}
+	u64 v;
+	for (u64 i = 0; i < SHARED_KEYS; ++i)
+		expect(cmap_get(m, i, &v) && v < WORKERS);
+
+	cmap_deinit(m);
+	return true;
+}
+
+int main()
+{
+	RUN(cmap_basic);
+	RUN(cmap_shards);
+	RUN(cmap_concurrent_workers);
+
+	SUMMARY();
+}
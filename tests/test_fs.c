@@ -242,6 +242,43 @@ TEST(fs_type_check)
 	return true;
 }
 
+TEST(fs_fingerprint)
+{
+	clean_env();
+	static char data[100000];
+	for (usize i = 0; i < sizeof(data); ++i)
+		data[i] = (char)(i * 131 + (i >> 9));
+
+	/// empty, short path, the 48-byte boundary, many blocks
+	static const usize sizes[] = { 0, 1, 47, 48, 49, 4096, 100000 };
+	for (usize i = 0; i < array_size(sizes); ++i) {
+		str_t content = { .ptr = data, .len = sizes[i] };
+		expect(file_write(TEST_FILE, content));
+		hash128_t fp;
+		expect(file_fingerprint(TEST_FILE, &fp));
+		expect(hash128_eq(fp, hash128_bytes(data, sizes[i])));
+	}
+
+	/// one byte in the middle of a large file changes the fingerprint
+	hash128_t before, after;
+	expect(file_fingerprint(TEST_FILE, &before));
+	data[50000] ^= 1;
+	expect(file_write(TEST_FILE, (str_t){ .ptr = data, .len = 100000 }));
+	expect(file_fingerprint(TEST_FILE, &after));
+	expect(before.lo != after.lo && before.hi != after.hi);
+
+	/// not a regular file: streamed instead of mapped
+#if !defined(_WIN32)
+	hash128_t empty;
+	expect(file_fingerprint("/dev/null", &empty));
+	expect(hash128_eq(empty, hash128_bytes("", 0)));
+#endif
+
+	expect(file_fingerprint(NON_EXISTENT_FILE, &before) == false);
+	clean_env();
+	return true;
+}
+
 int main()
 {
 	RUN(fs_lifecycle);
@@ -251,6 +288,7 @@ int main()
 	RUN(fs_binary_safety);
 	RUN(fs_fail_conditions);
 	RUN(fs_type_check);
+	RUN(fs_fingerprint);
 
 	clean_env(); /// final cleanup
 	SUMMARY();
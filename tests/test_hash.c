@@ -0,0 +1,415 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <core/hash.h>
+#include <core/math.h> /// for min
+#include <string.h> /// for memcpy, memset, strlen
+#include <core/type.h>
+
+/*
+ * ==========================================================================
+ * Helpers
+ * ==========================================================================
+ */
+
+static u64 splitmix(u64 *state)
+{
+	u64 z = (*state += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+static void fill_random(u8 *buf, usize len, u64 *state)
+{
+	for (usize i = 0; i < len; i += 8) {
+		u64 r = splitmix(state);
+		memcpy(buf + i, &r, min(usize_(8), len - i));
+	}
+}
+
+#define AVALANCHE_SAMPLES 2000
+#define AVALANCHE_MAX_KEY 128
+
+/// per (input bit, output bit) flip counts
+static u32 g_flips[AVALANCHE_MAX_KEY * 8][64];
+
+/**
+ * SMHasher-style avalanche: flip every input bit of random keys and count how
+ * often each output bit changes. Returns the worst |p - 0.5| over all pairs.
+ */
+static double avalanche_bias(usize len, u64 (*fn)(const u8 *, usize))
+{
+	u64 state = len * 0x51ed27ull;
+	u8 key[AVALANCHE_MAX_KEY];
+	memset(g_flips, 0, sizeof(g_flips));
+
+	for (usize n = 0; n < AVALANCHE_SAMPLES; ++n) {
+		fill_random(key, len, &state);
+		u64 h0 = fn(key, len);
+		for (usize bit = 0; bit < len * 8; ++bit) {
+			key[bit / 8] ^= (u8)(1u << (bit % 8));
+			u64 diff = h0 ^ fn(key, len);
+			key[bit / 8] ^= (u8)(1u << (bit % 8));
+			for (usize j = 0; j < 64; ++j)
+				g_flips[bit][j] += (u32)((diff >> j) & 1);
+		}
+	}
+
+	double worst = 0;
+	for (usize bit = 0; bit < len * 8; ++bit) {
+		for (usize j = 0; j < 64; ++j) {
+			double p = (double)g_flips[bit][j] / AVALANCHE_SAMPLES;
+			double bias = p > 0.5 ? p - 0.5 : 0.5 - p;
+			worst = bias > worst ? bias : worst;
+		}
+	}
+	return worst;
+}
+
+static u64 via_bytes(const u8 *key, usize len)
+{
+	return hash_bytes(key, len);
+}
+
+static u64 via_u64(const u8 *key, [[maybe_unused]] usize len)
+{
+	u64 x;
+	memcpy(&x, key, sizeof(x));
+	return hash_u64(x);
+}
+
+static u64 via_u32(const u8 *key, [[maybe_unused]] usize len)
+{
+	u32 x;
+	memcpy(&x, key, sizeof(x));
+	return hash_u32(x);
+}
+
+/// 4.5 sigma of the sampling noise at 2000 samples is about 0.05
+#define MAX_BIAS 0.07
+
+/*
+ * ==========================================================================
+ * Quality
+ * ==========================================================================
+ */
+
+TEST(hash_avalanche_bytes)
+{
+	/// every length class: short, 4..16, 17..48 and the 3-lane loop
+	static const usize lens[] = { 2, 3, 4, 7, 8, 12, 16, 17, 24,
+				      33, 48, 49, 64, 96, 100, 128 };
+	for (usize i = 0; i < array_size(lens); ++i) {
+		double bias = avalanche_bias(lens[i], via_bytes);
+		if (bias > MAX_BIAS)
+			fprintf(stderr, "len %zu: bias %.3f\n", lens[i], bias);
+		expect(bias <= MAX_BIAS);
+	}
+	return true;
+}
+
+TEST(hash_avalanche_mixers)
+{
+	expect(avalanche_bias(sizeof(u64), via_u64) <= MAX_BIAS);
+	expect(avalanche_bias(sizeof(u32), via_u32) <= MAX_BIAS);
+	return true;
+}
+
+TEST(hash_sequential_keys_spread)
+{
+	/// sequential integers must fill the low bits (bucket index) and the
+	/// top 7 bits (the map's control byte) evenly
+	enum { KEYS = 1 << 16, BUCKETS = 256 };
+	static u32 low[BUCKETS], top[128];
+	memset(low, 0, sizeof(low));
+	memset(top, 0, sizeof(top));
+
+	for (u64 k = 0; k < KEYS; ++k) {
+		u64 h = hash_u64(k);
+		low[h & (BUCKETS - 1)]++;
+		top[h >> 57]++;
+	}
+
+	/// chi-square with 255 / 127 degrees of freedom, far above p = 0.001
+	double chi_low = 0, chi_top = 0;
+	double e_low = (double)KEYS / BUCKETS, e_top = (double)KEYS / 128;
+	for (usize i = 0; i < BUCKETS; ++i)
+		chi_low += (low[i] - e_low) * (low[i] - e_low) / e_low;
+	for (usize i = 0; i < 128; ++i)
+		chi_top += (top[i] - e_top) * (top[i] - e_top) / e_top;
+	expect(chi_low < 350.0);
+	expect(chi_top < 200.0);
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Behaviour
+ * ==========================================================================
+ */
+
+TEST(hash_mixers_match_bytes)
+{
+	/// the dedicated mixers are `hash_bytes` specialized for one word
+	u64 state = 7;
+	for (usize i = 0; i < 1000; ++i) {
+		u64 x = splitmix(&state);
+		u32 y = (u32)x;
+		expect_eq(hash_u64(x), hash_bytes(&x, sizeof(x)));
+		expect_eq(hash_u32(y), hash_bytes(&y, sizeof(y)));
+	}
+	int obj;
+	usize addr = (usize)&obj;
+	expect_eq(hash_ptr(&obj), hash_u64(addr));
+	return true;
+}
+
+TEST(hash_length_and_seed)
+{
+	/// a zero-filled buffer: only the length tells the prefixes apart
+	u8 zeros[200] = { 0 };
+	u64 seen[201];
+	for (usize len = 0; len <= 200; ++len) {
+		seen[len] = hash_bytes(zeros, len);
+		for (usize j = 0; j < len; ++j)
+			expect(seen[j] != seen[len]);
+	}
+
+	const char *s = "hello, world";
+	expect_eq(hash_bytes(s, 12), hash_bytes_seeded(s, 12, 0));
+	expect(hash_bytes_seeded(s, 12, 1) != hash_bytes_seeded(s, 12, 2));
+	expect(hash_val(zeros[0]) == hash_bytes(zeros, 1));
+	return true;
+}
+
+TEST(hash_unaligned_input)
+{
+	/// the same bytes at every offset hash the same
+	u8 buf[256 + 8];
+	u64 state = 3;
+	fill_random(buf, sizeof(buf), &state);
+	u8 copy[256 + 8];
+	for (usize off = 1; off < 8; ++off) {
+		memcpy(copy + off, buf, 256);
+		expect_eq(hash_bytes(copy + off, 256), hash_bytes(buf, 256));
+		expect_eq(hash_bytes(copy + off, 37), hash_bytes(buf, 37));
+	}
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * Streaming
+ * ==========================================================================
+ */
+
+TEST(hasher_matches_one_shot)
+{
+	static u8 buf[1000];
+	u64 state = 11;
+	fill_random(buf, sizeof(buf), &state);
+
+	/// every length through the short, 17..48 and lane paths, fed in
+	/// random-sized pieces (including empty ones)
+	for (usize len = 0; len <= 400; ++len) {
+		hasher_t h;
+		hasher_init(&h);
+		for (usize off = 0; off < len;) {
+			usize n = (usize)(splitmix(&state) % 70);
+			n = min(n, len - off);
+			hasher_update(&h, buf + off, n);
+			off += n;
+		}
+		expect_eq(hasher_finish(&h), hash_bytes(buf, len));
+	}
+
+	/// one large update, then byte by byte
+	hasher_t big, bytes;
+	hasher_init_seeded(&big, 42);
+	hasher_init_seeded(&bytes, 42);
+	hasher_update(&big, buf, sizeof(buf));
+	for (usize i = 0; i < sizeof(buf); ++i)
+		hasher_update(&bytes, buf + i, 1);
+	expect_eq(hasher_finish(&big), hash_bytes_seeded(buf, sizeof(buf), 42));
+	expect_eq(hasher_finish(&bytes), hasher_finish(&big));
+	return true;
+}
+
+TEST(hasher_composite_key)
+{
+	/// hashing fields one at a time equals hashing them laid out flat
+	const char *dir = "src/std/";
+	const char *name = "map.c";
+	u64 mtime = 1700000000;
+
+	hasher_t h;
+	hasher_init(&h);
+	hasher_update(&h, dir, strlen(dir));
+	hasher_update(&h, name, strlen(name));
+	hasher_write_u64(&h, mtime);
+
+	u8 flat[64];
+	usize n = 0;
+	memcpy(flat + n, dir, strlen(dir));
+	n += strlen(dir);
+	memcpy(flat + n, name, strlen(name));
+	n += strlen(name);
+	memcpy(flat + n, &mtime, sizeof(mtime));
+	n += sizeof(mtime);
+	expect_eq(hasher_finish(&h), hash_bytes(flat, n));
+
+	/// finish is a snapshot: writing more changes the digest again
+	u64 before = hasher_finish(&h);
+	expect_eq(hasher_finish(&h), before);
+	hasher_write_u64(&h, 0);
+	expect(hasher_finish(&h) != before);
+	return true;
+}
+
+/*
+ * ==========================================================================
+ * 128-bit Fingerprints
+ * ==========================================================================
+ */
+
+static u64 via_hash128_lo(const u8 *key, usize len)
+{
+	return hash128_bytes(key, len).lo;
+}
+
+static u64 via_hash128_hi(const u8 *key, usize len)
+{
+	return hash128_bytes(key, len).hi;
+}
+
+TEST(hash128_quality)
+{
+	/// both halves must avalanche on their own
+	static const usize lens[] = { 3, 8, 16, 40, 48, 49, 96, 128 };
+	for (usize i = 0; i < array_size(lens); ++i) {
+		expect(avalanche_bias(lens[i], via_hash128_lo) <= MAX_BIAS);
+		expect(avalanche_bias(lens[i], via_hash128_hi) <= MAX_BIAS);
+	}
+
+	static u8 buf[300];
+	u64 state = 5;
+	fill_random(buf, sizeof(buf), &state);
+	for (usize len = 0; len <= sizeof(buf); ++len) {
+		hash128_t fp = hash128_bytes(buf, len);
+		expect(fp.lo != fp.hi);
+	}
+
+	/// a change in any single word reaches both halves
+	hash128_t base = hash128_bytes(buf, 256);
+	for (usize w = 0; w < 256 / 8; ++w) {
+		buf[w * 8] ^= 0x80;
+		hash128_t fp = hash128_bytes(buf, 256);
+		buf[w * 8] ^= 0x80;
+		expect(fp.lo != base.lo && fp.hi != base.hi);
+	}
+	return true;
+}
+
+TEST(hasher128_matches_one_shot)
+{
+	static u8 buf[1000];
+	u64 state = 13;
+	fill_random(buf, sizeof(buf), &state);
+
+	for (usize len = 0; len <= 400; len += 7) {
+		hasher128_t h;
+		hasher128_init(&h);
+		for (usize off = 0; off < len;) {
+			usize n = (usize)(splitmix(&state) % 100);
+			n = min(n, len - off);
+			hasher128_update(&h, buf + off, n);
+			off += n;
+		}
+		hash128_t fp = hasher128_finish(&h);
+		expect(hash128_eq(fp, hash128_bytes(buf, len)));
+	}
+	return true;
+}
+
+TEST(hash128_known_answers)
+{
+	/// fingerprints are persisted: these must never change
+	static const struct {
+		const char *in;
+		u64 lo, hi;
+	} strs[] = {
+		{ "", 0x93228a4de0eec5a2, 0x261992d326ee6a58 },
+		{ "a", 0xf60afd8e64f72c4b, 0x526478e7e1e16b0b },
+		{ "abc", 0x7270d92a69eaa3b2, 0xda9778fa0d129d6c },
+		{ "message digest", 0x492e7a7c2dd650ed, 0x54ef3b96f9fd9870 },
+		{ "The quick brown fox jumps over the lazy dog",
+		  0xfc2493fa5e3579b7, 0xa5f1b3c25c62ca9b },
+	};
+	for (usize i = 0; i < array_size(strs); ++i) {
+		hash128_t fp = hash128_bytes(strs[i].in, strlen(strs[i].in));
+		expect_eq(fp.lo, strs[i].lo);
+		expect_eq(fp.hi, strs[i].hi);
+	}
+
+	/// block boundaries and the multi-block path, on a fixed pattern
+	static u8 buf[1000];
+	for (usize i = 0; i < sizeof(buf); ++i)
+		buf[i] = (u8)(i * 31 + 7);
+	static const struct {
+		usize len;
+		u64 lo, hi;
+	} blocks[] = {
+		{ 48, 0xb0a011ed05b47d3d, 0x695e14b0f3101eeb },
+		{ 49, 0x18788be9e7dee8f5, 0x1342f4ab37bc8ed5 },
+		{ 96, 0x8aeaf66ad5fa223b, 0xa64ee4c2e9e111dc },
+		{ 97, 0x2c6ba257f5af3aab, 0x1844fead3840e584 },
+		{ 1000, 0x60369411bd869737, 0x029d55fb4240331c },
+	};
+	for (usize i = 0; i < array_size(blocks); ++i) {
+		hash128_t fp = hash128_bytes(buf, blocks[i].len);
+		expect_eq(fp.lo, blocks[i].lo);
+		expect_eq(fp.hi, blocks[i].hi);
+	}
+	return true;
+}
+
+TEST(hash_fnv1a_reference)
+{
+	/// published FNV-1a 64 test vectors
+	expect_eq(hash_fnv1a("", 0), u64_(0xcbf29ce484222325));
+	expect_eq(hash_fnv1a("a", 1), u64_(0xaf63dc4c8601ec8c));
+	expect_eq(hash_fnv1a("foobar", 6), u64_(0x85944171f73967e8));
+	return true;
+}
+
+int main()
+{
+	RUN(hash_avalanche_bytes);
+	RUN(hash_avalanche_mixers);
+	RUN(hash_sequential_keys_spread);
+	RUN(hash_mixers_match_bytes);
+	RUN(hash_length_and_seed);
+	RUN(hash_unaligned_input);
+	RUN(hasher_matches_one_shot);
+	RUN(hasher_composite_key);
+	RUN(hash128_quality);
+	RUN(hasher128_matches_one_shot);
+	RUN(hash128_known_answers);
+	RUN(hash_fnv1a_reference);
+	SUMMARY();
+}
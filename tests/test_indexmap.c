@@ -0,0 +1,228 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/indexmap.h>
+#include <std/allocers/system.h>
+#include <string.h>
+
+/*
+ * ==========================================================================
+ * Helpers
+ * ==========================================================================
+ */
+
+/// every key shares one home slot and one H2
+static u64 _hash_collide(const void *key)
+{
+	unused(key);
+	return 3;
+}
+
+static bool _eq_u64(const void *a, const void *b)
+{
+	return *(const u64 *)a == *(const u64 *)b;
+}
+
+static const map_ops_t MAP_OPS_COLLIDE = { .hash = _hash_collide,
+					   .equals = _eq_u64 };
+
+/*
+ * ==========================================================================
+ * Tests
+ * ==========================================================================
+ */
+
+TEST(indexmap_basic)
+{
+	indexmap(u32, int) m;
+	expect(indexmap_init(m, allocer_system(), MAP_OPS_U32));
+
+	expect(indexmap_put(m, 30, 300));
+	expect(indexmap_put(m, 10, 100));
+	expect(indexmap_put(m, 20, 200));
+	expect_eq(indexmap_len(m), usize_(3));
+
+	expect_eq(*indexmap_get(m, 10), 100);
+	expect(indexmap_get(m, 40) == nullptr);
+	expect_eq(indexmap_index_of(m, 20), usize_(2));
+	expect_eq(indexmap_index_of(m, 40), (usize)-1);
+
+	/// update keeps the position
+	expect(indexmap_put(m, 30, 301));
+	expect_eq(indexmap_len(m), usize_(3));
+	expect_eq(indexmap_at(m, 0)->key, u32_(30));
+	expect_eq(indexmap_at(m, 0)->val, 301);
+
+	indexmap_deinit(m);
+	return true;
+}
+
+TEST(indexmap_insertion_order)
+{
+	indexmap(u64, u64) m;
+	expect(indexmap_init(m, allocer_system(), MAP_OPS_U64));
+
+	/// scrambled keys, through several table rebuilds
+	for (u64 i = 0; i < 10000; ++i)
+		expect(indexmap_put(m, i * 2654435761u % 100003, i));
+
+	u64 i = 0;
+	indexmap_foreach(it, m)
+	{
+		expect_eq(it->key, i * 2654435761u % 100003);
+		expect_eq(it->val, i);
+		i++;
+	}
+	expect_eq(i, u64_(10000));
+
+	for (u64 j = 0; j < 10000; ++j)
+		expect_eq(indexmap_index_of(m, j * 2654435761u % 100003), j);
+
+	indexmap_deinit(m);
+	return true;
+}
+
+TEST(indexmap_swap_remove)
+{
+	indexmap(u64, u64) m;
+	expect(indexmap_init(m, allocer_system(), MAP_OPS_U64));
+	for (u64 i = 0; i < 5; ++i)
+		expect(indexmap_put(m, i, i * 10));
+
+	/// [0 1 2 3 4] -> [0 4 2 3]
+	expect(indexmap_swap_remove(m, 1));
+	expect(!indexmap_swap_remove(m, 1));
+	expect_eq(indexmap_len(m), usize_(4));
+	expect_eq(indexmap_at(m, 1)->key, u64_(4));
+	expect_eq(indexmap_index_of(m, 4), usize_(1));
+	expect_eq(*indexmap_get(m, 4), u64_(40));
+
+	/// removing the last entry moves nothing
+	expect(indexmap_swap_remove(m, 3));
+	expect_eq(indexmap_len(m), usize_(3));
+	expect_eq(indexmap_at(m, 2)->key, u64_(2));
+
+	/// new keys go to the end
+	expect(indexmap_put(m, 7, 70));
+	expect_eq(indexmap_index_of(m, 7), usize_(3));
+
+	indexmap_deinit(m);
+	return true;
+}
+
+TEST(indexmap_churn)
+{
+	indexmap(u64, u64) m;
+	expect(indexmap_init(m, allocer_system(), MAP_OPS_U64));
+
+	/// a sliding window: tombstones must not grow the table forever
+	for (u64 i = 0; i < 100; ++i)
+		expect(indexmap_put(m, i, i));
+	for (u64 i = 100; i < 50000; ++i) {
+		expect(indexmap_swap_remove(m, i - 100));
+		expect(indexmap_put(m, i, i));
+	}
+	expect_eq(indexmap_len(m), usize_(100));
+	expect(m.cap <= 256);
+
+	for (u64 i = 0; i < 50000; ++i) {
+		u64 *v = indexmap_get(m, i);
+		expect((v != nullptr) == (i >= 49900));
+	}
+	indexmap_foreach(it, m)
+	{
+		expect_eq(indexmap_index_of(m, it->key),
+			  (usize)(it - m.entries.data));
+	}
+
+	indexmap_deinit(m);
+	return true;
+}
+
+TEST(indexmap_collisions)
+{
+	indexmap(u64, u64) m;
+	expect(indexmap_init(m, allocer_system(), MAP_OPS_COLLIDE));
+
+	for (u64 i = 0; i < 200; ++i)
+		expect(indexmap_put(m, i, i + 1));
+	for (u64 i = 0; i < 200; i += 2)
+		expect(indexmap_swap_remove(m, i));
+	for (u64 i = 0; i < 200; ++i) {
+		u64 *v = indexmap_get(m, i);
+		if (i % 2)
+			expect(v != nullptr && *v == i + 1);
+		else
+			expect(v == nullptr);
+	}
+
+	indexmap_deinit(m);
+	return true;
+}
+
+TEST(indexmap_string_keys)
+{
+	indexmap(const char *, int) m;
+	expect(indexmap_init(m, allocer_system(), MAP_OPS_CSTR));
+
+	/// lookups go by content, not address
+	char buf[8];
+	strcpy(buf, "beta");
+	expect(indexmap_put(m, "alpha", 1));
+	expect(indexmap_put(m, "beta", 2));
+	expect_eq(*indexmap_get(m, (const char *)buf), 2);
+
+	indexmap_clear(m);
+	expect(indexmap_is_empty(m));
+	expect(indexmap_get(m, "alpha") == nullptr);
+	expect(indexmap_put(m, "gamma", 3));
+	expect_eq(indexmap_index_of(m, "gamma"), usize_(0));
+
+	indexmap_deinit(m);
+	return true;
+}
+
+TEST(indexmap_reserve)
+{
+	indexmap(u32, u32) m;
+	expect(indexmap_init(m, allocer_system(), MAP_OPS_U32));
+	expect(indexmap_reserve(m, 1000));
+
+	/// no rebuild or reallocation before the reserved count
+	usize cap = m.cap;
+	void *data = m.entries.data;
+	for (u32 i = 0; i < 1000; ++i)
+		expect(indexmap_put(m, i, i));
+	expect_eq(m.cap, cap);
+	expect(m.entries.data == data);
+
+	indexmap_deinit(m);
+	return true;
+}
+
+int main()
+{
+	RUN(indexmap_basic);
+	RUN(indexmap_insertion_order);
+	RUN(indexmap_swap_remove);
+	RUN(indexmap_churn);
+	RUN(indexmap_collisions);
+	RUN(indexmap_string_keys);
+	RUN(indexmap_reserve);
+
+	SUMMARY();
+}
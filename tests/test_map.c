@@ -45,6 +45,42 @@ static bool _eq_point(const void *a, const void *b)
 static const map_ops_t MAP_OPS_POINT = { .hash = _hash_point,
 					 .equals = _eq_point };
 
+/// every key lands in the same group with the same H2 fragment
+static u64 _hash_collide(const void *key)
+{
+	unused(key);
+	return 0x2a;
+}
+
+static bool _eq_collide(const void *a, const void *b)
+{
+	return *(const u64 *)a == *(const u64 *)b;
+}
+
+static const map_ops_t MAP_OPS_COLLIDE = { .hash = _hash_collide,
+					   .equals = _eq_collide };
+
+/// counts calls; H2 (top 7 bits) is the same for every key
+static usize _hash_calls = 0;
+static usize _eq_calls = 0;
+
+static u64 _hash_counted(const void *key)
+{
+	_hash_calls++;
+	u64 h = *(const u64 *)key * 0x9e3779b97f4a7c15ull;
+	return h & ~(0x7full << 57);
+}
+
+static bool _eq_counted(const void *a, const void *b)
+{
+	_eq_calls++;
+	return *(const u64 *)a == *(const u64 *)b;
+}
+
+static const map_ops_t MAP_OPS_COUNTED = { .hash = _hash_counted,
+					   .equals = _eq_counted,
+					   .cache_hashes = true };
+
 /*
  * ==========================================================================
  * Tests
@@ -231,6 +267,277 @@ TEST(map_clear_reuse)
 	return true;
 }
 
+TEST(map_full_collisions)
+{
+	allocer_t sys = allocer_system();
+	map(u64, u64) m;
+	expect(map_init(m, sys, MAP_OPS_COLLIDE));
+
+	/// probes must spill over several groups and wrap around the table
+	for (u64 i = 0; i < 200; ++i)
+		expect(map_put(m, i, i + 1));
+	expect_eq(map_len(m), usize_(200));
+
+	for (u64 i = 0; i < 200; ++i) {
+		u64 *val = map_get(m, i);
+		expect(val != nullptr);
+		expect_eq(*val, i + 1);
+	}
+	expect(map_get(m, 1000) == nullptr);
+
+	/// removing from the middle of the chain keeps the rest reachable
+	for (u64 i = 0; i < 200; i += 2)
+		expect(map_remove(m, i));
+	for (u64 i = 0; i < 200; ++i) {
+		u64 *val = map_get(m, i);
+		expect((val != nullptr) == (i % 2 == 1));
+	}
+
+	map_deinit(m);
+	return true;
+}
+
+TEST(map_remove_churn)
+{
+	allocer_t sys = allocer_system();
+	map(u64, u64) m;
+	expect(map_init(m, sys, MAP_OPS_U64));
+
+	for (u64 i = 0; i < 64; ++i)
+		expect(map_put(m, i, i));
+	usize cap = map_cap(m);
+
+	/// a sliding window of live keys: tombstones must not grow the table
+	for (u64 i = 64; i < 100000; ++i) {
+		expect(map_remove(m, i - 64));
+		expect(map_put(m, i, i));
+	}
+	expect_eq(map_len(m), usize_(64));
+	expect_eq(map_cap(m), cap);
+
+	for (u64 i = 100000 - 64; i < 100000; ++i)
+		expect_eq(*map_get(m, i), i);
+	expect(map_get(m, 0) == nullptr);
+
+	map_deinit(m);
+	return true;
+}
+
+/// counts calls so the test can check `init` is evaluated lazily
+static int _make_calls = 0;
+static int _make_value(int v)
+{
+	_make_calls++;
+	return v;
+}
+
+TEST(map_entry_api)
+{
+	allocer_t sys = allocer_system();
+	map(u32, int) m;
+	expect(map_init(m, sys, MAP_OPS_U32));
+
+	/// 1. entry inserts a zero-filled value
+	bool inserted = false;
+	int *v = map_entry(m, 7, &inserted);
+	expect(v != nullptr);
+	expect(inserted);
+	expect_eq(*v, 0);
+	*v = 70;
+
+	/// 2. a second entry finds it
+	v = map_entry(m, 7, &inserted);
+	expect(!inserted);
+	expect_eq(*v, 70);
+	expect_eq(map_len(m), usize_(1));
+
+	/// 3. counting without the `inserted` flag, across several resizes
+	for (u32 i = 0; i < 300; ++i)
+		(*map_entry(m, i % 100, nullptr))++;
+	expect_eq(map_len(m), usize_(100));
+	expect_eq(*map_get(m, 7), 73);
+	expect_eq(*map_get(m, 8), 3);
+
+	/// 4. the stored key is reachable from the value
+	expect_eq(*map_key_at(m, map_get(m, 42)), u32_(42));
+
+	map_deinit(m);
+	return true;
+}
+
+TEST(map_get_or_insert_with)
+{
+	allocer_t sys = allocer_system();
+	map(u32, int) m;
+	expect(map_init(m, sys, MAP_OPS_U32));
+
+	_make_calls = 0;
+	int *v = map_get_or_insert_with(m, 1, _make_value(10));
+	expect_eq(*v, 10);
+	expect_eq(_make_calls, 1);
+
+	/// present: `init` is not evaluated
+	v = map_get_or_insert_with(m, 1, _make_value(99));
+	expect_eq(*v, 10);
+	expect_eq(_make_calls, 1);
+
+	map_deinit(m);
+	return true;
+}
+
+TEST(map_cached_hashes)
+{
+	allocer_t sys = allocer_system();
+	map(u64, u64) m;
+	expect(map_init(m, sys, MAP_OPS_COUNTED));
+
+	/// one hash per insert: growth reuses the cached bits
+	_hash_calls = 0;
+	for (u64 i = 0; i < 5000; ++i)
+		expect(map_put(m, i, i));
+	expect_eq(_hash_calls, usize_(5000));
+	expect(map_cap(m) >= 4096);
+
+	/// every H2 matches, but the cached bits filter out the other keys
+	_eq_calls = 0;
+	for (u64 i = 0; i < 5000; ++i)
+		expect_eq(*map_get(m, i), i);
+	expect_eq(_eq_calls, usize_(5000));
+
+	/// removal and clear keep the cache consistent
+	for (u64 i = 0; i < 5000; i += 2)
+		expect(map_remove(m, i));
+	for (u64 i = 0; i < 5000; ++i)
+		expect((map_get(m, i) != nullptr) == (i % 2 == 1));
+	map_clear(m);
+	expect(map_put(m, 9, 90));
+	expect_eq(*map_get(m, 9), u64_(90));
+
+	map_deinit(m);
+	return true;
+}
+
+TEST(map_incremental_growth)
+{
+	allocer_t sys = allocer_system();
+	map(u64, u64) m;
+	expect(map_init_incremental(m, sys, MAP_OPS_U64));
+
+	/// every key stays reachable while the old table drains
+	bool saw_migration = false;
+	for (u64 i = 0; i < 20000; ++i) {
+		expect(map_put(m, i, i * 3));
+		if (map_is_migrating(m)) {
+			saw_migration = true;
+			expect_eq(*map_get(m, i / 2), (i / 2) * 3);
+		}
+	}
+	expect(saw_migration);
+	expect_eq(map_len(m), usize_(20000));
+	for (u64 i = 0; i < 20000; ++i)
+		expect_eq(*map_get(m, i), i * 3);
+
+	/// lookups alone finish the migration
+	for (usize i = 0; i < map_cap(m) && map_is_migrating(m); ++i)
+		(void)map_get(m, 0);
+	expect(!map_is_migrating(m));
+	expect_eq(map_len(m), usize_(20000));
+
+	map_deinit(m);
+	return true;
+}
+
+TEST(map_incremental_mutation)
+{
+	allocer_t sys = allocer_system();
+	map(u64, u64) m;
+	expect(map_init_incremental(m, sys, MAP_OPS_U64));
+
+	/// fill up to the point where the next put starts a migration
+	u64 n = 0;
+	for (; !map_is_migrating(m); ++n)
+		expect(map_put(m, n, n));
+
+	/// overwrite, remove and look up keys on both sides of the cursor
+	for (u64 i = 0; i < n; i += 3)
+		expect(map_put(m, i, i + 1000));
+	for (u64 i = 1; i < n; i += 3)
+		expect(map_remove(m, i));
+	expect(!map_remove(m, 1));
+	expect_eq(map_len(m), usize_(n - (n + 1) / 3));
+
+	for (u64 i = 0; i < n; ++i) {
+		u64 *v = map_get(m, i);
+		if (i % 3 == 0)
+			expect(v != nullptr && *v == i + 1000);
+		else if (i % 3 == 1)
+			expect(v == nullptr);
+		else
+			expect(v != nullptr && *v == i);
+	}
+
+	/// entry on a key still waiting in the old table
+	bool inserted = true;
+	u64 last = n - 1;
+	u64 *v = map_entry(m, last, &inserted);
+	expect(!inserted);
+	expect_eq(*v, last % 3 == 0 ? last + 1000 : last);
+
+	map_deinit(m);
+	return true;
+}
+
+TEST(map_incremental_key_at)
+{
+	allocer_t sys = allocer_system();
+	map(u64, u64) m;
+	expect(map_init_incremental(m, sys, MAP_OPS_U64));
+
+	u64 n = 0;
+	for (; !map_is_migrating(m); ++n)
+		expect(map_put(m, n, n * 7));
+
+	/// the last keys are still in the old table: get must move them over
+	for (u64 i = n; i-- > 0 && map_is_migrating(m);) {
+		u64 *v = map_get(m, i);
+		expect(v != nullptr);
+		expect(v >= m.vals && v < m.vals + map_cap(m));
+		expect_eq(*v, i * 7);
+		expect_eq(*map_key_at(m, v), i);
+	}
+
+	for (u64 i = 0; i < n; ++i)
+		expect_eq(*map_get(m, i), i * 7);
+	expect_eq(map_len(m), usize_(n));
+
+	map_deinit(m);
+	return true;
+}
+
+TEST(map_incremental_clear)
+{
+	allocer_t sys = allocer_system();
+	map(u64, u64) m;
+	expect(map_init_incremental(m, sys, MAP_OPS_U64));
+
+	u64 n = 0;
+	for (; !map_is_migrating(m); ++n)
+		expect(map_put(m, n, n));
+
+	/// clear drops the old table: nothing left to resurrect
+	map_clear(m);
+	expect(!map_is_migrating(m));
+	expect_eq(map_len(m), usize_(0));
+	for (u64 i = 0; i < n; ++i)
+		expect(map_get(m, i) == nullptr);
+
+	/// and deinit during a migration frees both tables
+	for (; !map_is_migrating(m); ++n)
+		expect(map_put(m, n, n));
+	map_deinit(m);
+	return true;
+}
+
 int main()
 {
 	RUN(map_basic_u32);
@@ -239,6 +546,15 @@ int main()
 	RUN(map_growth_and_rehash);
 	RUN(map_tombstone_logic);
 	RUN(map_clear_reuse);
+	RUN(map_full_collisions);
+	RUN(map_remove_churn);
+	RUN(map_entry_api);
+	RUN(map_get_or_insert_with);
+	RUN(map_cached_hashes);
+	RUN(map_incremental_growth);
+	RUN(map_incremental_mutation);
+	RUN(map_incremental_key_at);
+	RUN(map_incremental_clear);
 
 	SUMMARY();
 }
@@ -0,0 +1,173 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/map/inline.h>
+#include <std/allocers/system.h>
+
+/*
+ * ==========================================================================
+ * Instantiations
+ * ==========================================================================
+ */
+
+defMapInline(u64, u64, U64Table, map_hash_u64, map_eq_scalar);
+
+typedef struct {
+	int x;
+	int y;
+} Point;
+
+static inline u64 point_hash(Point p)
+{
+	return hash_bytes(&p, sizeof(p));
+}
+
+#define point_eq(a, b) ((a).x == (b).x && (a).y == (b).y)
+
+defMapInline(Point, const char *, PointTable, point_hash, point_eq);
+
+/// every key collides: exercises multi-group probes and wrap-around
+#define collide_hash(k) ((void)(k), u64_(5))
+
+defMapInline(u32, u32, CollideTable, collide_hash, map_eq_scalar);
+
+/*
+ * ==========================================================================
+ * Tests
+ * ==========================================================================
+ */
+
+TEST(inline_map_basic)
+{
+	U64Table t;
+	U64Table_init(&t, allocer_system());
+	expect(U64Table_get(&t, 1) == nullptr);
+	expect(!U64Table_remove(&t, 1));
+
+	expect(U64Table_put(&t, 1, 10));
+	expect(U64Table_put(&t, 2, 20));
+	expect(U64Table_put(&t, 1, 11)); /// overwrite
+	expect_eq(map_len(t), usize_(2));
+	expect_eq(*U64Table_get(&t, 1), u64_(11));
+	expect_eq(*U64Table_get(&t, 2), u64_(20));
+
+	expect(U64Table_remove(&t, 1));
+	expect(U64Table_get(&t, 1) == nullptr);
+	expect_eq(map_len(t), usize_(1));
+
+	U64Table_clear(&t);
+	expect_eq(map_len(t), usize_(0));
+	expect(U64Table_get(&t, 2) == nullptr);
+
+	U64Table_deinit(&t);
+	expect_eq(map_cap(t), usize_(0));
+	return true;
+}
+
+TEST(inline_map_growth_and_churn)
+{
+	U64Table t;
+	U64Table_init(&t, allocer_system());
+
+	for (u64 i = 0; i < 10000; ++i)
+		expect(U64Table_put(&t, i, i * 3));
+	expect_eq(map_len(t), usize_(10000));
+	for (u64 i = 0; i < 10000; ++i)
+		expect_eq(*U64Table_get(&t, i), i * 3);
+
+	/// sliding window: tombstones grow the table at most once
+	usize cap = map_cap(t);
+	for (u64 i = 10000; i < 100000; ++i) {
+		expect(U64Table_remove(&t, i - 10000));
+		expect(U64Table_put(&t, i, i));
+	}
+	expect(map_cap(t) <= cap * 2);
+	expect_eq(map_len(t), usize_(10000));
+	expect(U64Table_get(&t, 89999) == nullptr);
+	expect_eq(*U64Table_get(&t, 90000), u64_(90000));
+
+	U64Table_deinit(&t);
+	return true;
+}
+
+TEST(inline_map_struct_keys)
+{
+	PointTable t;
+	PointTable_init(&t, allocer_system());
+
+	expect(PointTable_put(&t, ((Point){ 1, 2 }), "a"));
+	expect(PointTable_put(&t, ((Point){ 2, 1 }), "b"));
+	expect(strcmp(*PointTable_get(&t, ((Point){ 1, 2 })), "a") == 0);
+	expect(strcmp(*PointTable_get(&t, ((Point){ 2, 1 })), "b") == 0);
+	expect(PointTable_get(&t, ((Point){ 3, 3 })) == nullptr);
+
+	PointTable_deinit(&t);
+	return true;
+}
+
+TEST(inline_map_entry)
+{
+	U64Table t;
+	U64Table_init(&t, allocer_system());
+
+	bool inserted;
+	u64 *v = U64Table_entry(&t, 9, &inserted);
+	expect(v != nullptr);
+	expect(inserted);
+	expect_eq(*v, u64_(0)); /// zero-filled
+	for (int i = 0; i < 5; ++i)
+		(*U64Table_entry(&t, 9, &inserted))++;
+	expect(!inserted);
+	expect_eq(*U64Table_get(&t, 9), u64_(5));
+
+	U64Table_deinit(&t);
+	return true;
+}
+
+TEST(inline_map_collisions)
+{
+	CollideTable t;
+	CollideTable_init(&t, allocer_system());
+
+	for (u32 i = 0; i < 100; ++i)
+		expect(CollideTable_put(&t, i, i + 1));
+	for (u32 i = 0; i < 100; i += 3)
+		expect(CollideTable_remove(&t, i));
+	for (u32 i = 0; i < 100; ++i) {
+		u32 *v = CollideTable_get(&t, i);
+		if (i % 3 == 0) {
+			expect(v == nullptr);
+		} else {
+			expect(v != nullptr);
+			expect_eq(*v, i + 1);
+		}
+	}
+
+	CollideTable_deinit(&t);
+	return true;
+}
+
+int main()
+{
+	RUN(inline_map_basic);
+	RUN(inline_map_growth_and_churn);
+	RUN(inline_map_struct_keys);
+	RUN(inline_map_entry);
+	RUN(inline_map_collisions);
+
+	SUMMARY();
+}
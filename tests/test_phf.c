@@ -0,0 +1,128 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/map/phf.h>
+#include <std/allocers/system.h>
+#include "data/c_keywords.gen"
+
+/// tests/data/c_keywords.txt, in file order (value = index)
+static const char *const C_KEYWORD_LIST[] = {
+	"alignas", "alignof", "auto", "bool", "break", "case", "char", "const",
+	"constexpr", "continue", "default", "do", "double", "else", "enum",
+	"extern", "false", "float", "for", "goto", "if", "inline", "int",
+	"long", "nullptr", "register", "restrict", "return", "short", "signed",
+	"sizeof", "static", "static_assert", "struct", "switch", "thread_local",
+	"true", "typedef", "typeof", "typeof_unqual", "union", "unsigned",
+	"void", "volatile", "while", "_Atomic", "_BitInt", "_Complex",
+	"_Decimal128", "_Decimal32", "_Decimal64", "_Generic", "_Imaginary",
+	"_Noreturn",
+};
+
+#define N_KEYWORDS array_size(C_KEYWORD_LIST)
+
+TEST(phf_generated_hits)
+{
+	expect_eq(C_KEYWORDS.len, u32_(N_KEYWORDS));
+	for (usize i = 0; i < N_KEYWORDS; ++i) {
+		const int *v = phf_get(&C_KEYWORDS,
+				       str_from_cstr(C_KEYWORD_LIST[i]));
+		expect(v != nullptr);
+		expect_eq(*v, (int)i);
+	}
+	return true;
+}
+
+TEST(phf_generated_misses)
+{
+	static const char *const misses[] = {
+		"", "i", "iff", "If", "whilex", "_Bool", "alignas_",
+		"typeof_unq", "restrict ", "main",
+	};
+	for (usize i = 0; i < array_size(misses); ++i)
+		expect(phf_get(&C_KEYWORDS, str_from_cstr(misses[i])) ==
+		       nullptr);
+
+	/// slices of a larger buffer: only the length counts
+	const char *src = "returned";
+	expect(phf_get(&C_KEYWORDS, str_from_parts(src, 6)) != nullptr);
+	expect(phf_get(&C_KEYWORDS, str_from_parts(src, 7)) == nullptr);
+	return true;
+}
+
+TEST(phf_build_matches_generator)
+{
+	str_t keys[N_KEYWORDS];
+	for (usize i = 0; i < N_KEYWORDS; ++i)
+		keys[i] = str_from_cstr(C_KEYWORD_LIST[i]);
+
+	/// same construction as scripts/gen_phf.py: the very same table
+	phf_t t;
+	expect(phf_build(&t, allocer_system(), keys, nullptr, N_KEYWORDS));
+	expect_eq(t.seed, C_KEYWORDS.seed);
+	expect_eq(t.bucket_count, C_KEYWORDS.bucket_count);
+	for (u32 b = 0; b < t.bucket_count; ++b) {
+		expect_eq(t.disps[b].d1, C_KEYWORDS.disps[b].d1);
+		expect_eq(t.disps[b].d2, C_KEYWORDS.disps[b].d2);
+	}
+	for (u32 s = 0; s < t.len; ++s)
+		expect(str_eq(t.keys[s], C_KEYWORDS.keys[s]));
+
+	phf_deinit(&t, allocer_system());
+	return true;
+}
+
+TEST(phf_build_runtime)
+{
+	/// a bigger key set with explicit values
+	enum { N = 2000 };
+	static char buf[N][16];
+	static str_t keys[N];
+	static int vals[N];
+	for (int i = 0; i < N; ++i) {
+		int len = snprintf(buf[i], sizeof(buf[i]), "key_%d", i * 7);
+		keys[i] = str_from_parts(buf[i], (usize)len);
+		vals[i] = -i;
+	}
+
+	phf_t t;
+	expect(phf_build(&t, allocer_system(), keys, vals, N));
+	expect_eq(t.len, u32_(N));
+	for (int i = 0; i < N; ++i) {
+		const int *v = phf_get(&t, keys[i]);
+		expect(v != nullptr && *v == -i);
+	}
+	expect(phf_get(&t, str("key_1")) == nullptr);
+	phf_deinit(&t, allocer_system());
+
+	/// duplicates are refused, the empty set is fine
+	keys[N - 1] = keys[0];
+	expect(!phf_build(&t, allocer_system(), keys, vals, N));
+	expect(phf_build(&t, allocer_system(), keys, vals, 0));
+	expect(phf_get(&t, str("key_0")) == nullptr);
+	phf_deinit(&t, allocer_system());
+	return true;
+}
+
+int main()
+{
+	RUN(phf_generated_hits);
+	RUN(phf_generated_misses);
+	RUN(phf_build_matches_generator);
+	RUN(phf_build_runtime);
+
+	SUMMARY();
+}
@@ -0,0 +1,279 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/allocers/pool.h>
+#include <std/map.h>
+#include <core/mem/allocer.h>
+#include <core/math.h>
+#include <stdlib.h> /// for malloc/free in mock
+
+/*
+ * ==========================================================================
+ * 1. Mock / Tracking Allocator
+ * ==========================================================================
+ */
+
+struct MockState {
+	usize alloc_calls;
+	usize free_calls;
+	usize bytes_allocated;
+};
+
+static anyptr mock_alloc(anyptr self, layout_t layout)
+{
+	struct MockState *s = (struct MockState *)self;
+	s->alloc_calls++;
+	s->bytes_allocated += layout.size;
+	/// aligned_alloc wants the size to be a multiple of the alignment
+	usize align = max(layout.align, usize_(16));
+	return aligned_alloc(align, align_up(layout.size, align));
+}
+
+static void mock_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	struct MockState *s = (struct MockState *)self;
+	s->free_calls++;
+	s->bytes_allocated -= layout.size;
+	free(ptr);
+}
+
+static const allocer_vtable_t MOCK_VTABLE = { .alloc = mock_alloc,
+					      .free = mock_free,
+					      .realloc = nullptr,
+					      .zalloc = nullptr };
+
+static allocer_t mock_allocator(struct MockState *state)
+{
+	*state = (struct MockState){ 0 };
+	return (allocer_t){ .self = state, .vtable = &MOCK_VTABLE };
+}
+
+typedef struct {
+	u32 op;
+	u32 flags;
+	void *lhs;
+	void *rhs;
+	u64 id;
+} IrNode;
+
+/*
+ * ==========================================================================
+ * 2. Tests
+ * ==========================================================================
+ */
+
+TEST(pool_lifecycle)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+
+	pool_t pool;
+	pool_init(&pool, backing);
+	/// lazy: nothing allocated yet
+	expect_eq(mock_st.alloc_calls, usize_(0));
+
+	IrNode *n = pool_alloc_type(&pool, IrNode);
+	expect(n != nullptr);
+	expect(is_aligned((uptr)n, alignof(IrNode)));
+	expect_eq(pool_slab_count(&pool), usize_(1));
+
+	pool_deinit(&pool);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+
+	/// heap version
+	pool_t *p = pool_new(backing);
+	expect(p != nullptr);
+	expect(pool_alloc(p, 24, 8) != nullptr);
+	pool_drop(p);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+
+	return true;
+}
+
+TEST(pool_free_list_reuse)
+{
+	struct MockState mock_st;
+	pool_t pool;
+	pool_init(&pool, mock_allocator(&mock_st));
+
+	IrNode *a = pool_alloc_type(&pool, IrNode);
+	IrNode *b = pool_alloc_type(&pool, IrNode);
+	expect(a != b);
+
+	/// LIFO reuse of the freed slot
+	pool_free_type(&pool, a);
+	IrNode *c = pool_alloc_type(&pool, IrNode);
+	expect(c == a);
+
+	/// different size classes never share objects
+	pool_free_type(&pool, b);
+	u8 *small = (u8 *)pool_alloc(&pool, 8, 1);
+	expect((void *)small != (void *)b);
+
+	pool_deinit(&pool);
+	return true;
+}
+
+TEST(pool_churn_no_growth)
+{
+	struct MockState mock_st;
+	pool_t pool;
+	pool_init(&pool, mock_allocator(&mock_st));
+
+	static IrNode *nodes[10000];
+	for (int round = 0; round < 20; ++round) {
+		for (int i = 0; i < 10000; ++i) {
+			nodes[i] = pool_alloc_type(&pool, IrNode);
+			expect(nodes[i] != nullptr);
+			nodes[i]->id = (u64)i;
+		}
+		for (int i = 0; i < 10000; ++i) {
+			expect_eq(nodes[i]->id, u64_(i));
+			pool_free_type(&pool, nodes[i]);
+		}
+	}
+
+	/// after the first round everything comes from the free list
+	usize slabs = pool_slab_count(&pool);
+	expect_eq(mock_st.alloc_calls, slabs);
+
+	pool_deinit(&pool);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+TEST(pool_size_classes)
+{
+	struct MockState mock_st;
+	pool_t pool;
+	pool_init(&pool, mock_allocator(&mock_st));
+
+	usize sizes[] = { 1, 15, 16, 17, 100, 256, 257, 512, 1000, 4096 };
+	for (usize i = 0; i < array_size(sizes); ++i) {
+		u8 *p = (u8 *)pool_alloc(&pool, sizes[i], 1);
+		expect(p != nullptr);
+		expect(is_aligned((uptr)p, POOL_ALIGN));
+		memset(p, 0xCD, sizes[i]);
+	}
+
+	pool_deinit(&pool);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+TEST(pool_large_and_overaligned)
+{
+	struct MockState mock_st;
+	pool_t pool;
+	pool_init(&pool, mock_allocator(&mock_st));
+
+	/// bypasses slabs: goes straight to the backing allocator
+	layout_t big = layout(POOL_MAX_SIZE + 1, 8);
+	void *p = pool_alloc_layout(&pool, big);
+	expect(p != nullptr);
+	expect_eq(pool_slab_count(&pool), usize_(0));
+	pool_free(&pool, p, big);
+
+	layout_t aligned = layout(32, 64);
+	void *q = pool_alloc_layout(&pool, aligned);
+	expect(is_aligned((uptr)q, 64));
+	pool_free(&pool, q, aligned);
+
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	pool_deinit(&pool);
+	return true;
+}
+
+TEST(pool_realloc_logic)
+{
+	struct MockState mock_st;
+	pool_t pool;
+	pool_init(&pool, mock_allocator(&mock_st));
+
+	int *p = (int *)pool_alloc(&pool, sizeof(int) * 3, alignof(int));
+	p[0] = 1;
+	p[2] = 3;
+
+	/// 12 -> 16 bytes: same class, same pointer
+	int *q = (int *)pool_realloc(&pool, p, layout_of_array(int, 3),
+				     layout_of_array(int, 4));
+	expect(q == p);
+
+	/// 16 -> 400 bytes: moves, data kept
+	int *r = (int *)pool_realloc(&pool, q, layout_of_array(int, 4),
+				     layout_of_array(int, 100));
+	expect(r != q);
+	expect_eq(r[0], 1);
+	expect_eq(r[2], 3);
+
+	pool_deinit(&pool);
+	return true;
+}
+
+TEST(pool_bulk_reset)
+{
+	struct MockState mock_st;
+	pool_t pool;
+	pool_init(&pool, mock_allocator(&mock_st));
+
+	for (int i = 0; i < 50000; ++i)
+		expect(pool_alloc_type(&pool, IrNode) != nullptr);
+	expect(pool_slab_count(&pool) > 1);
+
+	/// one call releases everything
+	pool_reset(&pool);
+	expect_eq(pool_slab_count(&pool), usize_(0));
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+
+	/// usable again
+	expect(pool_alloc_type(&pool, IrNode) != nullptr);
+	pool_deinit(&pool);
+	return true;
+}
+
+TEST(pool_as_allocer)
+{
+	struct MockState mock_st;
+	pool_t pool;
+	pool_init(&pool, mock_allocator(&mock_st));
+
+	map(u64, u64) m;
+	expect(map_init(m, pool_allocer(&pool), MAP_OPS_U64));
+	for (u64 i = 0; i < 1000; ++i)
+		expect(map_put(m, i, i * 2));
+	for (u64 i = 0; i < 1000; ++i)
+		expect_eq(*map_get(m, i), i * 2);
+	map_deinit(m);
+
+	pool_deinit(&pool);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+int main()
+{
+	RUN(pool_lifecycle);
+	RUN(pool_free_list_reuse);
+	RUN(pool_churn_no_growth);
+	RUN(pool_size_classes);
+	RUN(pool_large_and_overaligned);
+	RUN(pool_realloc_logic);
+	RUN(pool_bulk_reset);
+	RUN(pool_as_allocer);
+
+	SUMMARY();
+}
@@ -0,0 +1,191 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/rhmap.h>
+#include <std/allocers/system.h>
+
+/*
+ * ==========================================================================
+ * Helpers
+ * ==========================================================================
+ */
+
+/// every key shares one home slot
+static u64 _hash_collide(const void *key)
+{
+	unused(key);
+	return 3;
+}
+
+static bool _eq_u64(const void *a, const void *b)
+{
+	return *(const u64 *)a == *(const u64 *)b;
+}
+
+static const map_ops_t MAP_OPS_COLLIDE = { .hash = _hash_collide,
+					   .equals = _eq_u64 };
+
+/*
+ * ==========================================================================
+ * Tests
+ * ==========================================================================
+ */
+
+TEST(rhmap_basic)
+{
+	rhmap(u32, int) m;
+	expect(rhmap_init(m, allocer_system(), MAP_OPS_U32));
+
+	expect(rhmap_put(m, 10, 100));
+	expect(rhmap_put(m, 20, 200));
+	expect_eq(rhmap_len(m), usize_(2));
+
+	expect_eq(*rhmap_get(m, 10), 100);
+	expect_eq(*rhmap_get(m, 20), 200);
+	expect(rhmap_get(m, 30) == nullptr);
+
+	/// overwrite keeps the length
+	expect(rhmap_put(m, 10, 111));
+	expect_eq(*rhmap_get(m, 10), 111);
+	expect_eq(rhmap_len(m), usize_(2));
+
+	expect(rhmap_remove(m, 10));
+	expect(!rhmap_remove(m, 10));
+	expect(rhmap_get(m, 10) == nullptr);
+	expect_eq(rhmap_len(m), usize_(1));
+
+	rhmap_deinit(m);
+	return true;
+}
+
+TEST(rhmap_string_keys)
+{
+	rhmap(const char *, int) m;
+	expect(rhmap_init(m, allocer_system(), MAP_OPS_CSTR));
+
+	char buf[16] = "apple";
+	expect(rhmap_put(m, "apple", 1));
+	expect(rhmap_put(m, "banana", 2));
+	expect_eq(*rhmap_get(m, (const char *)buf), 1); /// compares content
+	expect(rhmap_get(m, "cherry") == nullptr);
+
+	rhmap_deinit(m);
+	return true;
+}
+
+TEST(rhmap_growth)
+{
+	rhmap(u64, u64) m;
+	expect(rhmap_init(m, allocer_system(), MAP_OPS_U64));
+
+	for (u64 i = 0; i < 1000; ++i)
+		expect(rhmap_put(m, i, i * 10));
+	expect_eq(rhmap_len(m), usize_(1000));
+	expect(rhmap_cap(m) >= 1024);
+
+	for (u64 i = 0; i < 1000; ++i)
+		expect_eq(*rhmap_get(m, i), i * 10);
+
+	rhmap_deinit(m);
+	return true;
+}
+
+TEST(rhmap_backward_shift)
+{
+	rhmap(u64, u64) m;
+	expect(rhmap_init(m, allocer_system(), MAP_OPS_COLLIDE));
+
+	/// one long run starting at the shared home slot
+	for (u64 i = 0; i < 6; ++i)
+		expect(rhmap_put(m, i, i));
+	expect_eq(rhmap_max_probe(m), usize_(6));
+
+	/// removing from the middle shifts the tail back: the run shrinks
+	expect(rhmap_remove(m, 2));
+	expect_eq(rhmap_max_probe(m), usize_(5));
+	for (u64 i = 0; i < 6; ++i) {
+		u64 *v = rhmap_get(m, i);
+		expect((v != nullptr) == (i != 2));
+	}
+
+	expect(rhmap_remove(m, 0));
+	expect(rhmap_remove(m, 5));
+	expect_eq(rhmap_max_probe(m), usize_(3));
+	expect_eq(*rhmap_get(m, 1), u64_(1));
+	expect_eq(*rhmap_get(m, 4), u64_(4));
+
+	rhmap_deinit(m);
+	return true;
+}
+
+TEST(rhmap_churn_no_growth)
+{
+	rhmap(u64, u64) m;
+	expect(rhmap_init(m, allocer_system(), MAP_OPS_U64));
+
+	for (u64 i = 0; i < 100; ++i)
+		expect(rhmap_put(m, i, i));
+	usize cap = rhmap_cap(m);
+
+	/// a sliding window of live keys never grows the table
+	for (u64 i = 100; i < 200000; ++i) {
+		expect(rhmap_remove(m, i - 100));
+		expect(rhmap_put(m, i, i));
+	}
+	expect_eq(rhmap_len(m), usize_(100));
+	expect_eq(rhmap_cap(m), cap);
+
+	for (u64 i = 200000 - 100; i < 200000; ++i)
+		expect_eq(*rhmap_get(m, i), i);
+	expect(rhmap_get(m, 0) == nullptr);
+
+	rhmap_deinit(m);
+	return true;
+}
+
+TEST(rhmap_clear_reuse)
+{
+	rhmap(u32, int) m;
+	expect(rhmap_init(m, allocer_system(), MAP_OPS_U32));
+
+	expect(rhmap_put(m, 1, 1));
+	expect(rhmap_put(m, 2, 2));
+	usize cap = rhmap_cap(m);
+
+	rhmap_clear(m);
+	expect_eq(rhmap_len(m), usize_(0));
+	expect_eq(rhmap_cap(m), cap);
+	expect(rhmap_get(m, 1) == nullptr);
+
+	expect(rhmap_put(m, 3, 3));
+	expect_eq(*rhmap_get(m, 3), 3);
+
+	rhmap_deinit(m);
+	return true;
+}
+
+int main()
+{
+	RUN(rhmap_basic);
+	RUN(rhmap_string_keys);
+	RUN(rhmap_growth);
+	RUN(rhmap_backward_shift);
+	RUN(rhmap_churn_no_growth);
+	RUN(rhmap_clear_reuse);
+
+	SUMMARY();
+}
@@ -0,0 +1,235 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/set.h>
+#include <std/allocers/system.h>
+
+/*
+ * ==========================================================================
+ * Helpers
+ * ==========================================================================
+ */
+
+defSet(u64, U64Set);
+
+/// {lo, lo + step, ...} below hi
+static bool _fill(U64Set *s, map_ops_t ops, u64 lo, u64 hi, u64 step)
+{
+	if (!set_init(*s, allocer_system(), ops))
+		return false;
+	for (u64 i = lo; i < hi; i += step) {
+		if (!set_insert(*s, i, nullptr))
+			return false;
+	}
+	return true;
+}
+
+/// u64 keys with cached hash bits, to cover the cached paths
+static u64 _hash_u64(const void *key)
+{
+	return MAP_OPS_U64.hash(key);
+}
+
+static bool _eq_u64(const void *a, const void *b)
+{
+	return *(const u64 *)a == *(const u64 *)b;
+}
+
+static const map_ops_t MAP_OPS_U64_CACHED = { .hash = _hash_u64,
+					      .equals = _eq_u64,
+					      .cache_hashes = true };
+
+/*
+ * ==========================================================================
+ * Tests
+ * ==========================================================================
+ */
+
+TEST(set_basic)
+{
+	set(u32) s;
+	expect(set_init(s, allocer_system(), MAP_OPS_U32));
+
+	bool inserted = false;
+	expect(set_insert(s, 10, &inserted));
+	expect(inserted);
+	expect(set_insert(s, 10, &inserted));
+	expect(!inserted);
+	expect(set_insert(s, 20, nullptr));
+	expect_eq(set_len(s), usize_(2));
+
+	expect(set_contains(s, 10));
+	expect(!set_contains(s, 30));
+
+	expect(set_remove(s, 10));
+	expect(!set_remove(s, 10));
+	expect(!set_contains(s, 10));
+	expect_eq(set_len(s), usize_(1));
+
+	set_clear(s);
+	expect_eq(set_len(s), usize_(0));
+	expect(!set_contains(s, 20));
+
+	set_deinit(s);
+	return true;
+}
+
+TEST(set_growth_and_foreach)
+{
+	U64Set s;
+	expect(_fill(&s, MAP_OPS_U64, 0, 10000, 1));
+	expect_eq(set_len(s), usize_(10000));
+
+	/// every key exactly once
+	u64 sum = 0, n = 0;
+	set_foreach(it, s)
+	{
+		sum += *it;
+		n++;
+	}
+	expect_eq(n, u64_(10000));
+	expect_eq(sum, u64_(10000) * 9999 / 2);
+
+	/// removal churn reuses the table
+	for (u64 i = 0; i < 10000; i += 2)
+		expect(set_remove(s, i));
+	usize cap = set_cap(s);
+	for (u64 i = 10000; i < 14000; ++i)
+		expect(set_insert(s, i, nullptr));
+	expect(set_cap(s) <= cap);
+	for (u64 i = 0; i < 14000; ++i)
+		expect(set_contains(s, i) == (i >= 10000 || i % 2 == 1));
+
+	set_deinit(s);
+	return true;
+}
+
+TEST(set_union)
+{
+	for (int cached = 0; cached < 2; ++cached) {
+		map_ops_t ops = cached ? MAP_OPS_U64_CACHED : MAP_OPS_U64;
+		U64Set a, b;
+		expect(_fill(&a, ops, 0, 3000, 2)); /// evens
+		expect(_fill(&b, ops, 0, 3000, 3)); /// multiples of 3
+
+		expect(set_union(a, b));
+		for (u64 i = 0; i < 3000; ++i) {
+			bool in = i % 2 == 0 || i % 3 == 0;
+			expect(set_contains(a, i) == in);
+		}
+		expect_eq(set_len(a), usize_(1500 + 1000 - 500));
+		expect(set_contains_all(a, b));
+
+		/// into an empty set, and with itself
+		U64Set c;
+		expect(set_init(c, allocer_system(), ops));
+		expect(set_union(c, a));
+		expect_eq(set_len(c), set_len(a));
+		expect(set_union(c, c));
+		expect_eq(set_len(c), set_len(a));
+
+		set_deinit(a);
+		set_deinit(b);
+		set_deinit(c);
+	}
+	return true;
+}
+
+TEST(set_intersect)
+{
+	for (int cached = 0; cached < 2; ++cached) {
+		map_ops_t ops = cached ? MAP_OPS_U64_CACHED : MAP_OPS_U64;
+		U64Set a, b;
+		expect(_fill(&a, ops, 0, 3000, 2));
+		expect(_fill(&b, ops, 0, 3000, 3));
+
+		set_intersect(a, b);
+		expect_eq(set_len(a), usize_(500));
+		for (u64 i = 0; i < 3000; ++i)
+			expect(set_contains(a, i) == (i % 6 == 0));
+
+		/// still usable after the bulk removal
+		expect(set_insert(a, 1, nullptr));
+		expect(set_contains(a, 1));
+
+		set_clear(b);
+		set_intersect(a, b);
+		expect_eq(set_len(a), usize_(0));
+
+		set_deinit(a);
+		set_deinit(b);
+	}
+	return true;
+}
+
+TEST(set_contains_all)
+{
+	U64Set a, b;
+	expect(_fill(&a, MAP_OPS_U64, 0, 1000, 1));
+	expect(_fill(&b, MAP_OPS_U64, 100, 200, 7));
+
+	expect(set_contains_all(a, b));
+	expect(!set_contains_all(b, a));
+	expect(set_contains_all(a, a));
+
+	expect(set_insert(b, 5000, nullptr));
+	expect(!set_contains_all(a, b));
+
+	/// the empty set is a subset of everything
+	set_clear(b);
+	expect(set_contains_all(a, b));
+
+	set_deinit(a);
+	set_deinit(b);
+	return true;
+}
+
+TEST(set_reserve)
+{
+	set(const char *) s;
+	expect(set_init(s, allocer_system(), MAP_OPS_CSTR));
+	expect(set_reserve(s, 100));
+
+	usize cap = set_cap(s);
+	char buf[16];
+	for (int i = 0; i < 100; ++i) {
+		/// the set stores the pointer: keep the strings alive
+		static const char *const words[] = { "alpha", "beta", "gamma" };
+		expect(set_insert(s, words[i % 3], nullptr));
+	}
+	expect_eq(set_cap(s), cap);
+	expect_eq(set_len(s), usize_(3));
+
+	/// lookups go by content, not address
+	snprintf(buf, sizeof(buf), "beta");
+	expect(set_contains(s, (const char *)buf));
+
+	set_deinit(s);
+	return true;
+}
+
+int main()
+{
+	RUN(set_basic);
+	RUN(set_growth_and_foreach);
+	RUN(set_union);
+	RUN(set_intersect);
+	RUN(set_contains_all);
+	RUN(set_reserve);
+
+	SUMMARY();
+}
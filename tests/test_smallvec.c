@@ -0,0 +1,226 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/smallvec.h>
+#include <std/allocers/tracking.h>
+#include <std/allocers/system.h>
+#include <std/allocers/bump.h>
+#include <stdalign.h> /// for alignas, alignof
+
+typedef struct {
+	alignas(16) u64 lo;
+	u64 hi;
+} Wide;
+
+/*
+ * ==========================================================================
+ * Tests
+ * ==========================================================================
+ */
+
+TEST(smallvec_inline_no_alloc)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+
+	smallvec(int, 4) v;
+	smallvec_init(v, tracking_allocer(&tr));
+	expect(smallvec_is_inline(v));
+	expect_eq(vec_cap(v), usize_(4));
+	expect_eq(smallvec_inline_cap(v), usize_(4));
+
+	/// the vec API, all without touching the allocator
+	for (int i = 0; i < 4; ++i)
+		expect(vec_push(v, i * 10));
+	expect_eq(vec_len(v), usize_(4));
+	expect_eq(vec_at(v, 2), 20);
+	expect_eq(*vec_last(v), 30);
+	int sum = 0;
+	vec_foreach(it, v)
+	{
+		sum += *it;
+	}
+	expect_eq(sum, 60);
+	expect_eq(vec_pop(v), 30);
+	expect(vec_reserve(v, 1));
+
+	expect(smallvec_is_inline(v));
+	expect_eq(tracking_stats(&tr).allocs, usize_(0));
+
+	smallvec_deinit(v);
+	expect_eq(tracking_stats(&tr).frees, usize_(0));
+	return true;
+}
+
+TEST(smallvec_spill)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+
+	smallvec(int, 4) v;
+	smallvec_init(v, tracking_allocer(&tr));
+	for (int i = 0; i < 100; ++i)
+		expect(vec_push(v, i));
+
+	/// the inline elements moved over intact
+	expect(!smallvec_is_inline(v));
+	expect_eq(vec_len(v), usize_(100));
+	for (int i = 0; i < 100; ++i)
+		expect_eq(vec_at(v, i), i);
+
+	tracking_stats_t st = tracking_stats(&tr);
+	expect_eq(st.allocs, usize_(1)); /// the spill itself
+	expect(st.reallocs > 0); /// later growth
+	expect(st.live_bytes > 0);
+
+	smallvec_deinit(v);
+	st = tracking_stats(&tr);
+	expect_eq(st.live_bytes, usize_(0));
+	expect_eq(st.frees, usize_(1));
+	return true;
+}
+
+TEST(smallvec_reserve_spills_once)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+
+	smallvec(u64, 2) v;
+	smallvec_init(v, tracking_allocer(&tr));
+	expect(vec_push(v, u64_(1)));
+	expect(vec_reserve(v, 50));
+	expect(!smallvec_is_inline(v));
+	expect(vec_cap(v) >= 51);
+	expect_eq(vec_at(v, 0), u64_(1));
+	for (u64 i = 0; i < 50; ++i)
+		expect(vec_push(v, i));
+
+	tracking_stats_t st = tracking_stats(&tr);
+	expect_eq(st.allocs, usize_(1));
+	expect_eq(st.reallocs, usize_(0));
+
+	smallvec_deinit(v);
+	expect_eq(tracking_stats(&tr).live_bytes, usize_(0));
+	return true;
+}
+
+TEST(smallvec_overaligned_elements)
+{
+	/// the inline buffer sits past the header padding
+	smallvec(Wide, 3) v;
+	smallvec_init(v, allocer_system());
+	expect_eq((usize)v.data % alignof(Wide), usize_(0));
+
+	for (u64 i = 0; i < 10; ++i)
+		expect(vec_push(v, ((Wide){ .lo = i, .hi = ~i })));
+	expect_eq((usize)v.data % alignof(Wide), usize_(0));
+	for (u64 i = 0; i < 10; ++i) {
+		expect_eq(vec_at(v, i).lo, i);
+		expect_eq(vec_at(v, i).hi, ~i);
+	}
+
+	smallvec_deinit(v);
+	return true;
+}
+
+TEST(smallvec_bump_backing)
+{
+	bump_t arena;
+	bump_init(&arena, allocer_system(), 1);
+
+	defSmallvec(u32, 4, Operands);
+	Operands ops[16];
+	for (u32 i = 0; i < 16; ++i) {
+		smallvec_init(ops[i], bump_allocer(&arena));
+		/// every other list overflows its inline buffer
+		for (u32 j = 0; j < (i % 2 ? 9 : 3); ++j)
+			expect(vec_push(ops[i], i * 100 + j));
+	}
+	for (u32 i = 0; i < 16; ++i) {
+		expect_eq(smallvec_is_inline(ops[i]), i % 2 == 0);
+		expect_eq(vec_at(ops[i], 2), i * 100 + 2);
+		smallvec_deinit(ops[i]);
+	}
+
+	bump_deinit(&arena);
+	return true;
+}
+
+TEST(smallvec_bulk_ops)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+
+	smallvec(int, 8) v;
+	smallvec_init(v, tracking_allocer(&tr));
+	int arr[] = { 1, 2, 3, 4, 5, 6 };
+	expect(vec_extend_from_array(v, arr, 6));
+	expect(smallvec_is_inline(v));
+
+	/// shrinking while inline keeps the inline buffer
+	expect(vec_shrink_to_fit(v));
+	expect(smallvec_is_inline(v));
+	expect_eq(vec_cap(v), usize_(6));
+
+	/// and regrowing within it does not allocate
+	vec_remove_range(v, 3, 6);
+	expect(vec_shrink_to_fit(v));
+	expect_eq(vec_cap(v), usize_(3));
+	for (int i = 4; i <= 6; ++i)
+		expect(vec_push(v, i));
+	expect(smallvec_is_inline(v));
+	expect_eq(tracking_stats(&tr).allocs, usize_(0));
+
+	/// extending past the capacity spills, even from its own elements
+	expect(vec_extend(v, v));
+	expect(!smallvec_is_inline(v));
+	expect_eq(vec_len(v), usize_(12));
+	expect_eq(vec_at(v, 11), 6);
+
+	vec_remove_range(v, 0, 6);
+	expect(vec_shrink_to_fit(v));
+	expect_eq(vec_cap(v), usize_(6));
+	expect_eq(vec_at(v, 0), 1);
+
+	smallvec_deinit(v);
+	expect_eq(tracking_stats(&tr).live_bytes, usize_(0));
+
+	/// an emptied smallvec gets its inline buffer back on the next push
+	smallvec_init(v, tracking_allocer(&tr));
+	expect(vec_push(v, 1));
+	expect(vec_pop(v) == 1);
+	expect(vec_shrink_to_fit(v));
+	expect_eq(vec_cap(v), usize_(0));
+	expect(vec_push(v, 2));
+	expect(smallvec_is_inline(v));
+	expect_eq(vec_cap(v), usize_(8));
+	/// still only the one spill from above
+	expect_eq(tracking_stats(&tr).allocs, usize_(1));
+	smallvec_deinit(v);
+	return true;
+}
+
+int main()
+{
+	RUN(smallvec_inline_no_alloc);
+	RUN(smallvec_spill);
+	RUN(smallvec_reserve_spills_once);
+	RUN(smallvec_overaligned_elements);
+	RUN(smallvec_bump_backing);
+	RUN(smallvec_bulk_ops);
+	SUMMARY();
+}
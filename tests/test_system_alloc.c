@@ -75,10 +75,77 @@ TEST(sys_realloc_logic)
 	return true;
 }
 
+TEST(sys_realloc_plain)
+{
+	allocer_t sys = allocer_system();
+
+	/// default alignment goes through libc realloc, both directions
+	layout_t l1 = layout_of_array(u64, 4);
+	u64 *arr = (u64 *)allocer_alloc(sys, l1);
+	for (u64 i = 0; i < 4; ++i)
+		arr[i] = i;
+
+	layout_t l2 = layout_of_array(u64, 100000);
+	arr = (u64 *)allocer_realloc(sys, arr, l1, l2);
+	expect(arr != nullptr);
+	arr[99999] = 7;
+	for (u64 i = 0; i < 4; ++i)
+		expect_eq(arr[i], i);
+
+	arr = (u64 *)allocer_realloc(sys, arr, l2, l1);
+	expect_eq(arr[3], u64_(3));
+
+	/// zero size frees
+	expect(allocer_realloc(sys, arr, l1, layout(0, alignof(u64))) ==
+	       nullptr);
+	return true;
+}
+
+TEST(sys_realloc_huge)
+{
+	allocer_t sys = allocer_system();
+	const usize mib = 1024 * 1024;
+
+	/// cross the mapping threshold on the way up and down
+	layout_t small = layout(mib, 8);
+	layout_t big = layout(96 * mib, 8);
+	layout_t bigger = layout(300 * mib, 8);
+
+	u8 *p = (u8 *)allocer_alloc(sys, small);
+	p[0] = 1;
+	p[mib - 1] = 2;
+
+	p = (u8 *)allocer_realloc(sys, p, small, big);
+	expect(p != nullptr);
+	expect_eq(p[0], 1);
+	expect_eq(p[mib - 1], 2);
+	p[96 * mib - 1] = 3;
+
+	/// huge -> huge only touches the page tables
+	p = (u8 *)allocer_realloc(sys, p, big, bigger);
+	expect(p != nullptr);
+	expect_eq(p[0], 1);
+	expect_eq(p[96 * mib - 1], 3);
+	expect_eq(p[300 * mib - 1], 0);
+
+	p = (u8 *)allocer_realloc(sys, p, bigger, small);
+	expect_eq(p[mib - 1], 2);
+	allocer_free(sys, p, small);
+
+	/// huge zeroed blocks come straight from fresh pages
+	u8 *z = (u8 *)allocer_zalloc(sys, big);
+	expect(z != nullptr);
+	expect_eq(z[50 * mib], 0);
+	allocer_free(sys, z, big);
+	return true;
+}
+
 int main()
 {
 	RUN(sys_alloc_basic);
 	RUN(sys_alloc_alignment);
 	RUN(sys_realloc_logic);
+	RUN(sys_realloc_plain);
+	RUN(sys_realloc_huge);
 	SUMMARY();
 }
@@ -0,0 +1,328 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/allocers/tlsf.h>
+#include <std/vec.h>
+#include <core/mem/allocer.h>
+#include <core/math.h>
+#include <stdlib.h> /// for malloc/free in mock
+
+/*
+ * ==========================================================================
+ * 1. Mock / Tracking Allocator
+ * ==========================================================================
+ */
+
+struct MockState {
+	usize alloc_calls;
+	usize free_calls;
+	usize bytes_allocated;
+};
+
+static anyptr mock_alloc(anyptr self, layout_t layout)
+{
+	struct MockState *s = (struct MockState *)self;
+	s->alloc_calls++;
+	s->bytes_allocated += layout.size;
+	return aligned_alloc(layout.align < 16 ? 16 : layout.align,
+			     align_up(layout.size, 16));
+}
+
+static void mock_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	struct MockState *s = (struct MockState *)self;
+	s->free_calls++;
+	s->bytes_allocated -= layout.size;
+	free(ptr);
+}
+
+static const allocer_vtable_t MOCK_VTABLE = { .alloc = mock_alloc,
+					      .free = mock_free,
+					      .realloc = nullptr,
+					      .zalloc = nullptr };
+
+static allocer_t mock_allocator(struct MockState *state)
+{
+	*state = (struct MockState){ 0 };
+	return (allocer_t){ .self = state, .vtable = &MOCK_VTABLE };
+}
+
+/// tiny deterministic PRNG for the stress test
+static u64 rng_next(u64 *s)
+{
+	*s ^= *s << 13;
+	*s ^= *s >> 7;
+	*s ^= *s << 17;
+	return *s;
+}
+
+/*
+ * ==========================================================================
+ * 2. Tests
+ * ==========================================================================
+ */
+
+TEST(tlsf_lifecycle)
+{
+	struct MockState mock_st;
+	allocer_t backing = mock_allocator(&mock_st);
+
+	tlsf_t t;
+	tlsf_init(&t, backing, 0);
+	/// lazy: nothing allocated yet
+	expect_eq(mock_st.alloc_calls, usize_(0));
+
+	u64 *p = (u64 *)tlsf_alloc(&t, sizeof(u64), alignof(u64));
+	expect(p != nullptr);
+	expect(is_aligned((uptr)p, TLSF_ALIGN));
+	expect_eq(t.region_count, usize_(1));
+	expect(tlsf_check(&t));
+
+	tlsf_deinit(&t);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+
+	/// heap version
+	tlsf_t *h = tlsf_new(backing, 4096);
+	expect(h != nullptr);
+	expect(tlsf_alloc(h, 24, 8) != nullptr);
+	tlsf_drop(h);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+
+	return true;
+}
+
+TEST(tlsf_free_coalesces)
+{
+	struct MockState mock_st;
+	tlsf_t t;
+	tlsf_init(&t, mock_allocator(&mock_st), 64 * 1024);
+
+	u8 *a = (u8 *)tlsf_alloc(&t, 1000, 1);
+	u8 *b = (u8 *)tlsf_alloc(&t, 1000, 1);
+	u8 *c = (u8 *)tlsf_alloc(&t, 1000, 1);
+	expect(tlsf_check(&t));
+
+	/// free in an order that exercises both merge directions
+	tlsf_free(&t, a);
+	tlsf_free(&t, c);
+	expect(tlsf_check(&t));
+	tlsf_free(&t, b);
+	expect(tlsf_check(&t));
+
+	/// everything merged back: the whole region fits again
+	u8 *big = (u8 *)tlsf_alloc(&t, 60 * 1024, 1);
+	expect(big == a);
+	expect_eq(t.region_count, usize_(1));
+
+	tlsf_deinit(&t);
+	return true;
+}
+
+TEST(tlsf_realloc_in_place)
+{
+	struct MockState mock_st;
+	tlsf_t t;
+	tlsf_init(&t, mock_allocator(&mock_st), 0);
+
+	int *p = (int *)tlsf_alloc(&t, sizeof(int) * 4, alignof(int));
+	for (int i = 0; i < 4; ++i)
+		p[i] = i;
+
+	/// grow into the free successor: same pointer, data kept
+	int *q = (int *)tlsf_realloc(&t, p, sizeof(int) * 1000, alignof(int));
+	expect(q == p);
+	expect(tlsf_block_size(q) >= sizeof(int) * 1000);
+	expect_eq(q[3], 3);
+	expect(tlsf_check(&t));
+
+	/// shrink: same pointer, tail returned
+	q = (int *)tlsf_realloc(&t, q, sizeof(int) * 8, alignof(int));
+	expect(q == p);
+	expect(tlsf_block_size(q) < sizeof(int) * 1000);
+	expect(tlsf_check(&t));
+
+	/// a used neighbour forces a move
+	int *wall = (int *)tlsf_alloc(&t, 64, alignof(int));
+	int *r = (int *)tlsf_realloc(&t, q, sizeof(int) * 4096, alignof(int));
+	expect(r != q);
+	expect_eq(r[0], 0);
+	expect_eq(r[3], 3);
+	expect(tlsf_check(&t));
+
+	tlsf_free(&t, wall);
+	tlsf_free(&t, r);
+	expect(tlsf_check(&t));
+	tlsf_deinit(&t);
+	return true;
+}
+
+TEST(tlsf_overaligned)
+{
+	struct MockState mock_st;
+	tlsf_t t;
+	tlsf_init(&t, mock_allocator(&mock_st), 0);
+
+	usize aligns[] = { 32, 64, 256, 4096 };
+	void *ptrs[array_size(aligns)];
+	for (usize i = 0; i < array_size(aligns); ++i) {
+		void *pad = tlsf_alloc(&t, 24, 8); /// shift the free space around
+		expect(pad != nullptr);
+		ptrs[i] = tlsf_alloc(&t, 100, aligns[i]);
+		expect(ptrs[i] != nullptr);
+		expect(is_aligned((uptr)ptrs[i], aligns[i]));
+		expect(tlsf_check(&t));
+	}
+	for (usize i = 0; i < array_size(aligns); ++i)
+		tlsf_free(&t, ptrs[i]);
+	expect(tlsf_check(&t));
+
+	tlsf_deinit(&t);
+	return true;
+}
+
+TEST(tlsf_large_region)
+{
+	struct MockState mock_st;
+	tlsf_t t;
+	tlsf_init(&t, mock_allocator(&mock_st), 4096);
+
+	/// larger than a region: gets one of its own
+	u8 *big = (u8 *)tlsf_alloc(&t, 1 << 20, 1);
+	expect(big != nullptr);
+	memset(big, 0xAB, 1 << 20);
+	expect(tlsf_check(&t));
+
+	tlsf_free(&t, big);
+	expect(tlsf_check(&t));
+
+	/// oversized requests fail cleanly
+	expect(tlsf_alloc(&t, (usize)-1 / 2, 1) == nullptr);
+
+	tlsf_deinit(&t);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+TEST(tlsf_class_range_bounds)
+{
+	struct MockState mock_st;
+	tlsf_t t;
+
+	/// a region whose block would map past the last first-level class
+	tlsf_init(&t, mock_allocator(&mock_st), (usize)1 << 45);
+	expect_eq(t.region_size, (usize)1 << TLSF_FL_MAX_LOG2);
+	tlsf_deinit(&t);
+
+	/// huge alignments never reach the backing allocator
+	tlsf_init(&t, mock_allocator(&mock_st), 4096);
+	expect(tlsf_alloc(&t, 64, (usize)1 << 50) == nullptr);
+	expect(tlsf_alloc(&t, 64, (usize)1 << TLSF_FL_MAX_LOG2) == nullptr);
+	expect(tlsf_alloc(&t, (usize)1 << (TLSF_FL_MAX_LOG2 - 1),
+			  (usize)1 << (TLSF_FL_MAX_LOG2 - 1)) == nullptr);
+	expect_eq(mock_st.alloc_calls, usize_(0));
+
+	/// and the allocator still works afterwards
+	void *p = tlsf_alloc(&t, 64, 64);
+	expect(p != nullptr && is_aligned((uptr)p, 64));
+	tlsf_free(&t, p);
+	expect(tlsf_check(&t));
+
+	tlsf_deinit(&t);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+TEST(tlsf_random_stress)
+{
+	struct MockState mock_st;
+	tlsf_t t;
+	tlsf_init(&t, mock_allocator(&mock_st), 256 * 1024);
+
+	enum { SLOTS = 512 };
+	static u8 *ptrs[SLOTS];
+	static usize sizes[SLOTS];
+	u64 seed = 0x9E3779B97F4A7C15ull;
+
+	for (int step = 0; step < 20000; ++step) {
+		usize i = rng_next(&seed) % SLOTS;
+		usize n = rng_next(&seed) % 3000 + 1;
+		if (ptrs[i] == nullptr) {
+			ptrs[i] = (u8 *)tlsf_alloc(&t, n, 8);
+			expect(ptrs[i] != nullptr);
+		} else if (rng_next(&seed) & 1) {
+			/// contents must survive a realloc
+			expect_eq(ptrs[i][0], (u8)i);
+			expect_eq(ptrs[i][sizes[i] - 1], (u8)i);
+			ptrs[i] = (u8 *)tlsf_realloc(&t, ptrs[i], n, 8);
+			expect(ptrs[i] != nullptr);
+		} else {
+			tlsf_free(&t, ptrs[i]);
+			ptrs[i] = nullptr;
+			continue;
+		}
+		sizes[i] = n;
+		memset(ptrs[i], (int)i, n);
+	}
+	expect(tlsf_check(&t));
+
+	for (usize i = 0; i < SLOTS; ++i) {
+		tlsf_free(&t, ptrs[i]);
+		ptrs[i] = nullptr;
+	}
+	expect(tlsf_check(&t));
+
+	tlsf_deinit(&t);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+TEST(tlsf_as_allocer)
+{
+	struct MockState mock_st;
+	tlsf_t t;
+	tlsf_init(&t, mock_allocator(&mock_st), 0);
+
+	vec(u64) v;
+	expect(vec_init(v, tlsf_allocer(&t), 0));
+	for (u64 i = 0; i < 10000; ++i)
+		expect(vec_push(v, i));
+
+	/// the buffer grew in place the whole time
+	expect_eq(t.region_count, usize_(1));
+	for (u64 i = 0; i < 10000; ++i)
+		expect_eq(vec_at(v, i), i);
+	vec_deinit(v);
+	expect(tlsf_check(&t));
+
+	tlsf_deinit(&t);
+	expect_eq(mock_st.bytes_allocated, usize_(0));
+	return true;
+}
+
+int main()
+{
+	RUN(tlsf_lifecycle);
+	RUN(tlsf_free_coalesces);
+	RUN(tlsf_realloc_in_place);
+	RUN(tlsf_overaligned);
+	RUN(tlsf_large_region);
+	RUN(tlsf_class_range_bounds);
+	RUN(tlsf_random_stress);
+	RUN(tlsf_as_allocer);
+
+	SUMMARY();
+}
@@ -0,0 +1,247 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/// tag the allocer_* calls in this file with their call sites
+#ifndef FLUF_TRACK_ALLOC_SITES
+#define FLUF_TRACK_ALLOC_SITES
+#endif
+
+#include <std/test.h>
+#include <std/allocers/tracking.h>
+#include <std/allocers/system.h>
+#include <std/vec.h>
+#include <std/map.h>
+#include <core/mem/allocer.h>
+#include <core/math.h>
+#include <string.h>
+
+/*
+ * ==========================================================================
+ * 1. Helpers
+ * ==========================================================================
+ */
+
+static anyptr failing_alloc(anyptr self, layout_t layout)
+{
+	(void)self;
+	(void)layout;
+	return nullptr;
+}
+
+static void failing_free(anyptr self, anyptr ptr, layout_t layout)
+{
+	(void)self;
+	(void)ptr;
+	(void)layout;
+}
+
+static const allocer_vtable_t FAILING_VTABLE = { .alloc = failing_alloc,
+						 .free = failing_free };
+
+/// render a report into a buffer
+static char *capture(tracking_t *tr, bool json, char *buf, usize cap)
+{
+	FILE *f = tmpfile();
+	if (json)
+		tracking_dump_json(tr, f);
+	else
+		tracking_report(tr, f);
+	rewind(f);
+	usize n = fread(buf, 1, cap - 1, f);
+	buf[n] = '\0';
+	fclose(f);
+	return buf;
+}
+
+/*
+ * ==========================================================================
+ * 2. Tests
+ * ==========================================================================
+ */
+
+TEST(tracking_counts_and_bytes)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+	allocer_t alc = tracking_allocer(&tr);
+
+	void *a = allocer_alloc(alc, layout(100, 8));
+	void *b = allocer_zalloc(alc, layout(3000, 16));
+	expect(a != nullptr && b != nullptr);
+	expect_eq(((u8 *)b)[2999], 0);
+
+	tracking_stats_t st = tracking_stats(&tr);
+	expect_eq(st.allocs, usize_(2));
+	expect_eq(st.live_bytes, usize_(3100));
+	expect_eq(st.histogram[7], usize_(1)); /// (64, 128]
+	expect_eq(st.histogram[12], usize_(1)); /// (2048, 4096]
+
+	allocer_free(alc, b, layout(3000, 16));
+	st = tracking_stats(&tr);
+	expect_eq(st.frees, usize_(1));
+	expect_eq(st.live_bytes, usize_(100));
+	expect_eq(st.peak_bytes, usize_(3100));
+	expect_eq(st.total_bytes, usize_(3100));
+
+	allocer_free(alc, a, layout(100, 8));
+	expect_eq(tracking_stats(&tr).live_bytes, usize_(0));
+	return true;
+}
+
+TEST(tracking_call_sites)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+	allocer_t alc = tracking_allocer(&tr);
+
+	void *blocks[10];
+	u32 line_a = __LINE__ + 2;
+	for (int i = 0; i < 10; ++i)
+		blocks[i] = allocer_alloc(alc, layout(64, 8));
+	u32 line_b = __LINE__ + 1;
+	void *big = allocer_alloc(alc, layout(1 << 16, 8));
+
+	tracking_site_t s;
+	expect(tracking_site(&tr, __FILE__, line_a, &s));
+	expect_eq(s.allocs, usize_(10));
+	expect_eq(s.live_bytes, usize_(640));
+	expect(tracking_site(&tr, __FILE__, line_b, &s));
+	expect_eq(s.live_bytes, usize_(1 << 16));
+
+	/// frees are charged to the allocating site, wherever they happen
+	for (int i = 0; i < 10; ++i)
+		allocer_free(alc, blocks[i], layout(64, 8));
+	expect(tracking_site(&tr, __FILE__, line_a, &s));
+	expect_eq(s.frees, usize_(10));
+	expect_eq(s.live_bytes, usize_(0));
+	expect_eq(s.peak_bytes, usize_(640));
+
+	allocer_free(alc, big, layout(1 << 16, 8));
+	expect(!tracking_site(&tr, __FILE__, 1, &s));
+	return true;
+}
+
+TEST(tracking_realloc)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+	allocer_t alc = tracking_allocer(&tr);
+
+	u32 line = __LINE__ + 1;
+	int *p = (int *)allocer_alloc(alc, layout_of_array(int, 4));
+	p[3] = 7;
+	p = (int *)allocer_realloc(alc, p, layout_of_array(int, 4),
+				   layout_of_array(int, 1000));
+	expect_eq(p[3], 7);
+
+	tracking_stats_t st = tracking_stats(&tr);
+	expect_eq(st.allocs, usize_(1));
+	expect_eq(st.reallocs, usize_(1));
+	expect_eq(st.live_bytes, sizeof(int) * 1000);
+
+	/// a new alignment moves the block but keeps its site
+	p = (int *)allocer_realloc(alc, p, layout_of_array(int, 1000),
+				   layout(sizeof(int) * 10, 64));
+	expect(is_aligned((uptr)p, 64));
+	expect_eq(p[3], 7);
+
+	tracking_site_t s;
+	expect(tracking_site(&tr, __FILE__, line, &s));
+	expect_eq(s.live_bytes, sizeof(int) * 10);
+
+	allocer_free(alc, p, layout(sizeof(int) * 10, 64));
+	expect_eq(tracking_stats(&tr).live_bytes, usize_(0));
+	return true;
+}
+
+TEST(tracking_containers)
+{
+	tracking_t tr;
+	tracking_init(&tr, allocer_system());
+	allocer_t alc = tracking_allocer(&tr);
+
+	vec(u64) v;
+	expect(vec_init(v, alc, 0));
+	map(u64, u64) m;
+	expect(map_init(m, alc, MAP_OPS_U64));
+	for (u64 i = 0; i < 1000; ++i) {
+		expect(vec_push(v, i));
+		expect(map_put(m, i, i));
+	}
+	expect(tracking_stats(&tr).live_bytes >= 1000 * sizeof(u64) * 3);
+
+	vec_deinit(v);
+	map_deinit(m);
+	tracking_stats_t st = tracking_stats(&tr);
+	expect_eq(st.live_bytes, usize_(0));
+	expect(st.peak_bytes > 0);
+	return true;
+}
+
+TEST(tracking_failures)
+{
+	tracking_t tr;
+	tracking_init(&tr, (allocer_t){ .vtable = &FAILING_VTABLE });
+	allocer_t alc = tracking_allocer(&tr);
+
+	expect(allocer_alloc(alc, layout(10, 1)) == nullptr);
+	tracking_stats_t st = tracking_stats(&tr);
+	expect_eq(st.failures, usize_(1));
+	expect_eq(st.allocs, usize_(0));
+
+	/// no buffer for the sites: the reports still come out whole
+	static char buf[4096];
+	char *json = capture(&tr, true, buf, sizeof(buf));
+	expect(strstr(json, "\"failures\":1") != nullptr);
+	expect(strstr(json, "\"sites\":[]}") != nullptr);
+	char *text = capture(&tr, false, buf, sizeof(buf));
+	expect(strstr(text, "1 failed") != nullptr);
+	return true;
+}
+
+TEST(tracking_reports)
+{
+	tracking_t *tr = tracking_new(allocer_system());
+	allocer_t alc = tracking_allocer(tr);
+	void *p = allocer_alloc(alc, layout(200, 8));
+
+	static char buf[8192];
+	char *text = capture(tr, false, buf, sizeof(buf));
+	expect(strstr(text, "1 allocs") != nullptr);
+	expect(strstr(text, "test_tracking.c:") != nullptr);
+
+	char *json = capture(tr, true, buf, sizeof(buf));
+	expect(json[0] == '{');
+	expect(strstr(json, "\"live_bytes\":200") != nullptr);
+	expect(strstr(json, "{\"le\":256,\"count\":1}") != nullptr);
+	expect(strstr(json, "test_tracking.c\",\"line\":") != nullptr);
+
+	allocer_free(alc, p, layout(200, 8));
+	tracking_drop(tr);
+	return true;
+}
+
+int main()
+{
+	RUN(tracking_counts_and_bytes);
+	RUN(tracking_call_sites);
+	RUN(tracking_realloc);
+	RUN(tracking_containers);
+	RUN(tracking_failures);
+	RUN(tracking_reports);
+
+	SUMMARY();
+}
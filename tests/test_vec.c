@@ -168,6 +168,178 @@ TEST(vec_heap_struct_type)
 	return true;
 }
 
+/*
+ * ==========================================================================
+ * Bulk Operations
+ * ==========================================================================
+ */
+
+static bool is_even(const int *x)
+{
+	return *x % 2 == 0;
+}
+
+static bool same_id(const Point *a, const Point *b)
+{
+	return a->x == b->x;
+}
+
+TEST(vec_extend_ops)
+{
+	allocer_t sys = allocer_system();
+	vec(int) v, w;
+	expect(vec_init(v, sys, 0));
+	expect(vec_init(w, sys, 0));
+
+	int arr[] = { 1, 2, 3, 4, 5 };
+	expect(vec_extend_from_array(v, arr, array_size(arr)));
+	expect_eq(vec_len(v), usize_(5));
+	expect_eq(vec_cap(v), usize_(8)); /// one reserve, rounded up
+
+	expect(vec_extend_from_array(w, arr, 2));
+	expect(vec_extend(w, v));
+	expect_eq(vec_len(w), usize_(7));
+	expect_eq(vec_at(w, 1), 2);
+	expect_eq(vec_at(w, 2), 1);
+	expect_eq(vec_at(w, 6), 5);
+
+	/// extending a vector with itself survives the reallocation
+	expect(vec_extend(v, v));
+	expect(vec_extend(v, v));
+	expect_eq(vec_len(v), usize_(20));
+	for (usize i = 0; i < 20; ++i)
+		expect_eq(vec_at(v, i), (int)(i % 5) + 1);
+
+	expect(vec_extend_from_array(v, arr, 0));
+	expect_eq(vec_len(v), usize_(20));
+
+	vec_deinit(v);
+	vec_deinit(w);
+	return true;
+}
+
+TEST(vec_insert_and_remove)
+{
+	allocer_t sys = allocer_system();
+	vec(int) v;
+	expect(vec_init(v, sys, 0));
+
+	int base[] = { 0, 1, 5, 6 };
+	int mid[] = { 2, 3, 4 };
+	expect(vec_extend_from_array(v, base, 4));
+	expect(vec_insert_n(v, 2, mid, 3));
+	expect_eq(vec_len(v), usize_(7));
+	for (int i = 0; i < 7; ++i)
+		expect_eq(vec_at(v, i), i);
+
+	/// at the front and at the end
+	int edge[] = { -1 };
+	expect(vec_insert_n(v, 0, edge, 1));
+	expect(vec_insert_n(v, vec_len(v), edge, 1));
+	expect_eq(vec_at(v, 0), -1);
+	expect_eq(*vec_last(v), -1);
+
+	vec_remove_range(v, 0, 1);
+	vec_remove_range(v, vec_len(v) - 1, vec_len(v));
+	vec_remove_range(v, 2, 5); /// drops 2, 3, 4
+	expect_eq(vec_len(v), usize_(4));
+	expect_eq(vec_at(v, 1), 1);
+	expect_eq(vec_at(v, 2), 5);
+	vec_remove_range(v, 1, 1); /// empty range
+	expect_eq(vec_len(v), usize_(4));
+
+	/// swap_remove: O(1), the last element fills the hole
+	expect_eq(vec_swap_remove(v, 0), 0);
+	expect_eq(vec_len(v), usize_(3));
+	expect_eq(vec_at(v, 0), 6);
+	expect_eq(vec_swap_remove(v, 2), 5);
+	expect_eq(vec_len(v), usize_(2));
+
+	vec_deinit(v);
+	return true;
+}
+
+TEST(vec_retain_dedup)
+{
+	allocer_t sys = allocer_system();
+	vec(int) v;
+	expect(vec_init(v, sys, 0));
+
+	for (int i = 0; i < 10; ++i)
+		expect(vec_push(v, i));
+	expect_eq(vec_retain(v, is_even), usize_(5));
+	expect_eq(vec_len(v), usize_(5));
+	for (int i = 0; i < 5; ++i)
+		expect_eq(vec_at(v, i), i * 2);
+
+	vec_clear(v);
+	int runs[] = { 1, 1, 2, 3, 3, 3, 1, 4, 4 };
+	expect(vec_extend_from_array(v, runs, array_size(runs)));
+	expect_eq(vec_dedup(v), usize_(4));
+	int want[] = { 1, 2, 3, 1, 4 };
+	expect_eq(vec_len(v), array_size(want));
+	for (usize i = 0; i < array_size(want); ++i)
+		expect_eq(vec_at(v, i), want[i]);
+
+	vec_clear(v);
+	expect_eq(vec_dedup(v), usize_(0));
+
+	/// structs: dedup by a custom equality
+	vec(Point) pts;
+	expect(vec_init(pts, sys, 0));
+	vec_push(pts, ((Point){ .x = 1, .y = 10 }));
+	vec_push(pts, ((Point){ .x = 1, .y = 20 }));
+	vec_push(pts, ((Point){ .x = 2, .y = 30 }));
+	expect_eq(vec_dedup_by(pts, same_id), usize_(1));
+	expect_eq(vec_at(pts, 0).y, 10); /// the first of a run is kept
+	expect_eq(vec_at(pts, 1).x, 2);
+
+	vec_deinit(pts);
+	vec_deinit(v);
+	return true;
+}
+
+TEST(vec_shrink)
+{
+	allocer_t sys = allocer_system();
+	vec(u64) v;
+	expect(vec_init(v, sys, 100));
+	for (u64 i = 0; i < 10; ++i)
+		expect(vec_push(v, i));
+
+	expect(vec_shrink_to_fit(v));
+	expect_eq(vec_cap(v), usize_(10));
+	for (u64 i = 0; i < 10; ++i)
+		expect_eq(vec_at(v, i), i);
+	expect(vec_push(v, u64_(10))); /// still growable
+
+	vec_clear(v);
+	expect(vec_shrink_to_fit(v));
+	expect(vec_data(v) == nullptr);
+	expect_eq(vec_cap(v), usize_(0));
+	expect(vec_push(v, u64_(1)));
+
+	vec_deinit(v);
+	return true;
+}
+
+TEST(vec_bulk_bounds)
+{
+	/// out-of-range positions panic like vec_at
+	allocer_t sys = allocer_system();
+	vec(int) v;
+	expect(vec_init(v, sys, 0));
+	vec_push(v, 1);
+
+	int one[] = { 2 };
+	expect_panic((void)vec_insert_n(v, 2, one, 1));
+	expect_panic(vec_remove_range(v, 0, 2));
+	expect_panic((void)vec_swap_remove(v, 1));
+
+	vec_deinit(v);
+	return true;
+}
+
 int main()
 {
 	RUN(vec_basic_int);
@@ -176,5 +348,10 @@ int main()
 	RUN(vec_reserve_logic);
 	RUN(vec_heap_lifecycle);
 	RUN(vec_heap_struct_type);
+	RUN(vec_extend_ops);
+	RUN(vec_insert_and_remove);
+	RUN(vec_retain_dedup);
+	RUN(vec_shrink);
+	RUN(vec_bulk_bounds);
 	SUMMARY();
 }
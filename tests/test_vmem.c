@@ -0,0 +1,198 @@
+/*
+ *    Copyright 2025 Karesis
+ * 
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ * 
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <std/test.h>
+#include <std/allocers/vmem.h>
+#include <std/vec.h>
+#include <std/strings/string.h>
+#include <core/math.h>
+
+#define GiB ((usize)1 << 30)
+#define MiB ((usize)1 << 20)
+
+TEST(vmem_reserve_and_commit)
+{
+	vmem_t vm;
+	expect(vmem_init(&vm, 4 * GiB, VMEM_DEFAULT));
+
+	/// reserving commits nothing
+	expect(vmem_reserved(&vm) >= 4 * GiB);
+	expect_eq(vmem_committed(&vm), usize_(0));
+
+	u8 *p = (u8 *)vmem_alloc(&vm, 100, 1);
+	expect(p != nullptr);
+	expect(p == vm.base);
+	memset(p, 0xAB, 100);
+
+	/// committed lazily, at page granularity
+	expect(vmem_committed(&vm) >= usize_(100));
+	expect(is_aligned(vmem_committed(&vm), vm.page_size));
+	expect(vmem_committed(&vm) < 4 * GiB);
+
+	vmem_deinit(&vm);
+	return true;
+}
+
+TEST(vmem_contiguous_upward)
+{
+	vmem_t vm;
+	expect(vmem_init(&vm, 64 * MiB, VMEM_DEFAULT));
+
+	u8 *a = (u8 *)vmem_alloc(&vm, 10, 1);
+	u8 *b = (u8 *)vmem_alloc(&vm, 10, 1);
+	expect_eq((uptr)b - (uptr)a, usize_(10));
+
+	u64 *c = (u64 *)vmem_alloc(&vm, sizeof(u64), 64);
+	expect(is_aligned((uptr)c, 64));
+	expect((u8 *)c > b);
+
+	/// crossing many pages needs no chaining: one block
+	u8 *big = (u8 *)vmem_alloc(&vm, 3 * MiB, 16);
+	expect(big != nullptr);
+	big[0] = 1;
+	big[3 * MiB - 1] = 2;
+
+	vmem_deinit(&vm);
+	return true;
+}
+
+TEST(vmem_exhaustion)
+{
+	vmem_t vm;
+	expect(vmem_init(&vm, 1 * MiB, VMEM_DEFAULT));
+
+	expect(vmem_alloc(&vm, 512 * 1024, 1) != nullptr);
+	expect(vmem_alloc(&vm, 1 * MiB, 1) == nullptr);
+	/// a failed request does not consume space
+	expect(vmem_alloc(&vm, 256 * 1024, 1) != nullptr);
+
+	vmem_deinit(&vm);
+	return true;
+}
+
+TEST(vmem_vec_base_never_moves)
+{
+	vmem_t vm;
+	expect(vmem_init(&vm, 1 * GiB, VMEM_DEFAULT));
+
+	vec(u32) v;
+	expect(vec_init(v, vmem_allocer(&vm), 8));
+	u32 *base = v.data;
+
+	for (u32 i = 0; i < 1000000; ++i)
+		expect(vec_push(v, i));
+
+	/// every growth was an in-place tip extension
+	expect(v.data == base);
+	expect_eq(vmem_used(&vm), vec_cap(v) * sizeof(u32));
+	expect_eq(vec_at(v, 999999), u32_(999999));
+
+	vec_deinit(v);
+	/// freeing the tip gives the space back
+	expect_eq(vmem_used(&vm), usize_(0));
+
+	vmem_deinit(&vm);
+	return true;
+}
+
+TEST(vmem_realloc_not_tip)
+{
+	vmem_t vm;
+	expect(vmem_init(&vm, 16 * MiB, VMEM_DEFAULT));
+
+	int *a = (int *)vmem_alloc(&vm, sizeof(int) * 4, alignof(int));
+	for (int i = 0; i < 4; ++i)
+		a[i] = i;
+	int *b = (int *)vmem_alloc(&vm, sizeof(int), alignof(int));
+	*b = 42;
+
+	int *a2 = (int *)vmem_realloc(&vm, a, sizeof(int) * 4, sizeof(int) * 8,
+				      alignof(int));
+	expect(a2 != nullptr);
+	expect(a2 != a);
+	expect_eq(*b, 42);
+	for (int i = 0; i < 4; ++i)
+		expect_eq(a2[i], i);
+
+	vmem_deinit(&vm);
+	return true;
+}
+
+TEST(vmem_reset_and_trim)
+{
+	vmem_t vm;
+	expect(vmem_init(&vm, 256 * MiB, VMEM_DEFAULT));
+
+	u8 *p = (u8 *)vmem_alloc(&vm, 8 * MiB, 1);
+	expect(p != nullptr);
+	memset(p, 1, 8 * MiB);
+	usize committed = vmem_committed(&vm);
+	expect(committed >= 8 * MiB);
+
+	/// reset keeps pages
+	vmem_reset(&vm);
+	expect_eq(vmem_used(&vm), usize_(0));
+	expect_eq(vmem_committed(&vm), committed);
+
+	/// trim gives back everything above `keep`
+	vmem_trim(&vm, 1 * MiB);
+	expect_eq(vmem_committed(&vm), 1 * MiB);
+
+	/// still usable (pages get re-committed)
+	u8 *q = (u8 *)vmem_alloc(&vm, 4 * MiB, 1);
+	expect(q == p);
+	q[4 * MiB - 1] = 7;
+	expect_eq(q[4 * MiB - 1], u8_(7));
+
+	/// trim never drops memory in use
+	vmem_trim(&vm, 0);
+	expect(vmem_committed(&vm) >= 4 * MiB);
+
+	vmem_deinit(&vm);
+	return true;
+}
+
+TEST(vmem_hugepages)
+{
+	vmem_t vm;
+	expect(vmem_init(&vm, 64 * MiB, VMEM_HUGEPAGES));
+
+	/// base is aligned to the huge page size
+	expect(is_aligned((uptr)vm.base, 2 * MiB));
+
+	string_t s;
+	expect(string_init(&s, vmem_allocer(&vm), 0));
+	for (int i = 0; i < 100000; ++i)
+		expect(string_push(&s, 'x'));
+	expect_eq(string_len(&s), usize_(100000));
+	string_deinit(&s);
+
+	vmem_deinit(&vm);
+	return true;
+}
+
+int main()
+{
+	RUN(vmem_reserve_and_commit);
+	RUN(vmem_contiguous_upward);
+	RUN(vmem_exhaustion);
+	RUN(vmem_vec_base_never_moves);
+	RUN(vmem_realloc_not_tip);
+	RUN(vmem_reset_and_trim);
+	RUN(vmem_hugepages);
+
+	SUMMARY();
+}